@@ -0,0 +1,418 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GameSortingBench.h"
+#include "SaveInterface.h"
+#include "SqlUtilityTable.h"
+#include "TableModelGame.h"
+#include "TableModelMovies.h"
+#include "TableModelCommon.h"
+#include "TableModelBooks.h"
+#include "TableModelSeries.h"
+#include <QTest>
+#include <QStringList>
+#include <QModelIndexList>
+#include <QDataStream>
+
+Q_DECLARE_METATYPE(ListType);
+
+GameSortingBench::GameSortingBench(const SyntheticListConfig& config, QObject* parent) :
+    QObject(parent),
+    m_generator(config),
+    m_utilityTable(nullptr),
+    m_model(nullptr)
+{}
+
+GameSortingBench::~GameSortingBench()
+{}
+
+void GameSortingBench::initTestCase()
+{
+    // Same database than the application, an in memory SQLite database.
+    m_db = QSqlDatabase::addDatabase("QSQLITE");
+    m_db.setDatabaseName(":memory:");
+    QVERIFY(m_db.open());
+    QVERIFY(m_tmpDir.isValid());
+
+    m_utilityTable = new SqlUtilityTable(ListType::UNKNOWN, m_db);
+
+    // Generating the lists and writing them into files used by the open benchmark.
+    const ListType types[] = { ListType::GAMELIST, ListType::MOVIESLIST, ListType::COMMONLIST, ListType::BOOKSLIST, ListType::SERIESLIST };
+    for (ListType type : types)
+    {
+        QVariant data = m_generator.generate(type);
+        QVERIFY(data.isValid());
+        QVERIFY(SaveInterface::save(listFilePath(type), data));
+        m_lists.insert((int)type, data);
+    }
+}
+
+void GameSortingBench::cleanupTestCase()
+{
+    unloadList();
+    delete m_utilityTable;
+    m_utilityTable = nullptr;
+    m_db.close();
+}
+
+void GameSortingBench::cleanup()
+{
+    // Each benchmark start with a freshly loaded list.
+    unloadList();
+}
+
+void GameSortingBench::open_data()
+{
+    listTypeData();
+}
+
+void GameSortingBench::open()
+{
+    QFETCH(ListType, type);
+
+    QBENCHMARK
+    {
+        // Reading the file and putting it into the SQL database, like TabAndList::openFile.
+        QVariant data;
+        QVERIFY(SaveInterface::open(listFilePath(type), data));
+        m_utilityTable->newList(type);
+        QVERIFY(m_utilityTable->setData(utilityData(data)));
+        m_model = createModel(type, firstTable(data), m_db, *m_utilityTable);
+        QVERIFY(m_model);
+        unloadList();
+    }
+}
+
+void GameSortingBench::save_data()
+{
+    listTypeData();
+}
+
+void GameSortingBench::save()
+{
+    QFETCH(ListType, type);
+    QVERIFY(loadList(type));
+    QString filePath = m_tmpDir.filePath(QString("save_%1").arg(listTypeName(type)));
+
+    QBENCHMARK
+    {
+        // Streaming the table and the utility data from the database into the file, like TabAndList::saveFile.
+        QList<SaveInterface::SaveTableSection> tables;
+        tables.append({m_model->rawTableName(), m_model->itemCount(),
+            [this, type](QDataStream& out) -> bool
+            {
+                return writeTable(out, type, m_model);
+            },
+            m_model->topItems(FILE_METADATA_TOP_ITEMS)});
+        QVERIFY(SaveInterface::save(filePath, type, tables,
+            [this](QDataStream& out) -> bool
+            {
+                return m_utilityTable->writeData(out);
+            }));
+    }
+}
+
+void GameSortingBench::sort_data()
+{
+    columnData(false);
+}
+
+void GameSortingBench::sort()
+{
+    QFETCH(ListType, type);
+    QFETCH(int, column);
+    QVERIFY(loadList(type));
+
+    Qt::SortOrder order = Qt::AscendingOrder;
+    QBENCHMARK
+    {
+        // Toggling the order, otherwise the model would not sort again the same column.
+        m_model->sort(column, order);
+        order = order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder;
+    }
+}
+
+void GameSortingBench::filter_data()
+{
+    columnData(true);
+}
+
+void GameSortingBench::filter()
+{
+    QFETCH(ListType, type);
+    QFETCH(int, column);
+    QVERIFY(loadList(type));
+
+    ListFilter filter = {};
+    filter.column = column;
+    ColumnKind kind = columnKind(type, column);
+    if (kind == ColumnKind::NAME)
+        filter.pattern = "1";
+    else if (kind == ColumnKind::UTILITY)
+        filter.utilityList = { 1, 2, 3 };
+    else if (kind == ColumnKind::RATE)
+        filter.rate = 3;
+
+    QBENCHMARK
+    {
+        m_model->setFilter(filter);
+    }
+}
+
+void GameSortingBench::move_data()
+{
+    listTypeData();
+}
+
+void GameSortingBench::move()
+{
+    QFETCH(ListType, type);
+    QVERIFY(loadList(type));
+
+    // Moving one item out of ten to the middle of the list.
+    QModelIndexList indexList;
+    for (int i = 0; i < m_model->rowCount(); i += 10)
+        indexList.append(m_model->index(i, 0));
+    int to = m_model->rowCount() / 2;
+
+    QBENCHMARK
+    {
+        if (type == ListType::GAMELIST)
+            static_cast<TableModelGame*>(m_model)->moveItemsTo(indexList, to);
+        else if (type == ListType::MOVIESLIST)
+            static_cast<TableModelMovies*>(m_model)->moveItemsTo(indexList, to);
+        else if (type == ListType::COMMONLIST)
+            static_cast<TableModelCommon*>(m_model)->moveItemsTo(indexList, to);
+        else if (type == ListType::BOOKSLIST)
+            static_cast<TableModelBooks*>(m_model)->moveItemsTo(indexList, to);
+        else if (type == ListType::SERIESLIST)
+            static_cast<TableModelSeries*>(m_model)->moveItemsTo(indexList, to);
+    }
+}
+
+void GameSortingBench::bulkDelete_data()
+{
+    listTypeData();
+}
+
+void GameSortingBench::bulkDelete()
+{
+    QFETCH(ListType, type);
+    QVERIFY(loadList(type));
+
+    // Deleting half of the list, the benchmark is run once because the list is modified.
+    QModelIndexList indexList;
+    for (int i = 0; i < m_model->rowCount(); i += 2)
+        indexList.append(m_model->index(i, 0));
+
+    QBENCHMARK_ONCE
+    {
+        m_model->deleteRows(indexList);
+    }
+}
+
+void GameSortingBench::paste_data()
+{
+    listTypeData();
+}
+
+void GameSortingBench::paste()
+{
+    QFETCH(ListType, type);
+    QVERIFY(loadList(type));
+
+    // Pasting as many items as there are already in the list, in the middle of the list.
+    QStringList itemList;
+    int count = qMax(m_model->rowCount(), 1);
+    itemList.reserve(count);
+    for (int i = 0; i < count; i++)
+        itemList.append(QString("Pasted item %1").arg(i+1));
+    QModelIndexList indexList;
+    if (m_model->rowCount() > 0)
+        indexList.append(m_model->index(m_model->rowCount() / 2, 0));
+
+    QBENCHMARK_ONCE
+    {
+        m_model->appendRows(indexList, itemList);
+    }
+}
+
+void GameSortingBench::listTypeData() const
+{
+    QTest::addColumn<ListType>("type");
+
+    const ListType types[] = { ListType::GAMELIST, ListType::MOVIESLIST, ListType::COMMONLIST, ListType::BOOKSLIST, ListType::SERIESLIST };
+    for (ListType type : types)
+        QTest::newRow(listTypeName(type)) << type;
+}
+
+void GameSortingBench::columnData(bool filterableOnly) const
+{
+    QTest::addColumn<ListType>("type");
+    QTest::addColumn<int>("column");
+
+    const ListType types[] = { ListType::GAMELIST, ListType::MOVIESLIST, ListType::COMMONLIST, ListType::BOOKSLIST, ListType::SERIESLIST };
+    for (ListType type : types)
+    {
+        for (int column = 0; column < columnCount(type); column++)
+        {
+            // Only the name, the utilities and the rate can be filtered.
+            if (filterableOnly && columnKind(type, column) == ColumnKind::OTHER)
+                continue;
+            QTest::addRow("%s:%d", listTypeName(type), column) << type << column;
+        }
+    }
+}
+
+bool GameSortingBench::loadList(ListType type)
+{
+    // Loading the generated list into the SQL database.
+    unloadList();
+    QVariant data = m_lists.value((int)type);
+    m_utilityTable->newList(type);
+    if (!m_utilityTable->setData(utilityData(data)))
+        return false;
+    m_model = createModel(type, firstTable(data), m_db, *m_utilityTable);
+    return m_model != nullptr;
+}
+
+void GameSortingBench::unloadList()
+{
+    if (m_model)
+    {
+        delete m_model;
+        m_model = nullptr;
+    }
+}
+
+QString GameSortingBench::listFilePath(ListType type) const
+{
+    return m_tmpDir.filePath(QString("%1.list").arg(listTypeName(type)));
+}
+
+TableModel* GameSortingBench::createModel(ListType type, const QVariant& table, QSqlDatabase& db, SqlUtilityTable& utilityTable)
+{
+    if (type == ListType::GAMELIST)
+        return new TableModelGame(table, db, utilityTable);
+    else if (type == ListType::MOVIESLIST)
+        return new TableModelMovies(table, db, utilityTable);
+    else if (type == ListType::COMMONLIST)
+        return new TableModelCommon(table, db, utilityTable);
+    else if (type == ListType::BOOKSLIST)
+        return new TableModelBooks(table, db, utilityTable);
+    else if (type == ListType::SERIESLIST)
+        return new TableModelSeries(table, db, utilityTable);
+    return nullptr;
+}
+
+QVariant GameSortingBench::firstTable(const QVariant& data)
+{
+    if (data.canConvert<Game::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Game::SaveData>(data).gameTables.value(0));
+    else if (data.canConvert<Movie::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Movie::SaveData>(data).movieTables.value(0));
+    else if (data.canConvert<Common::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Common::SaveData>(data).commonTables.value(0));
+    else if (data.canConvert<Books::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Books::SaveData>(data).booksTables.value(0));
+    else if (data.canConvert<Series::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Series::SaveData>(data).serieTables.value(0));
+    return QVariant();
+}
+
+QVariant GameSortingBench::utilityData(const QVariant& data)
+{
+    if (data.canConvert<Game::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Game::SaveData>(data).utilityData);
+    else if (data.canConvert<Movie::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Movie::SaveData>(data).utilityData);
+    else if (data.canConvert<Common::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Common::SaveData>(data).utilityData);
+    else if (data.canConvert<Books::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Books::SaveData>(data).utilityData);
+    else if (data.canConvert<Series::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Series::SaveData>(data).utilityData);
+    return QVariant();
+}
+
+bool GameSortingBench::writeTable(QDataStream& out, ListType type, const TableModel* model)
+{
+    // Writing a table like the list views, there is no view so the columns keep their default size.
+    if (!model->writeData(out))
+        return false;
+
+    if (type == ListType::GAMELIST)
+        out << Game::ColumnsSize{};
+    else if (type == ListType::MOVIESLIST)
+        out << Movie::ColumnsSize{};
+    else if (type == ListType::COMMONLIST)
+        out << Common::ColumnsSize{};
+    else if (type == ListType::BOOKSLIST)
+        out << Books::ColumnsSize{};
+    else if (type == ListType::SERIESLIST)
+        out << Series::ColumnsSize{};
+    else
+        return false;
+
+    model->writeSortingData(out);
+    return out.status() == QDataStream::Ok;
+}
+
+int GameSortingBench::columnCount(ListType type)
+{
+    if (type == ListType::GAMELIST)
+        return Game::RATE+1;
+    else if (type == ListType::MOVIESLIST)
+        return Movie::RATE+1;
+    else if (type == ListType::COMMONLIST)
+        return Common::RATE+1;
+    else if (type == ListType::BOOKSLIST)
+        return Books::RATE+1;
+    else if (type == ListType::SERIESLIST)
+        return Series::RATE+1;
+    return 0;
+}
+
+GameSortingBench::ColumnKind GameSortingBench::columnKind(ListType type, int column)
+{
+    // The rate is always the last column and the sensitive content the one before.
+    if (column == 0)
+        return ColumnKind::NAME;
+    else if (column == columnCount(type)-1)
+        return ColumnKind::RATE;
+    else if (column == columnCount(type)-2)
+        return ColumnKind::OTHER;
+    else if (type == ListType::SERIESLIST && (column == Series::EPISODE || column == Series::SEASON))
+        return ColumnKind::OTHER;
+    return ColumnKind::UTILITY;
+}
+
+const char* GameSortingBench::listTypeName(ListType type)
+{
+    if (type == ListType::GAMELIST)
+        return "game";
+    else if (type == ListType::MOVIESLIST)
+        return "movies";
+    else if (type == ListType::COMMONLIST)
+        return "common";
+    else if (type == ListType::BOOKSLIST)
+        return "books";
+    else if (type == ListType::SERIESLIST)
+        return "series";
+    return "unknown";
+}
@@ -0,0 +1,97 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_GAMESORTINGBENCH_H_
+#define GAMESORTING_GAMESORTINGBENCH_H_
+
+#include "SyntheticListGenerator.h"
+#include "DataStruct.h"
+#include <QObject>
+#include <QSqlDatabase>
+#include <QTemporaryDir>
+#include <QVariant>
+#include <QHash>
+
+class TableModel;
+class SqlUtilityTable;
+class QDataStream;
+
+/*
+Benchmark suite of the lists, run with Qt Test (QBENCHMARK).
+Every benchmark is run for each list type on a list created by the
+SyntheticListGenerator.
+*/
+class GameSortingBench : public QObject
+{
+    Q_OBJECT
+public:
+    GameSortingBench(const SyntheticListConfig& config, QObject* parent = nullptr);
+    virtual ~GameSortingBench();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cleanup();
+
+    void open_data();
+    void open();
+    void save_data();
+    void save();
+    void sort_data();
+    void sort();
+    void filter_data();
+    void filter();
+    void move_data();
+    void move();
+    void bulkDelete_data();
+    void bulkDelete();
+    void paste_data();
+    void paste();
+
+private:
+    enum class ColumnKind
+    {
+        NAME,
+        UTILITY,
+        RATE,
+        OTHER
+    };
+
+    void listTypeData() const;
+    void columnData(bool filterableOnly) const;
+    bool loadList(ListType type);
+    void unloadList();
+    QString listFilePath(ListType type) const;
+
+    static TableModel* createModel(ListType type, const QVariant& table, QSqlDatabase& db, SqlUtilityTable& utilityTable);
+    static QVariant firstTable(const QVariant& data);
+    static QVariant utilityData(const QVariant& data);
+    static bool writeTable(QDataStream& out, ListType type, const TableModel* model);
+    static int columnCount(ListType type);
+    static ColumnKind columnKind(ListType type, int column);
+    static const char* listTypeName(ListType type);
+
+    SyntheticListGenerator m_generator;
+    QSqlDatabase m_db;
+    SqlUtilityTable* m_utilityTable;
+    TableModel* m_model;
+    QTemporaryDir m_tmpDir;
+    QHash<int, QVariant> m_lists;
+};
+
+#endif // GAMESORTING_GAMESORTINGBENCH_H_
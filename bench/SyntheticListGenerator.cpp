@@ -0,0 +1,324 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SyntheticListGenerator.h"
+#include <QSet>
+#include <algorithm>
+
+SyntheticListGenerator::SyntheticListGenerator(const SyntheticListConfig& config) :
+    m_config(config),
+    m_random(config.seed)
+{
+    if (m_config.itemCount < 0)
+        m_config.itemCount = 0;
+    if (m_config.utilityCardinality < 0)
+        m_config.utilityCardinality = 0;
+    if (m_config.itemsPerUtility < 0)
+        m_config.itemsPerUtility = 0;
+}
+
+QVariant SyntheticListGenerator::generate(ListType type)
+{
+    // Reset the random generator, so every call produce the same list.
+    m_random.seed(m_config.seed);
+
+    if (type == ListType::GAMELIST)
+        return generateGame();
+    else if (type == ListType::MOVIESLIST)
+        return generateMovies();
+    else if (type == ListType::COMMONLIST)
+        return generateCommon();
+    else if (type == ListType::BOOKSLIST)
+        return generateBooks();
+    else if (type == ListType::SERIESLIST)
+        return generateSeries();
+
+    return QVariant();
+}
+
+const SyntheticListConfig& SyntheticListGenerator::config() const
+{
+    return m_config;
+}
+
+QVariant SyntheticListGenerator::generateGame()
+{
+    Game::SaveDataTable table = {};
+    table.tableName = "Synthetic Games";
+    table.columnSort = -1;
+    table.sortOrder = 0;
+
+    // Generating the items.
+    table.gameList.reserve(m_config.itemCount);
+    for (int i = 0; i < m_config.itemCount; i++)
+    {
+        Game::SaveItem item = {};
+        item.gameID = i+1;
+        item.gamePos = i;
+        item.name = itemName(i);
+        item.url = QString("https://example.com/games/%1").arg(i+1);
+        item.rate = randomRate();
+        table.gameList.append(item);
+    }
+
+    // Binding the utility to the items.
+    table.interface.series = interfaceList();
+    table.interface.categories = interfaceList();
+    table.interface.developpers = interfaceList();
+    table.interface.pubishers = interfaceList();
+    table.interface.platform = interfaceList();
+    table.interface.services = interfaceList();
+    table.interface.sensitiveContent = sensitiveContentList();
+
+    Game::SaveData data = {};
+    data.gameTables.append(table);
+    data.utilityData.series = utilityList("Series");
+    data.utilityData.categories = utilityList("Category");
+    data.utilityData.developpers = utilityList("Developper");
+    data.utilityData.publishers = utilityList("Publisher");
+    data.utilityData.platform = utilityList("Platform");
+    data.utilityData.services = utilityList("Service");
+
+    return QVariant::fromValue(data);
+}
+
+QVariant SyntheticListGenerator::generateMovies()
+{
+    Movie::SaveDataTable table = {};
+    table.tableName = "Synthetic Movies";
+    table.columnSort = -1;
+    table.sortOrder = 0;
+
+    // Generating the items.
+    table.movieList.reserve(m_config.itemCount);
+    for (int i = 0; i < m_config.itemCount; i++)
+    {
+        Movie::SaveItem item = {};
+        item.movieID = i+1;
+        item.moviePos = i;
+        item.name = itemName(i);
+        item.url = QString("https://example.com/movies/%1").arg(i+1);
+        item.rate = randomRate();
+        table.movieList.append(item);
+    }
+
+    // Binding the utility to the items.
+    table.interface.series = interfaceList();
+    table.interface.categories = interfaceList();
+    table.interface.directors = interfaceList();
+    table.interface.actors = interfaceList();
+    table.interface.productions = interfaceList();
+    table.interface.music = interfaceList();
+    table.interface.services = interfaceList();
+    table.interface.sensitiveContent = sensitiveContentList();
+
+    Movie::SaveData data = {};
+    data.movieTables.append(table);
+    data.utilityData.series = utilityList("Series");
+    data.utilityData.categories = utilityList("Category");
+    data.utilityData.directors = utilityList("Director");
+    data.utilityData.actors = utilityList("Actor");
+    data.utilityData.productions = utilityList("Production");
+    data.utilityData.music = utilityList("Music");
+    data.utilityData.services = utilityList("Service");
+
+    return QVariant::fromValue(data);
+}
+
+QVariant SyntheticListGenerator::generateCommon()
+{
+    Common::SaveDataTable table = {};
+    table.tableName = "Synthetic Common";
+    table.columnSort = -1;
+    table.sortOrder = 0;
+
+    // Generating the items.
+    table.commonList.reserve(m_config.itemCount);
+    for (int i = 0; i < m_config.itemCount; i++)
+    {
+        Common::SaveItem item = {};
+        item.commonID = i+1;
+        item.commonPos = i;
+        item.name = itemName(i);
+        item.url = QString("https://example.com/common/%1").arg(i+1);
+        item.rate = randomRate();
+        table.commonList.append(item);
+    }
+
+    // Binding the utility to the items.
+    table.interface.series = interfaceList();
+    table.interface.categories = interfaceList();
+    table.interface.authors = interfaceList();
+    table.interface.sensitiveContent = sensitiveContentList();
+
+    Common::SaveData data = {};
+    data.commonTables.append(table);
+    data.utilityData.series = utilityList("Series");
+    data.utilityData.categories = utilityList("Category");
+    data.utilityData.authors = utilityList("Author");
+
+    return QVariant::fromValue(data);
+}
+
+QVariant SyntheticListGenerator::generateBooks()
+{
+    Books::SaveDataTable table = {};
+    table.tableName = "Synthetic Books";
+    table.columnSort = -1;
+    table.sortOrder = 0;
+
+    // Generating the items.
+    table.booksList.reserve(m_config.itemCount);
+    for (int i = 0; i < m_config.itemCount; i++)
+    {
+        Books::SaveItem item = {};
+        item.bookID = i+1;
+        item.bookPos = i;
+        item.name = itemName(i);
+        item.url = QString("https://example.com/books/%1").arg(i+1);
+        item.rate = randomRate();
+        table.booksList.append(item);
+    }
+
+    // Binding the utility to the items.
+    table.interface.series = interfaceList();
+    table.interface.categories = interfaceList();
+    table.interface.authors = interfaceList();
+    table.interface.publishers = interfaceList();
+    table.interface.services = interfaceList();
+    table.interface.sensitiveContent = sensitiveContentList();
+
+    Books::SaveData data = {};
+    data.booksTables.append(table);
+    data.utilityData.series = utilityList("Series");
+    data.utilityData.categories = utilityList("Category");
+    data.utilityData.authors = utilityList("Author");
+    data.utilityData.publishers = utilityList("Publisher");
+    data.utilityData.services = utilityList("Service");
+
+    return QVariant::fromValue(data);
+}
+
+QVariant SyntheticListGenerator::generateSeries()
+{
+    Series::SaveDataTable table = {};
+    table.tableName = "Synthetic Series";
+    table.columnSort = -1;
+    table.sortOrder = 0;
+
+    // Generating the items.
+    table.serieList.reserve(m_config.itemCount);
+    for (int i = 0; i < m_config.itemCount; i++)
+    {
+        Series::SaveItem item = {};
+        item.serieID = i+1;
+        item.seriePos = i;
+        item.name = itemName(i);
+        item.episodePos = m_random.bounded(1, 25);
+        item.seasonPos = m_random.bounded(1, 10);
+        item.url = QString("https://example.com/series/%1").arg(i+1);
+        item.rate = randomRate();
+        table.serieList.append(item);
+    }
+
+    // Binding the utility to the items.
+    table.interface.categories = interfaceList();
+    table.interface.directors = interfaceList();
+    table.interface.actors = interfaceList();
+    table.interface.production = interfaceList();
+    table.interface.music = interfaceList();
+    table.interface.services = interfaceList();
+    table.interface.sensitiveContent = sensitiveContentList();
+
+    Series::SaveData data = {};
+    data.serieTables.append(table);
+    data.utilityData.categories = utilityList("Category");
+    data.utilityData.directors = utilityList("Director");
+    data.utilityData.actors = utilityList("Actor");
+    data.utilityData.production = utilityList("Production");
+    data.utilityData.music = utilityList("Music");
+    data.utilityData.services = utilityList("Service");
+
+    return QVariant::fromValue(data);
+}
+
+QList<ItemUtilityData> SyntheticListGenerator::utilityList(const QString& prefix) const
+{
+    // Creating the entries of an utility table, the ID start at 1.
+    QList<ItemUtilityData> list;
+    list.reserve(m_config.utilityCardinality);
+    for (int i = 0; i < m_config.utilityCardinality; i++)
+        list.append({i+1, i, QString("%1 %2").arg(prefix).arg(i+1)});
+    return list;
+}
+
+QList<Game::SaveUtilityInterfaceItem> SyntheticListGenerator::interfaceList()
+{
+    // Binding each utility entry to itemsPerUtility distinct random items.
+    QList<Game::SaveUtilityInterfaceItem> list;
+    if (m_config.itemCount == 0)
+        return list;
+
+    int itemsPerUtility = qMin(m_config.itemsPerUtility, m_config.itemCount);
+    list.reserve(m_config.utilityCardinality * itemsPerUtility);
+    for (int i = 0; i < m_config.utilityCardinality; i++)
+    {
+        QSet<long long int> boundItems;
+        while (boundItems.size() < itemsPerUtility)
+        {
+            long long int itemID = m_random.bounded(m_config.itemCount)+1;
+            if (!boundItems.contains(itemID))
+            {
+                boundItems.insert(itemID);
+                list.append({itemID, i+1});
+            }
+        }
+    }
+    return list;
+}
+
+QList<Game::SaveUtilitySensitiveContentItem> SyntheticListGenerator::sensitiveContentList()
+{
+    // One sensitive content entry per item.
+    QList<Game::SaveUtilitySensitiveContentItem> list;
+    list.reserve(m_config.itemCount);
+    for (int i = 0; i < m_config.itemCount; i++)
+    {
+        Game::SaveUtilitySensitiveContentItem item = {};
+        item.SensitiveContentID = i+1;
+        item.gameID = i+1;
+        item.explicitContent = m_random.bounded(6);
+        item.violenceContent = m_random.bounded(6);
+        item.badLanguageContent = m_random.bounded(6);
+        list.append(item);
+    }
+    return list;
+}
+
+QString SyntheticListGenerator::itemName(int i) const
+{
+    // The number is spelled backward, so the alphabetical order is not the list order.
+    QString number = QString::number(i+1);
+    std::reverse(number.begin(), number.end());
+    return QString("Item %1 %2").arg(number).arg(i+1);
+}
+
+int SyntheticListGenerator::randomRate()
+{
+    return m_random.bounded(6);
+}
@@ -0,0 +1,73 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_SYNTHETICLISTGENERATOR_H_
+#define GAMESORTING_SYNTHETICLISTGENERATOR_H_
+
+#include "DataStruct.h"
+#include <QVariant>
+#include <QList>
+#include <QString>
+#include <QRandomGenerator>
+
+// Parameters of the generated lists.
+struct SyntheticListConfig
+{
+    // Number of items in the generated list.
+    int itemCount = 1000;
+    // Number of entries in each utility table (categories, authors, ...).
+    int utilityCardinality = 50;
+    // Number of items each utility entry is bound to.
+    int itemsPerUtility = 20;
+    // Seed of the random generator, the same seed always produce the same list.
+    quint32 seed = 28250;
+};
+
+/*
+Generate a list (the same data the SaveInterface is reading from a file)
+filled with random data. It's used by the benchmark suite to measure the
+performance of the list without needing real list files.
+*/
+class SyntheticListGenerator
+{
+public:
+    SyntheticListGenerator(const SyntheticListConfig& config = SyntheticListConfig());
+
+    // Return a QVariant of a {Game,Movie,Common,Books,Series}::SaveData with one table.
+    QVariant generate(ListType type);
+
+    const SyntheticListConfig& config() const;
+
+private:
+    QVariant generateGame();
+    QVariant generateMovies();
+    QVariant generateCommon();
+    QVariant generateBooks();
+    QVariant generateSeries();
+
+    QList<ItemUtilityData> utilityList(const QString& prefix) const;
+    QList<Game::SaveUtilityInterfaceItem> interfaceList();
+    QList<Game::SaveUtilitySensitiveContentItem> sensitiveContentList();
+    QString itemName(int i) const;
+    int randomRate();
+
+    SyntheticListConfig m_config;
+    QRandomGenerator m_random;
+};
+
+#endif // GAMESORTING_SYNTHETICLISTGENERATOR_H_
@@ -0,0 +1,131 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GameSortingBench.h"
+#include "Common.h"
+#include <QApplication>
+#include <QTest>
+#include <QFile>
+#include <QDir>
+#include <QXmlStreamReader>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QStringList>
+#include <iostream>
+
+/*
+Convert the XML output of Qt Test into a JSON file containing the
+benchmarks results, used to track the performance between commits.
+*/
+static bool writeJsonResults(const QString& xmlFilePath, const QString& jsonFilePath, const SyntheticListConfig& config)
+{
+    QFile xmlFile(xmlFilePath);
+    if (!xmlFile.open(QIODevice::ReadOnly))
+        return false;
+
+    QJsonArray results;
+    QString functionName;
+    QXmlStreamReader xml(&xmlFile);
+    while (!xml.atEnd())
+    {
+        xml.readNext();
+        if (!xml.isStartElement())
+            continue;
+
+        if (xml.name() == QLatin1String("TestFunction"))
+            functionName = xml.attributes().value("name").toString();
+        else if (xml.name() == QLatin1String("BenchmarkResult"))
+        {
+            QXmlStreamAttributes attributes = xml.attributes();
+            QJsonObject result;
+            result["benchmark"] = functionName;
+            result["tag"] = attributes.value("tag").toString();
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toDouble();
+            result["iterations"] = attributes.value("iterations").toInt();
+            results.append(result);
+        }
+    }
+    if (xml.hasError())
+        return false;
+
+    QJsonObject configObject;
+    configObject["itemCount"] = config.itemCount;
+    configObject["utilityCardinality"] = config.utilityCardinality;
+    configObject["itemsPerUtility"] = config.itemsPerUtility;
+    configObject["seed"] = (qint64)config.seed;
+
+    QJsonObject root;
+    root["version"] = GAMESORTING_VERSION;
+    root["config"] = configObject;
+    root["results"] = results;
+
+    QFile jsonFile(jsonFilePath);
+    if (!jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    jsonFile.write(QJsonDocument(root).toJson());
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    // The benchmarks do not need to show anything.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    // Reading the arguments of the generator, the others arguments are given to Qt Test.
+    SyntheticListConfig config;
+    QString jsonFilePath("gamesorting_bench.json");
+    QStringList testArgs;
+    QStringList args = app.arguments();
+    for (int i = 0; i < args.size(); i++)
+    {
+        const QString& arg = args.at(i);
+        if (i+1 < args.size() && arg == "-items")
+            config.itemCount = args.at(++i).toInt();
+        else if (i+1 < args.size() && arg == "-utilities")
+            config.utilityCardinality = args.at(++i).toInt();
+        else if (i+1 < args.size() && arg == "-items-per-utility")
+            config.itemsPerUtility = args.at(++i).toInt();
+        else if (i+1 < args.size() && arg == "-seed")
+            config.seed = args.at(++i).toUInt();
+        else if (i+1 < args.size() && arg == "-json")
+            jsonFilePath = args.at(++i);
+        else
+            testArgs.append(arg);
+    }
+
+    // Writing the results to the console and to a XML file converted afterward into JSON.
+    QString xmlFilePath = QDir::temp().filePath("gamesorting_bench.xml");
+    testArgs << "-o" << QString("%1,xml").arg(xmlFilePath) << "-o" << "-,txt";
+
+    GameSortingBench bench(config);
+    int result = QTest::qExec(&bench, testArgs);
+
+    if (!writeJsonResults(xmlFilePath, jsonFilePath, config))
+    {
+        std::cerr << "Failed to write the benchmark results into: " << jsonFilePath.toLocal8Bit().constData() << std::endl;
+        result = result == 0 ? 1 : result;
+    }
+    QFile::remove(xmlFilePath);
+
+    return result;
+}
@@ -22,6 +22,13 @@
 #include <QWidget>
 #include "DataStruct.h"
 
+// Number of rows sampled when a column is fitted to its contents, in the fixed metrics mode.
+#define LIST_VIEW_METRICS_SAMPLE_ROWS 200
+
+class QDataStream;
+class QTableView;
+class TableModel;
+
 class AbstractListView : public QWidget
 {
     Q_OBJECT
@@ -30,6 +37,20 @@ public:
     virtual ~AbstractListView();
 
     virtual ViewType viewType() const = 0;
+    // Write the list of the view into the save stream, return false if the view cannot be saved.
+    virtual bool writeListData(QDataStream& out) const;
+    // The model of the list, nullptr if the view is not showing a list.
+    virtual TableModel* tableModel() const;
+    // Apply the columns size and the sorting order of a SaveDataTable to the view.
+    virtual void setColumnsSizeAndSortingOrder(const QVariant& data);
+    // Write and read the columns size and the sorting order alone, the end of the SaveDataTable.
+    virtual bool writeViewSettings(QDataStream& out) const;
+    virtual bool readViewSettings(QDataStream& in);
+
+protected:
+    // Fixed metrics mode (Settings::isFixedMetrics): all the rows have the same height and the width of a column
+    // fitted to its contents is computed from a bounded sample of rows, the layout does not depend on the list size.
+    static void setupViewMetrics(QTableView* view);
 };
 
 #endif // GAMESORTING_ABSTRACTLISTVIEW_H_
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_AUTOSAVE_H_
+#define GAMESORTING_AUTOSAVE_H_
+
+#include "DataStruct.h"
+#include "SaveInterface.h"
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QByteArray>
+#include <QFutureWatcher>
+
+// Time between two autosaves of a modified list, in milliseconds.
+#define AUTOSAVE_INTERVAL (int)(2 * 60 * 1000)
+
+/*
+Background autosave of the list into a recovery file.
+The database is copied into a snapshot file with VACUUM INTO, it's the only part done on the GUI thread.
+The snapshot is then written into the recovery file by the serializer of SaveInterface on a worker thread,
+with its own connection to the snapshot, so the list can be edited while the recovery file is written.
+The tables not loaded yet are not in the database, their sections are copied from the list file.
+The recovery file is removed when the list is saved or closed, if it still exist when the program start,
+the program was not closed properly.
+*/
+class AutoSave : public QObject
+{
+    Q_OBJECT
+public:
+    // A table of the list, the names of its SQL tables (see TableModel::sqlTableNames),
+    // its number of rows, the settings of its view (see AbstractListView::writeViewSettings)
+    // and its best rated items (see TableModel::topItems).
+    // A table not loaded yet is copied from the section sourceSection of sourceFilePath instead.
+    struct TableSnapshot
+    {
+        QStringList sqlTableNames;
+        long long int rowCount;
+        QByteArray viewSettings;
+        QStringList topItems;
+        QString sourceFilePath;
+        SaveInterface::FileSection sourceSection;
+    };
+
+    explicit AutoSave(QSqlDatabase& db, QObject* parent = nullptr);
+    virtual ~AutoSave();
+
+    // Take a snapshot of the database and write it into the recovery file in the background.
+    // filePath is the file of the list, it's given back by recoveryListFilePath.
+    bool save(ListType type, const QString& filePath, const QList<TableSnapshot>& tables);
+    bool isRunning() const;
+    // Wait the end of the running autosave, then remove the recovery file.
+    void discard();
+
+    static bool hasRecovery();
+    static QString recoveryFilePath();
+    // The file of the autosaved list, empty if the list was not saved into a file.
+    static QString recoveryListFilePath();
+
+private:
+    static QString recoveryDirectory();
+    static QString snapshotFilePath();
+    static QString listFilePathFile();
+    static bool writeRecovery(ListType type, const QString& filePath, const QList<TableSnapshot>& tables);
+
+    QSqlDatabase& m_db;
+    QFutureWatcher<bool> m_watcher;
+};
+
+#endif // GAMESORTING_AUTOSAVE_H_
@@ -0,0 +1,109 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_BLOCKCOMPRESSEDDEVICE_H_
+#define GAMESORTING_BLOCKCOMPRESSEDDEVICE_H_
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QList>
+
+// Size of the uncompressed data of a block.
+#define COMPRESSED_BLOCK_SIZE (int)(256 * 1024)
+// Maximum uncompressed size of a block accepted by the reader,
+// the sizes are read from the file and cannot be trusted.
+#define COMPRESSED_BLOCK_MAX_SIZE (int)(16 * 1024 * 1024)
+
+/*
+Block compressed payload of the list files.
+The payload is cut into blocks of COMPRESSED_BLOCK_SIZE bytes and each block
+is compressed independently with qCompress. The blocks are followed by the
+block index (the number of blocks, then the offset, the compressed size and
+the uncompressed size of each block) and by the offset of the index.
+*/
+struct CompressedBlockInfo
+{
+    qint64 offset;
+    int compressedSize;
+    int uncompressedSize;
+};
+
+// CRC-32 of data, crc is the CRC-32 of the data before (0 at the beginning).
+quint32 blockChecksum(const char* data, qint64 size, quint32 crc = 0);
+
+// Write the payload into the device as compressed blocks.
+// finish must be called to write the last block and the index.
+// The offsets of the index are relative to baseOffset.
+class BlockCompressedWriter : public QIODevice
+{
+public:
+    explicit BlockCompressedWriter(QIODevice* device, qint64 baseOffset = 0);
+    virtual ~BlockCompressedWriter();
+
+    virtual bool isSequential() const override;
+    bool finish();
+    // CRC-32 of everything written into the device (the blocks and the index).
+    quint32 checksum() const;
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize) override;
+    virtual qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    bool writeBlock(const QByteArray& block);
+
+    QIODevice* m_device;
+    qint64 m_baseOffset;
+    QByteArray m_buffer;
+    QList<CompressedBlockInfo> m_blocks;
+    quint32 m_checksum;
+    bool m_isFailed;
+};
+
+// Read the payload from the device, the payload start at the current position of the device.
+// The blocks are decompressed in parallel, a few blocks at a time, so the memory used stay bounded.
+// If the device is a QBuffer (a mapped file), the blocks are decompressed in place.
+class BlockCompressedReader : public QIODevice
+{
+public:
+    explicit BlockCompressedReader(QIODevice* device);
+    virtual ~BlockCompressedReader();
+
+    virtual bool open(OpenMode mode) override;
+    virtual bool isSequential() const override;
+    virtual qint64 bytesAvailable() const override;
+
+protected:
+    virtual qint64 readData(char* data, qint64 maxSize) override;
+    virtual qint64 writeData(const char* data, qint64 maxSize) override;
+
+private:
+    bool readIndex();
+    bool decompressNextBlocks();
+
+    QIODevice* m_device;
+    qint64 m_payloadOffset;
+    const char* m_memory;
+    QList<CompressedBlockInfo> m_blocks;
+    int m_nextBlock;
+    QList<QByteArray> m_decompressedBlocks;
+    qint64 m_blockPos;
+    qint64 m_remainingSize;
+};
+
+#endif // GAMESORTING_BLOCKCOMPRESSEDDEVICE_H_
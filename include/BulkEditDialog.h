@@ -0,0 +1,80 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_BULKEDITDIALOG_H_
+#define GAMESORTING_BULKEDITDIALOG_H_
+
+#include "DataStruct.h"
+#include "SqlUtilityTable.h"
+
+#include <QDialog>
+#include <QList>
+#include <QModelIndexList>
+#include <QSqlDatabase>
+
+class TableModel;
+class UtilityInterfaceEditorModel;
+class StarWidget;
+class QComboBox;
+class QLineEdit;
+class QStackedLayout;
+class QTableView;
+class QVBoxLayout;
+
+/*
+Dialog editing the rate, the sensitive content or the utilities of all the selected items at once.
+The change is applied by the TableModel in one transaction, instead of one edit by item.
+*/
+class BulkEditDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit BulkEditDialog(
+        TableModel* model,
+        const QModelIndexList& indexList,
+        SqlUtilityTable& utility,
+        QSqlDatabase& db,
+        QWidget* parent = nullptr);
+    virtual ~BulkEditDialog();
+
+private:
+    void createWidget();
+    void fieldChanged(int index);
+    void applyEdit();
+
+    TableModel* m_model;
+    QModelIndexList m_indexList;
+    SqlUtilityTable& m_utility;
+    QSqlDatabase& m_db;
+    // The utility tables of the list, after the rate and the sensitive content in the field combo box.
+    QList<UtilityTableName> m_utilityTables;
+
+    QStackedLayout* m_stackedLayout;
+    StarWidget* m_rateWidget;
+    StarWidget* m_explicitWidget;
+    StarWidget* m_violenceWidget;
+    StarWidget* m_badLanguageWidget;
+    QComboBox* m_modeComboBox;
+    QLineEdit* m_searchLine;
+    QVBoxLayout* m_utilityVLayout;
+    UtilityTableName m_utilityTableName;
+    UtilityInterfaceEditorModel* m_utilityModel;
+    QTableView* m_utilityView;
+};
+
+#endif // GAMESORTING_BULKEDITDIALOG_H_
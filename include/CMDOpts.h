@@ -21,22 +21,43 @@
 
 #include <QCommandLineParser>
 #include <QCommandLineOption>
-#include <QApplication>
+#include <QCoreApplication>
+#include <QStringList>
 
 class CMDOpts
 {
     CMDOpts(const CMDOpts& other) = delete;
 public:
-    CMDOpts(QApplication& app);
+    CMDOpts(QCoreApplication& app);
+
+    // Check, before the application object is created, if the program
+    // is run without window (--stats, --export, --convert, --validate or --upgrade).
+    static bool isHeadless(int argc, char** argv);
 
     const QString& itemListFile() const;
+    const QStringList& itemListFiles() const;
     bool resetSettings() const;
     bool doNotSaveSettings() const;
 
+    // Headless mode.
+    bool stats() const;
+    bool validate() const;
+    const QString& exportFormat() const;
+    const QString& convertOutput() const;
+    const QString& upgradeDirectory() const;
+    const QString& output() const;
+
 private:
     QString m_itemListFile;
+    QStringList m_itemListFiles;
     bool m_resetSettings;
     bool m_doNotSaveSettings;
+    bool m_stats;
+    bool m_validate;
+    QString m_exportFormat;
+    QString m_convertOutput;
+    QString m_upgradeDirectory;
+    QString m_output;
 };
 
 #endif // GAMESORTING_CMDOPTS_H_
\ No newline at end of file
@@ -31,6 +31,9 @@ QString replaceSpaceByUnderscore(const QString& str);
 QString replaceUnderscoreBySpace(const QString& str);
 QString replaceMultipleSpaceByOne(const QString& str);
 RecentFileData getRecentFileData(const QString& filePath);
+// Read the metadata of a list file and return a short description of it,
+// an empty string if the file does not have metadata. Can be called from any thread.
+QString getFilePreview(const QString& filePath);
 
 template<typename T>
 T inRange(T value, T min, T max);
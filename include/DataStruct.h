@@ -22,6 +22,7 @@
 #include <QString>
 #include <QList>
 #include <QMetaType>
+#include <QVariant>
 
 struct ItemUtilityData
 {
@@ -50,6 +51,14 @@ enum class ViewType
     UTILITY,
 };
 
+// How the utilities of a bulk edit are applied to the selected items.
+enum class BulkEditMode
+{
+    ADD,
+    REMOVE,
+    REPLACE
+};
+
 struct SensitiveContent
 {
     int explicitContent = 0;
@@ -583,4 +592,14 @@ struct ListFilter
     int rate;
 };
 
+// The value of type T stored inside the variant, read in place without copying it.
+// Return nullptr if the variant does not hold a T.
+template<typename T>
+const T* variantValue(const QVariant& variant)
+{
+    if (variant.metaType() != QMetaType::fromType<T>())
+        return nullptr;
+    return static_cast<const T*>(variant.constData());
+}
+
 #endif // GAMESORTING_DATASTRUCT_H_
\ No newline at end of file
@@ -24,6 +24,13 @@
 
 #include <QDialog>
 #include <QSqlDatabase>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+
+// Delay in milliseconds between the last change of the filter and the counting of the matching items.
+#define FILTER_DIALOG_COUNT_DELAY 150
 
 class QVBoxLayout;
 class UtilityInterfaceEditorModel;
@@ -33,6 +40,8 @@ class TableModel;
 class QTableView;
 class QLineEdit;
 class QStackedLayout;
+class QLabel;
+class QTimer;
 
 class FilterDialog : public QDialog
 {
@@ -55,6 +64,17 @@ private:
     void comboBoxChanged(int index);
     void searchUtilities(const QString& pattern);
 
+    // Preview of the number of items matching the filter.
+    // The items are read once from the SQL database, the counting is done in a worker thread.
+    void retrieveItems();
+    void retrieveUtilityPostings(UtilityTableName tableName);
+    void scheduleMatchCount();
+    void updateMatchCount();
+    void matchCountReady();
+    void setMatchCountText(int count);
+    static int countNameMatches(const QStringList& itemNames, const QString& pattern);
+    static int countUtilityMatches(const QHash<long long int, QList<long long int>>& utilityPostings, const QList<long long int>& utilities);
+
     TableModel* m_model;
     TableModel_UtilityInterface* m_interface;
     SqlUtilityTable& m_utility;
@@ -66,6 +86,15 @@ private:
     QTableView* m_utilityView;
     StarWidget* m_starWidget;
     int m_lastIndex;
+
+    QLabel* m_matchCountLabel;
+    QTimer* m_matchCountTimer;
+    QFutureWatcher<int> m_matchCountWatcher;
+    // The names of the items of the list and the number of items of each rate.
+    QStringList m_itemNames;
+    QHash<int, int> m_rateCounts;
+    // The items linked to each utility of the utility table shown.
+    QHash<long long int, QList<long long int>> m_utilityPostings;
 };
 
 #endif // GAMESORTING_FILTERDIALOG_H_
\ No newline at end of file
@@ -41,7 +41,11 @@ public:
     QString tableName() const;
     void setTableName(const QString& tableName);
     ListType listType() const;
-    QVariant listData() const;
+    virtual bool writeListData(QDataStream& out) const override;
+    virtual TableModel* tableModel() const override;
+    virtual void setColumnsSizeAndSortingOrder(const QVariant& data) override;
+    virtual bool writeViewSettings(QDataStream& out) const override;
+    virtual bool readViewSettings(QDataStream& in) override;
     virtual ViewType viewType() const override;
 
 signals:
@@ -60,12 +64,13 @@ private slots:
     void moveItemDown();
     void moveItemTo();
     void filter();
+    void bulkEdit();
 
 private:
     void setupWidget();
     void setupView();
     void createMenu(QVBoxLayout* vLayout);
-    void setColumnsSizeAndSortingOrder(const QVariant& data);
+    Game::ColumnsSize columnsSize() const;
     void enableAction(QAction* action, bool value) const;
 
     QSqlDatabase& m_db;
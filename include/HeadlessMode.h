@@ -0,0 +1,76 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_HEADLESSMODE_H_
+#define GAMESORTING_HEADLESSMODE_H_
+
+#include "DataStruct.h"
+#include "ListExporter.h"
+#include <QSqlDatabase>
+#include <QVariant>
+#include <QString>
+#include <QList>
+#include <QByteArray>
+
+class CMDOpts;
+class SqlUtilityTable;
+class TableModel;
+class QTextStream;
+
+/*
+Process the list files given on the command line without creating any widget
+(--stats, --export, --convert, --validate and --upgrade). The files are loaded into the
+in memory SQL database with the same code than the window.
+*/
+class HeadlessMode
+{
+    HeadlessMode(const HeadlessMode& other) = delete;
+public:
+    HeadlessMode(const CMDOpts& opts);
+    ~HeadlessMode();
+
+    // Process every file and return the exit code of the program.
+    int exec();
+
+private:
+    bool loadFile(const QString& filePath);
+    bool applyJournal(const QString& filePath, bool isStrict = false);
+    void unloadFile();
+
+    bool validateFile(const QString& filePath);
+    void printStats(QTextStream& out, const QString& filePath) const;
+    bool exportList(QTextStream& out, const QString& filePath, ListExporter::Format format, bool isFirst);
+    bool convertFile(const QString& filePath, const QString& outputPath);
+    int upgradeDirectory(const QString& directory) const;
+
+    template<typename SaveDataTable>
+    static QByteArray viewSettings(const SaveDataTable& table);
+    static QList<QVariant> tablesData(const QVariant& data);
+    static QVariant utilityData(const QVariant& data);
+    static TableModel* createModel(ListType type, const QVariant& table, QSqlDatabase& db, SqlUtilityTable& utilityTable);
+
+    const CMDOpts& m_opts;
+    QSqlDatabase m_db;
+    SqlUtilityTable* m_utilityTable;
+    ListType m_listType;
+    QList<TableModel*> m_models;
+    QList<int> m_fileRowCount;
+    QList<QByteArray> m_viewSettings;
+};
+
+#endif // GAMESORTING_HEADLESSMODE_H_
@@ -0,0 +1,50 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_IMPORTDIALOG_H_
+#define GAMESORTING_IMPORTDIALOG_H_
+
+#include <QDialog>
+#include <QStringList>
+#include <QList>
+
+class QComboBox;
+
+/*
+Dialog to choose the column of the list where each column of an imported file is inserted,
+see ListImporter.
+*/
+class ImportDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit ImportDialog(
+        const QStringList& fileColumns,
+        const QStringList& listColumns,
+        const QList<int>& mapping,
+        long long int rowCount,
+        QWidget* parent = nullptr);
+
+    // For each column of the file, the index of the column of the list or -1.
+    QList<int> mapping() const;
+
+private:
+    QList<QComboBox*> m_columnComboBoxes;
+};
+
+#endif // GAMESORTING_IMPORTDIALOG_H_
@@ -0,0 +1,81 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_LISTEXPORTER_H_
+#define GAMESORTING_LISTEXPORTER_H_
+
+#include "DataStruct.h"
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+class QTextStream;
+
+// Number of items read from the SQL database before being written.
+#define EXPORT_CHUNK_SIZE (int)(1000)
+
+/*
+Export the tables of a list into CSV, JSON or JSON Lines.
+The items are read from the SQL tables with forward only queries, EXPORT_CHUNK_SIZE items at a time,
+the items table, every utility interface table and the sensitive content table are read in the order
+of the list and merged together, so the memory used does not depend on the number of items.
+The CSV and the JSON Lines write one item by line with the name of its table, the JSON write a document
+with the tables of the list.
+*/
+class ListExporter
+{
+    ListExporter(const ListExporter& other) = delete;
+public:
+    enum class Format
+    {
+        CSV,
+        JSON,
+        JSON_LINES
+    };
+
+    ListExporter(QSqlDatabase& db, ListType type, Format format, QTextStream& out);
+
+    // Write the CSV header or the beginning of the JSON document.
+    void begin(const QString& filePath);
+    // Write every item of a table, sqlTableNames are the SQL tables of the table (see TableModel::sqlTableNames).
+    bool exportTable(const QString& tableName, const QStringList& sqlTableNames);
+    // Write the end of the JSON document.
+    void end();
+
+    // The format from its name: csv, json or jsonl.
+    static bool format(const QString& name, Format& format);
+    static QString listTypeName(ListType type);
+    static QString csvField(const QString& field);
+    // The columns of the export: the name, the extra columns, the utilities,
+    // the sensitive content, the url and the rate.
+    static QStringList columnNames(ListType type);
+    // The integer columns of the items table between the name and the utilities.
+    static QStringList extraColumns(ListType type);
+    // The id and the position columns of the items table are prefixed by the type of the list.
+    static QString itemPrefix(ListType type);
+
+private:
+
+    QSqlDatabase& m_db;
+    ListType m_type;
+    Format m_format;
+    QTextStream& m_out;
+    int m_tableCount;
+};
+
+#endif // GAMESORTING_LISTEXPORTER_H_
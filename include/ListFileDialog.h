@@ -0,0 +1,47 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_LISTFILEDIALOG_H_
+#define GAMESORTING_LISTFILEDIALOG_H_
+
+#include <QFileDialog>
+#include <QFutureWatcher>
+#include <QString>
+
+class QLabel;
+
+/*
+File dialog used to open a list, the metadata of the selected file (see SaveInterface::FileMetadata)
+are read in the background and shown next to the files.
+The native dialog is not used, it cannot be extended with the preview.
+*/
+class ListFileDialog : public QFileDialog
+{
+    Q_OBJECT
+public:
+    ListFileDialog(QWidget* parent, const QString& caption, const QString& directory, const QString& filter);
+
+private:
+    void readPreview(const QString& filePath);
+    void previewRead();
+
+    QLabel* m_preview;
+    QFutureWatcher<QString> m_previewWatcher;
+};
+
+#endif // GAMESORTING_LISTFILEDIALOG_H_
@@ -0,0 +1,82 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_LISTIMPORTER_H_
+#define GAMESORTING_LISTIMPORTER_H_
+
+#include "DataStruct.h"
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QList>
+#include <functional>
+
+class SqlUtilityTable;
+
+// Number of rows inserted between two calls of the progress function.
+#define IMPORT_PROGRESS_STEP (int)(500)
+
+/*
+Import items from a CSV or a JSON Lines file into a table of the list.
+The file is read first, then each column of the file is mapped to a column of the list
+(see ListExporter::columnNames), the columns with the same name are mapped by default,
+so a file exported by ListExporter is imported as is.
+The utility names of every item are resolved at once by SqlUtilityTable::addItems, then the items,
+their utilities and their sensitive content are inserted with prepared statements in one transaction.
+*/
+class ListImporter
+{
+    ListImporter(const ListImporter& other) = delete;
+public:
+    // Called every IMPORT_PROGRESS_STEP rows, return false to cancel the import.
+    typedef std::function<bool(long long int done, long long int total)> Progress;
+
+    ListImporter(QSqlDatabase& db, SqlUtilityTable& utilityTable, ListType type);
+
+    // Read the CSV or the JSON Lines (.jsonl) file.
+    bool read(const QString& filePath);
+    // The columns of the file.
+    const QStringList& fileColumns() const;
+    long long int rowCount() const;
+    // The columns of the list, the index of a column is used in the mapping.
+    QStringList listColumns() const;
+    // For each column of the file, the index of its column in the list or -1 if it's not imported.
+    QList<int> defaultMapping() const;
+
+    // Insert the rows of the file into the table, sqlTableNames are the SQL tables of the table
+    // (see TableModel::sqlTableNames). Nothing is inserted if it fails or it's canceled.
+    bool import(const QStringList& sqlTableNames, const QList<int>& mapping, const Progress& progress = Progress());
+
+private:
+    bool readCSV(const QString& filePath);
+    bool readJSONLines(const QString& filePath);
+    bool insertRows(const QStringList& sqlTableNames, const QList<int>& mapping, const Progress& progress);
+    static QStringList utilityNames(const QVariant& value);
+    static SensitiveContent sensitiveContent(const QVariant& value);
+
+    QSqlDatabase& m_db;
+    SqlUtilityTable& m_utilityTable;
+    ListType m_type;
+    QStringList m_fileColumns;
+    // The values of the rows in the order of m_fileColumns.
+    // The JSON arrays are read as QStringList and the JSON objects as QVariantMap.
+    QList<QVariantList> m_rows;
+};
+
+#endif // GAMESORTING_LISTIMPORTER_H_
@@ -0,0 +1,96 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_LISTSTATISTICS_H_
+#define GAMESORTING_LISTSTATISTICS_H_
+
+#include "DataStruct.h"
+
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QSqlDatabase>
+
+class TableModel;
+class SqlUtilityTable;
+
+/*
+Aggregates of a list: the number of items of each rate, of each utility and of each sensitive content level.
+The aggregates are computed once from the SQL tables, then kept up to date by the mutation paths of the TableModel,
+an edited item only change its own counts. After a bulk change (opening, import), the aggregates are computed
+again on the next read.
+*/
+class ListStatistics : public QObject
+{
+    Q_OBJECT
+public:
+    enum SensitiveContentKind
+    {
+        EXPLICIT_CONTENT = 0,
+        VIOLENCE_CONTENT = 1,
+        BAD_LANGUAGE = 2
+    };
+
+    ListStatistics(TableModel* model, SqlUtilityTable& utilityTable, QSqlDatabase& db);
+    virtual ~ListStatistics();
+
+    // The aggregates of the list, the counts equal to zero are not stored.
+    long long int itemCount();
+    const QHash<int, long long int>& rateCounts();
+    const QHash<long long int, long long int>& utilityCounts(UtilityTableName tableName);
+    // The items without sensitive content are not counted.
+    const QHash<int, long long int>& sensitiveContentCounts(SensitiveContentKind kind);
+    QString utilityName(UtilityTableName tableName, long long int utilityID);
+
+    // Called by the TableModel when the list is edited.
+    void invalidate();
+    void itemInserted(long long int itemID, int rate);
+    void itemsRemoved(const QList<long long int>& itemsID);
+    void rateChanged(long long int itemID, int rate);
+    void utilityChanged(long long int itemID, UtilityTableName tableName);
+
+signals:
+    void statisticsChanged();
+
+private:
+    void update();
+    bool retrieveRates();
+    bool retrieveUtilities(UtilityTableName tableName);
+    bool retrieveSensitiveContent();
+    QList<long long int> retrieveItemUtilities(long long int itemID, UtilityTableName tableName);
+    void setItemUtilities(long long int itemID, UtilityTableName tableName, const QList<long long int>& utilitiesID);
+    void setItemSensitiveContent(long long int itemID, const SensitiveContent* sensitiveContent);
+    static void addCount(QHash<int, long long int>& counts, int key, long long int count);
+    static void addCount(QHash<long long int, long long int>& counts, long long int key, long long int count);
+
+    TableModel* m_model;
+    SqlUtilityTable& m_utilityTable;
+    QSqlDatabase& m_db;
+    bool m_isUpToDate;
+
+    QHash<long long int, int> m_itemRates;
+    QHash<int, long long int> m_rateCounts;
+    // For each utility table, the utilities of each item and the number of items of each utility.
+    QHash<int, QHash<long long int, QList<long long int>>> m_itemUtilities;
+    QHash<int, QHash<long long int, long long int>> m_utilityCounts;
+    QHash<long long int, SensitiveContent> m_itemSensitiveContent;
+    QHash<int, long long int> m_sensitiveContentCounts[3];
+};
+
+#endif // GAMESORTING_LISTSTATISTICS_H_
@@ -0,0 +1,60 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_LISTUPGRADER_H_
+#define GAMESORTING_LISTUPGRADER_H_
+
+#include <QString>
+#include <QStringList>
+#include <QFuture>
+
+/*
+Upgrade the list files written with an older version of the file format to the current version,
+so they are not decoded by the legacy code path of SaveInterface anymore when they are opened.
+The upgraded file is written next to the file, read again and compared with the original data
+before replacing the file. The files are upgraded in parallel with QtConcurrent.
+*/
+class ListUpgrader
+{
+public:
+    enum class Status
+    {
+        UPGRADED,
+        UP_TO_DATE,
+        // A file with a journal is not upgraded, the journal is only valid with its file.
+        HAS_JOURNAL,
+        // The upgraded file is not the same as the original file, the original file is kept.
+        NOT_VERIFIED,
+        FAILED
+    };
+
+    struct Result
+    {
+        QString filePath;
+        Status status;
+    };
+
+    // The list files of a directory and its sub directories.
+    static QStringList findFiles(const QString& directory);
+    // Upgrade the files in parallel, the progress of the future is the number of files processed.
+    static QFuture<Result> upgrade(const QStringList& files);
+    static Result upgradeFile(const QString& filePath);
+    static QString statusName(Status status);
+};
+
+#endif // GAMESORTING_LISTUPGRADER_H_
@@ -23,8 +23,11 @@
 #include <QMainWindow>
 #include <QSqlDatabase>
 #include <QString>
+#include <QStringList>
+#include <QFutureWatcher>
 
 class TabAndList;
+class StatisticsDock;
 class QTableView;
 class QToolBar;
 class LicenceDialog;
@@ -61,11 +64,14 @@ private:
 	void about();
 	void reinsertMenu();
 	void updateRecentFileMenu();
+	void recentFilePreviewsRead();
 	void removeOldRecentFile();
 	void removeInvalidRecentFile(const QString& filePath);
 	void openRecentFile(const QString& filePath);
+	void upgradeFiles();
 
 	TabAndList* m_tabAndList;
+	StatisticsDock* m_statisticsDock;
 	QSqlDatabase m_db;
 	QToolBar* m_listToolBar;
 	QString m_listFilePath;
@@ -80,6 +86,7 @@ private:
 	QMenu* m_helpMenu;
 	QMenu* m_recentFileMenu;
 	QList<RecentFileData> m_recentFileData;
+	QFutureWatcher<QStringList> m_recentFilePreviews;
 	LicenceDialog* m_licenceDialog;
 	AboutDialog* m_aboutDialog;
 };
@@ -0,0 +1,65 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_QUICKFILTER_H_
+#define GAMESORTING_QUICKFILTER_H_
+
+#include <QLineEdit>
+#include <QList>
+#include <QString>
+
+// Delay in milliseconds between the last key stroke and the filtering of the rows.
+#define QUICK_FILTER_DELAY 150
+
+class QTableView;
+class QAbstractItemModel;
+class QTimer;
+
+/*
+Search as you type filter of a list view, put into the toolbar of the view.
+The rows of the view not containing the pattern in the column are hidden, the filter read the
+items already in the model and does not query the SQL database. When the new pattern contains the
+previous one, only the rows matching the previous pattern are checked again.
+*/
+class QuickFilter : public QLineEdit
+{
+    Q_OBJECT
+public:
+    QuickFilter(QTableView* view, QAbstractItemModel* model, int column, QWidget* parent = nullptr);
+    virtual ~QuickFilter();
+
+private slots:
+    void patternEdited();
+    void applyPattern();
+    void rowsChanged();
+
+private:
+    bool isMatching(int row, const QString& pattern) const;
+
+    QTableView* m_view;
+    QAbstractItemModel* m_model;
+    int m_column;
+    QTimer* m_timer;
+    // The pattern applied to the view and the rows matching it, in the order of the model.
+    QString m_pattern;
+    QList<int> m_matchingRows;
+    // False when the rows of the model changed since the pattern was applied.
+    bool m_isUpToDate;
+};
+
+#endif // GAMESORTING_QUICKFILTER_H_
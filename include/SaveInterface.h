@@ -21,8 +21,15 @@
 #define GAMESORTING_SAVEINTERFACE_H_
 
 #include <DataStruct.h>
+#include "StringDictionary.h"
 #include <QVariant>
 #include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QList>
+#include <QPair>
+#include <QDataStream>
+#include <functional>
 
 // The primary identifier is used to identify the file of the program.
 // It is place at the beginning of the file and it is followed by the type identifier.
@@ -31,41 +38,257 @@
 #define PRIMARY_IDENTIFIER_SIZE (int)(10)
 
 // Type identifier and version of a GLD file.
+// From the BLOCK_VERSION, the payload of the file is block compressed (see BlockCompressedDevice.h).
+// From the DICTIONARY_VERSION, the names and the urls are dictionary encoded (see StringDictionary.h).
+// From the SECTION_VERSION, each table and the utility data are stored in their own section,
+// the sections are listed in a table of contents (see SaveInterface::TableOfContents).
+// From the METADATA_VERSION, a block of FILE_METADATA_SIZE bytes describing the list
+// is written after the version (see SaveInterface::FileMetadata).
 #define GLD_IDENTIFIER "GLD"
 #define GLD_LEGACY_VERSION (int)(500)
 #define GLD_LEGACY_MAX_SUPPORT (int)(600)
-#define GLD_VERSION (int)(600)
-#define GLD_VERSION_MAX_SUPPORT (int)(700)
+#define GLD_BLOCK_VERSION (int)(700)
+#define GLD_DICTIONARY_VERSION (int)(800)
+#define GLD_SECTION_VERSION (int)(900)
+#define GLD_METADATA_VERSION (int)(1000)
+#define GLD_VERSION (int)(1000)
+#define GLD_VERSION_MAX_SUPPORT (int)(1100)
 
 #define MLD_IDENTIFIER "MLD"
 #define MLD_LEGACY_VERSION (int)(100)
 #define MLD_LEGACY_MAX_SUPPORT (int)(600)
-#define MLD_VERSION (int)(600)
-#define MLD_VERSION_MAX_SUPPORT (int) (700)
+#define MLD_BLOCK_VERSION (int)(700)
+#define MLD_DICTIONARY_VERSION (int)(800)
+#define MLD_SECTION_VERSION (int)(900)
+#define MLD_METADATA_VERSION (int)(1000)
+#define MLD_VERSION (int)(1000)
+#define MLD_VERSION_MAX_SUPPORT (int) (1100)
 
 #define CLD_IDENTIFIER "CLD"
-#define CLD_VERSION (int)(200)
-#define CLD_VERSION_MAX_SUPPORT (int)(300)
+#define CLD_MIN_VERSION (int)(200)
+#define CLD_BLOCK_VERSION (int)(300)
+#define CLD_DICTIONARY_VERSION (int)(400)
+#define CLD_SECTION_VERSION (int)(500)
+#define CLD_METADATA_VERSION (int)(600)
+#define CLD_VERSION (int)(600)
+#define CLD_VERSION_MAX_SUPPORT (int)(700)
 
 #define BLD_IDENTIFIER "BLD"
-#define BLD_VERSION (int)(200)
-#define BLD_VERSION_MAX_SUPPORT (int)(300)
+#define BLD_MIN_VERSION (int)(200)
+#define BLD_BLOCK_VERSION (int)(300)
+#define BLD_DICTIONARY_VERSION (int)(400)
+#define BLD_SECTION_VERSION (int)(500)
+#define BLD_METADATA_VERSION (int)(600)
+#define BLD_VERSION (int)(600)
+#define BLD_VERSION_MAX_SUPPORT (int)(700)
 
 #define SLD_IDENTIFIER "SLD"
-#define SLD_VERSION (int)(100)
-#define SLD_VERSION_MAX_SUPPORT (int)(200)
+#define SLD_MIN_VERSION (int)(100)
+#define SLD_BLOCK_VERSION (int)(200)
+#define SLD_DICTIONARY_VERSION (int)(300)
+#define SLD_SECTION_VERSION (int)(400)
+#define SLD_METADATA_VERSION (int)(500)
+#define SLD_VERSION (int)(500)
+#define SLD_VERSION_MAX_SUPPORT (int)(600)
 
-class QDataStream;
+// Size of the metadata block, the names are truncated to FILE_METADATA_NAME_SIZE characters
+// and FILE_METADATA_TOP_ITEMS best rated items are kept by table.
+#define FILE_METADATA_SIZE (int)(2048)
+#define FILE_METADATA_NAME_SIZE (int)(48)
+#define FILE_METADATA_TOP_ITEMS (int)(3)
+
+// Number of rows given at once to the handler by the streaming open.
+#define OPEN_STREAM_CHUNK_SIZE (long long int)(500)
+// Maximum number of rows reserved before reading a list, the number of rows
+// is read from the file and cannot be trusted, the list only grows with the rows really read.
+#define READ_LIST_MAX_RESERVE (long long int)(4096)
+
+class QSqlDatabase;
+class QSqlQuery;
 
 class SaveInterface
 {
 public:
+    /*
+    Callbacks of the streaming open, every member must be set.
+    The tables are given in the order of the file: beginTable, the items and the utility
+    interface of the table chunk by chunk, then endTable. The utility tables are given last.
+    If a callback return false, the reading is stopped and the open fail.
+    */
+    struct OpenStreamHandler
+    {
+        // The type of the list, called before anything else.
+        std::function<bool(ListType type)> beginList;
+        // The name of a new table.
+        std::function<bool(const QString& tableName)> beginTable;
+        // A SaveDataTable of the list type with only the name and a chunk of the items.
+        std::function<bool(const QVariant& items)> itemsChunk;
+        // A chunk of an utility interface of the current table.
+        std::function<bool(UtilityTableName tableName, const QList<Game::SaveUtilityInterfaceItem>& items)> interfaceChunk;
+        // A chunk of the sensitive content of the current table.
+        std::function<bool(const QList<Game::SaveUtilitySensitiveContentItem>& items)> sensitiveContentChunk;
+        // A SaveDataTable of the list type with the name, the columns size and the sorting, without any rows.
+        std::function<bool(const QVariant& table)> endTable;
+        // A chunk of an utility table.
+        std::function<bool(UtilityTableName tableName, const QList<ItemUtilityData>& items)> utilityChunk;
+    };
+
+    /*
+    A section of a sectioned file: a table or the utility data.
+    Each section is block compressed and dictionary encoded on its own,
+    so it can be read without reading the rest of the file.
+    */
+    struct FileSection
+    {
+        QString tableName;
+        qint64 offset;
+        qint64 length;
+        long long int rowCount;
+        quint32 checksum;
+    };
+
+    /*
+    Table of contents of a sectioned file, the offset of the table of contents is written after the version.
+    It is made of the utility section, the number of tables and the table sections,
+    each section is written as its name, offset, length, number of rows and CRC-32.
+    */
+    struct TableOfContents
+    {
+        ListType type;
+        FileSection utility;
+        QList<FileSection> tables;
+    };
+
+    /*
+    A table section decoded into memory (decompressed, checked and with its strings decoded),
+    the chunks are given later to an handler by replayTable, on the thread of the SQL connection.
+    */
+    struct DecodedTable
+    {
+        bool isDecoded;
+        QString tableName;
+        QList<QVariant> itemsChunks;
+        QList<QPair<UtilityTableName, QList<Game::SaveUtilityInterfaceItem>>> interfaceChunks;
+        QList<QList<Game::SaveUtilitySensitiveContentItem>> sensitiveContentChunks;
+        QVariant table;
+    };
+
+    // A table given to the streaming save, writeTable write the SaveDataTable of the table.
+    // topItems are the names of the best rated items, written into the metadata of the file.
+    // If sourceFilePath is not empty, the section sourceSection of this file (of the current version)
+    // is copied without being decoded, writeTable is not called.
+    struct SaveTableSection
+    {
+        QString tableName;
+        long long int rowCount;
+        std::function<bool(QDataStream& out)> writeTable;
+        QStringList topItems;
+        QString sourceFilePath;
+        FileSection sourceSection;
+    };
+
+    /*
+    Metadata of a file, written into a block of fixed size after the version, so it can be read
+    without reading the rest of the file (recent files, previews, ...). The block is made of the size
+    of the metadata, its CRC-32, the metadata and a zero padding. The tables are listed while they fit
+    into the block, tableCount and itemCount count every tables.
+    */
+    struct FileMetadataTable
+    {
+        QString tableName;
+        long long int rowCount;
+        QStringList topItems;
+    };
+    struct FileMetadata
+    {
+        ListType type;
+        QDateTime saveTime;
+        int tableCount;
+        long long int itemCount;
+        QList<FileMetadataTable> tables;
+    };
+
     static bool save(const QString& filePath, const QVariant& data);
     static bool open(const QString& filePath, QVariant& data);
+    // Streaming open, the file is read chunk by chunk and given to the handler,
+    // the whole list is never loaded into memory.
+    static bool open(const QString& filePath, const OpenStreamHandler& handler);
+
+    /*
+    Streaming save, the headers, the table of contents and the end checks are written by the SaveInterface.
+    Each table is written by its writeTable and the utility data by writeUtility directly into its
+    section (without building a SaveData first). The QVariant save use it too.
+    */
+    static bool save(const QString& filePath, ListType type, const QList<SaveTableSection>& tables, const std::function<bool(QDataStream& out)>& writeUtility);
+    // Read only the metadata of a file, return false if the file does not have one.
+    static bool readMetadata(const QString& filePath, FileMetadata& metadata);
+    // Write again the metadata block of a file in place (the block has a fixed size), the rest of the file is not modified.
+    // Used when the changes are appended to the journal of the file. writeTable of the tables is not called.
+    static bool updateMetadata(const QString& filePath, const QList<SaveTableSection>& tables);
+    // Read only the type and the version of a file, the version is not checked.
+    static bool readFileVersion(const QString& filePath, ListType& type, int& version);
+    // The version written by save for a list type.
+    static int currentVersion(ListType type);
+    // Read the table of contents of a file, return false if it's not a sectioned file.
+    static bool readTableOfContents(const QString& filePath, TableOfContents& toc);
+    // Read only one section of a sectioned file with the streaming handler (beginList is not called).
+    // A table section give beginTable, the items and the utility interface, then endTable.
+    static bool openTable(const QString& filePath, const TableOfContents& toc, int index, const OpenStreamHandler& handler);
+    /*
+    Read several table sections of a sectioned file. The sections are decoded in parallel on the thread pool,
+    at most QThread::idealThreadCount ahead of the table being read, then each table is given to readTable
+    on the calling thread, in the order of indexes. The reading stop at the first table failing.
+    */
+    static bool openTables(const QString& filePath, const TableOfContents& toc, const QList<int>& indexes, const std::function<bool(int index, const DecodedTable& table)>& readTable);
+    // Give the chunks of a decoded table to the handler, in the same order than openTable.
+    static bool replayTable(const DecodedTable& table, const OpenStreamHandler& handler);
+    // The utility section give only utilityChunk.
+    static bool openUtility(const QString& filePath, const TableOfContents& toc, const OpenStreamHandler& handler);
+    // Write the number of rows returned by statement, then each row with writeRow,
+    // the rows are read one by one from the SQL cursor.
+    static bool writeQuery(QDataStream& out, QSqlDatabase& db, const QString& statement, const std::function<void(QDataStream& out, const QSqlQuery& query)>& writeRow);
 
     static bool isLegacy();
+    // The names of the best rated items of a list of SaveItem, for the metadata of the file.
+    template<typename Item>
+    static QStringList topItems(const QList<Item>& items);
+    // Write and read the names and the urls of the items and the utilities,
+    // dictionary encoded if the file version use it, as a QString otherwise.
+    static void writeString(QDataStream& out, const QString& str, StringChannel channel);
+    static void readString(QDataStream& in, QString& str, StringChannel channel);
 
 private:
+    static ListType readIdentifier(QDataStream& in);
+    // The features of the file, depending on its version.
+    struct FileFormat
+    {
+        bool isBlockCompressed;
+        bool hasStringDictionary;
+        bool isSectioned;
+        bool hasMetadata;
+    };
+
+    static bool readVersion(QDataStream& in, ListType type, FileFormat& format);
+    static bool readListStream(QDataStream& in, ListType type, const OpenStreamHandler& handler);
+    static bool readTableStream(QDataStream& in, ListType type, const OpenStreamHandler& handler);
+    static bool readUtilityStream(QDataStream& in, ListType type, const OpenStreamHandler& handler);
+    // Read the payload of the file with readData, then the end check,
+    // the payload is decompressed and the strings decoded depending on the format.
+    static bool readPayload(QDataStream* in, const FileFormat& format, const std::function<bool(QDataStream& in)>& readData);
+    // Read the data with the dictionary of the strings if hasStringDictionary, then the end check.
+    static bool readDataAndEnd(QDataStream& in, bool hasStringDictionary, const std::function<bool(QDataStream& in)>& readData);
+
+    // Sectioned files, the stream is positioned after the version of the file.
+    static bool readTableOfContents(QDataStream& in, ListType type, const FileFormat& format, TableOfContents& toc);
+    static bool readSection(QIODevice* device, const FileSection& section, const std::function<bool(QDataStream& in)>& readData);
+    static bool writeSection(QIODevice* device, const std::function<bool(QDataStream& out)>& writeData, FileSection& section);
+    static bool copySection(QIODevice* device, const QString& sourceFilePath, const FileSection& sourceSection, FileSection& section);
+    static void writeMetadata(QDataStream& out, const QList<SaveTableSection>& tables);
+    // Read every sections of the file, the tables first, then the utility data.
+    static bool readSections(QDataStream* in, ListType type, const FileFormat& format, const std::function<bool(QDataStream& in)>& readTable, const std::function<bool(QDataStream& in)>& readUtility);
+    // Check that the file is a sectioned file of the type type, the stream is positioned after the version.
+    static bool checkSectionedFile(QDataStream& in, ListType type);
+
     static bool saveGame(const QString& filePath, const QVariant& data);
     static bool openGame(QDataStream* in, QVariant& data);
 
@@ -81,9 +304,42 @@ private:
     static bool saveSeriesList(const QString& filePath, const QVariant& data);
     static bool openSeriesList(QDataStream* in, QVariant& data);
 
-    static bool m_isLegacy;
+    // Decode a table section into memory, it can be called from any thread.
+    static DecodedTable decodeTable(const QString& filePath, const TableOfContents& toc, int index);
+
+    // Set by the reading of the version, the files can be read by several threads at once.
+    static thread_local bool m_isLegacy;
+    // The dictionary of the file being read or written, nullptr if the strings are not dictionary encoded.
+    static thread_local StringDictionary* m_stringDictionary;
 };
 
+template<typename Item>
+QStringList SaveInterface::topItems(const QList<Item>& items)
+{
+    // Keeping the FILE_METADATA_TOP_ITEMS best rates, the first items are kept on a tie.
+    QList<const Item*> bestItems;
+    for (const Item& item : items)
+    {
+        if (item.rate <= 0)
+            continue;
+
+        int position = bestItems.size();
+        while (position > 0 && bestItems.at(position-1)->rate < item.rate)
+            position--;
+        if (position < FILE_METADATA_TOP_ITEMS)
+        {
+            bestItems.insert(position, &item);
+            if (bestItems.size() > FILE_METADATA_TOP_ITEMS)
+                bestItems.removeLast();
+        }
+    }
+
+    QStringList names;
+    for (const Item* item : bestItems)
+        names.append(item->name);
+    return names;
+}
+
 // ItemUtilityData QDataStream operators
 QDataStream& operator<<(QDataStream& out, const ItemUtilityData& data);
 QDataStream& operator>>(QDataStream& in, ItemUtilityData& data);
@@ -162,4 +418,38 @@ QDataStream& operator>>(QDataStream& in, Series::SaveItem& data);
 QDataStream& operator<<(QDataStream& out, const Series::ColumnsSize& data);
 QDataStream& operator>>(QDataStream& in, Series::ColumnsSize& data);
 
+/*
+Read a list written as the number of rows followed by the rows.
+A negative count or a read error set the stream status to ReadCorruptData and return false.
+*/
+template<typename CountType = long long int, typename T>
+bool readList(QDataStream& in, QList<T>& list)
+{
+    CountType count;
+    in >> count;
+    if (in.status() != QDataStream::Ok)
+        return false;
+    if (count < 0)
+    {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+
+    list.clear();
+    list.reserve(qMin((long long int)count, READ_LIST_MAX_RESERVE));
+    for (CountType i = 0; i < count; i++)
+    {
+        T item = {};
+        in >> item;
+        if (in.status() != QDataStream::Ok)
+        {
+            list.clear();
+            return false;
+        }
+        list.append(item);
+    }
+
+    return true;
+}
+
 #endif // GAMESORTING_SAVEINTERFACE_H_
\ No newline at end of file
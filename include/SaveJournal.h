@@ -0,0 +1,107 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_SAVEJOURNAL_H_
+#define GAMESORTING_SAVEJOURNAL_H_
+
+#include "SaveInterface.h"
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QVariant>
+#include <QByteArray>
+#include <functional>
+
+#define JOURNAL_IDENTIFIER "JRN"
+#define JOURNAL_VERSION (int)(100)
+// The journal is compacted (the list is saved again into its file) when it's bigger
+// than the file divided by JOURNAL_COMPACTION_RATIO, but not before JOURNAL_COMPACTION_MIN_SIZE.
+#define JOURNAL_COMPACTION_RATIO (qint64)(4)
+#define JOURNAL_COMPACTION_MIN_SIZE (qint64)(256 * 1024)
+
+/*
+Append only journal of the changes of a list saved into a sectioned file.
+The journal is a file next to the list file. A save of a small change append a batch
+with the rows changed since the previous save, instead of writing the whole list again.
+The changed rows are recorded by SQL triggers, so every path editing the SQL tables is captured.
+
+A journal file is made of the identifiers, the version and the identifier of the list file
+(see baseIdentifier), then the batches: the size of the batch, the batch and its CRC-32.
+A batch is made of the settings of the views, then the rows changes.
+An incomplete batch at the end of the file (interrupted write) is ignored.
+*/
+class SaveJournal
+{
+    SaveJournal(const SaveJournal& other) = delete;
+public:
+    // The rows of a SQL table matching the key are replaced by rows.
+    struct RowChange
+    {
+        QStringList keyColumns;
+        QVariantList keyValues;
+        QStringList columns;
+        QList<QVariantList> rows;
+    };
+
+    explicit SaveJournal(QSqlDatabase& db);
+    ~SaveJournal();
+
+    static QString journalPath(const QString& filePath);
+    static bool exists(const QString& filePath);
+    static bool remove(const QString& filePath);
+    // The journal must be compacted into the list file.
+    static bool needCompaction(const QString& filePath);
+
+    // Start recording the changes of every SQL tables.
+    bool track();
+    void untrack();
+    // Return true if every changes are recorded since track (no table created, dropped or renamed).
+    bool isTracking() const;
+    // Forget the changes recorded for these tables.
+    void clearChanges(const QStringList& tableNames);
+
+    // Append the recorded changes and the settings of the views to the journal of the file, then forget them.
+    bool append(const QString& filePath, const SaveInterface::TableOfContents& toc, const QHash<QString, QByteArray>& viewSettings);
+    // Read the journal of the file, return false if there is none or if it's the journal of another version of the file.
+    // If isComplete is not null, it's set to false when the end of the journal is ignored (incomplete or corrupted batch).
+    bool read(const QString& filePath, const SaveInterface::TableOfContents& toc, bool* isComplete = nullptr);
+    // Return true if changes or settings of a view were read for these SQL tables.
+    bool hasChanges(const QStringList& tableNames) const;
+    // Apply the changes read for these SQL tables.
+    bool apply(const QStringList& tableNames);
+    // The last settings of a view read from the journal, empty if none.
+    QByteArray viewSettings(const QString& tableName) const;
+    // Forget the changes read.
+    void clear();
+
+private:
+    static quint32 baseIdentifier(const SaveInterface::TableOfContents& toc);
+    static qint64 readJournal(const QString& filePath, quint32 baseId, const std::function<bool(const QByteArray& batch)>& readBatch);
+    QStringList keyColumns(const QString& tableName) const;
+    QStringList userTables() const;
+
+    QSqlDatabase& m_db;
+    QStringList m_trackedTables;
+    bool m_isTracking;
+    QHash<QString, QList<RowChange>> m_changes;
+    QHash<QString, QByteArray> m_viewSettings;
+};
+
+#endif // GAMESORTING_SAVEJOURNAL_H_
@@ -29,6 +29,10 @@ public:
     inline bool isLegacyUtilEditor() const;
     void setLegacyUtilEditor(bool value);
 
+    // Fixed metrics of the list views: uniform rows height and columns fitted from a sample of the rows.
+    inline bool isFixedMetrics() const;
+    void setFixedMetrics(bool value);
+
     /*
     Only one instance of the class can be created.
     This method return an existing instance of Settings class.
@@ -39,6 +43,7 @@ private:
     static Settings m_instance;
 
     bool m_isLegacyUtilEditor;
+    bool m_isFixedMetrics;
 };
 
 inline bool Settings::isLegacyUtilEditor() const
@@ -46,6 +51,11 @@ inline bool Settings::isLegacyUtilEditor() const
     return m_isLegacyUtilEditor;
 }
 
+inline bool Settings::isFixedMetrics() const
+{
+    return m_isFixedMetrics;
+}
+
 inline Settings& Settings::instance()
 {
     return m_instance;
@@ -38,6 +38,8 @@ private:
     // If true, use the legacy utility editor,
     // otherwise, use the line edit utility editor.
     QCheckBox* m_legUtilEditCheckBox;
+    // If true, the rows of the lists have a fixed height (Settings::isFixedMetrics).
+    QCheckBox* m_fixedMetricsCheckBox;
 };
 
 #endif // GAMESORTING_SETTINGSDIALOG_H_
\ No newline at end of file
@@ -26,6 +26,12 @@
 #include <QString>
 #include <QList>
 #include <QVariant>
+#include <QHash>
+#include <QStringList>
+#include <QSet>
+
+class QDataStream;
+class UtilityNameIndex;
 
 class SqlUtilityTable : public QObject
 {
@@ -36,12 +42,34 @@ public:
 
 	void newList(ListType type);
 	static QString tableName(UtilityTableName tableName);
+	// The utility tables of a list type, in the order they are saved.
+	static QList<UtilityTableName> utilityTables(ListType type);
 	QList<ItemUtilityData> retrieveTableData(UtilityTableName tableName, bool sort = false, Qt::SortOrder order = Qt::AscendingOrder, const QString& searchPattern = QString()) const;
 
-	QVariant data() const;
 	bool setData(const QVariant& data);
+	// Write the utility tables directly into the stream, same output than the SaveUtilityData.
+	bool writeData(QDataStream& out) const;
+	// Write the utility tables of the database db into the stream, same output than writeData.
+	static bool writeTables(QDataStream& out, QSqlDatabase& db, ListType type);
+	// Insert rows into an utility table without clearing it, used by the streaming open.
+	bool appendData(UtilityTableName tableName, const QList<ItemUtilityData>& data);
 
 	long long int addItem(UtilityTableName tableName, const QString& name);
+	// Return the id of each name, the names not in the table are inserted at the end of the table.
+	// The existing names are read at once and the new names are inserted with a prepared statement.
+	// If ok is not null, it's set to false when a name could not be read or inserted (its id is missing).
+	QHash<QString, long long int> addItems(UtilityTableName tableName, const QStringList& names, bool* ok = nullptr);
+
+	// Fuzzy search of the names of an utility table, the best match first, the order of the items is the rank of the match.
+	// If maxResults is positive, only the maxResults best matches are returned.
+	QList<ItemUtilityData> searchTableData(UtilityTableName tableName, const QString& pattern, int maxResults = -1);
+	// Trigram index of the names of an utility table, shared by the editors.
+	// The names are read from the table the first time, then the index is updated with the changes of the names.
+	const UtilityNameIndex& nameIndex(UtilityTableName tableName);
+	// Update the name index with a change of the names made outside of the SqlUtilityTable.
+	void utilityNameAdded(UtilityTableName tableName, long long int utilityID, const QString& name);
+	void utilityNameRemoved(UtilityTableName tableName, long long int utilityID);
+	void utilityNameChanged(UtilityTableName tableName, long long int utilityID, const QString& name);
 
 signals:
 	void utilityEdited();
@@ -62,7 +90,6 @@ private:
 	void createPublishersTable();
 	void createPlatformTable();
 	void createServicesTable();
-	QVariant queryGameData() const;
 	bool setGameData(const QVariant& data);
 
 	// Movies
@@ -72,34 +99,35 @@ private:
 	void createActorsTable();
 	void createProductionsTable();
 	void createMusicTable();
-	QVariant queryMoviesData() const;
 	bool setMoviesData(const QVariant& data);
 
 	// Common
 	void createCommonTables();
 	void destroyCommonTables();
 	void createAuthorsTables();
-	QVariant queryCommonsData() const;
 	bool setCommonsData(const QVariant& data);
 
 	// Books
 	void createBooksTables();
 	void destroyBooksTables();
-	QVariant queryBooksData() const;
 	bool setBooksData(const QVariant& data);
 
 	// Series
 	void createSeriesTables();
 	void destroySeriesTables();
-	QVariant querySeriesData() const;
 	bool setSeriesData(const QVariant& data);
 
 	static void errorMessageCreatingTable(const QString& tableName, const QString& queryError);
+	// The name indexes are read again from the tables the next time they are used.
+	void invalidateNameIndexes();
 
 	ListType m_type;
 	QSqlDatabase& m_db;
 	QSqlQuery m_query;
 	bool m_isTableReady;
+	// Name indexes by utility table, the indexes of m_staleNameIndexes must be read again.
+	QHash<int, UtilityNameIndex*> m_nameIndexes;
+	QSet<int> m_staleNameIndexes;
 };
 
 #endif // GAMESORTING_SQLUTILITYTABLE_H_
\ No newline at end of file
@@ -20,6 +20,7 @@
 #define GAMESORTING_STAREDITOR_H_
 
 #include <QWidget>
+#include <QPixmap>
 
 class StarEditor : public QWidget
 {
@@ -30,6 +31,10 @@ public:
 	virtual ~StarEditor();
 
 	static void paintStars(int starNB, QPainter* painter, QRect rect, QPalette palette, bool isEditMode = false, bool showHidenStars = false, int maxStars = 5);
+	// The stars of paintStars rasterized into a pixmap of the given height, the pixmap is kept into the QPixmapCache.
+	// The color and the device pixel ratio are part of the key, a palette or a DPI change never reuse an old pixmap.
+	// Return a null pixmap if there is no star to paint.
+	static QPixmap starsPixmap(int starNB, int height, qreal devicePixelRatio, const QColor& color);
 	static QSize sizeHint(int maxStars);
 	static double paintFactor();
 	static const QPolygonF& polygonData();
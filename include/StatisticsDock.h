@@ -0,0 +1,65 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_STATISTICSDOCK_H_
+#define GAMESORTING_STATISTICSDOCK_H_
+
+#include "DataStruct.h"
+
+#include <QDockWidget>
+#include <QHash>
+#include <QPointer>
+
+// Delay in milliseconds between the last change of the list and the refresh of the statistics.
+#define STATISTICS_DOCK_DELAY 200
+
+class TableModel;
+class QTreeWidget;
+class QTreeWidgetItem;
+class QTimer;
+
+/*
+Dock showing the statistics of the current tab: the number of items of each utility, of each rate
+and of each sensitive content level. The aggregates are maintained by the ListStatistics of the model,
+the dock only read them, and only while it is visible.
+*/
+class StatisticsDock : public QDockWidget
+{
+    Q_OBJECT
+public:
+    explicit StatisticsDock(QWidget* parent = nullptr);
+    virtual ~StatisticsDock();
+
+public slots:
+    void setModel(TableModel* model);
+
+private slots:
+    void statisticsChanged();
+    void refresh();
+
+private:
+    QTreeWidgetItem* addCategory(const QString& name, long long int count);
+    void addCount(QTreeWidgetItem* category, const QString& name, long long int count);
+    void addCounts(QTreeWidgetItem* category, const QHash<int, long long int>& counts);
+
+    QPointer<TableModel> m_model;
+    QTreeWidget* m_tree;
+    QTimer* m_timer;
+};
+
+#endif // GAMESORTING_STATISTICSDOCK_H_
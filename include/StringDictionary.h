@@ -0,0 +1,80 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_STRINGDICTIONARY_H_
+#define GAMESORTING_STRINGDICTIONARY_H_
+
+#include <QString>
+#include <QList>
+#include <QHash>
+
+class QDataStream;
+
+// The kind of strings sharing a dictionary.
+enum class StringChannel
+{
+    ITEM_NAME = 0,
+    ITEM_URL = 1,
+    UTILITY_NAME = 2
+};
+#define STRING_CHANNEL_COUNT (int)(3)
+
+// Maximum number of strings in the dictionary of a channel,
+// the writer and the reader stop adding strings at the same point.
+#define STRING_DICTIONARY_MAX_SIZE (int)(65536)
+// Maximum size of a string accepted by the reader.
+#define STRING_DICTIONARY_MAX_STRING_SIZE (int)(16 * 1024 * 1024)
+
+/*
+Dictionary encoding of the strings of a list file.
+The dictionary is built while the file is written, and rebuilt the same way
+while it's read, so there is no dictionary to store in the file. Each string
+is a varint:
+- a value n > 0 is a reference to the string n-1 of the dictionary of the channel;
+- 0 is a new string, followed by the varint length of the prefix shared with
+  the previous new string of the channel (front coding), the varint size of
+  the rest of the string in UTF-8 and the UTF-8 bytes.
+The strings read from the dictionary are implicitly shared.
+*/
+class StringDictionary
+{
+    StringDictionary(const StringDictionary&) = delete;
+public:
+    StringDictionary();
+    ~StringDictionary();
+
+    void write(QDataStream& out, const QString& str, StringChannel channel);
+    bool read(QDataStream& in, QString& str, StringChannel channel);
+
+    static void writeVarint(QDataStream& out, quint64 value);
+    static bool readVarint(QDataStream& in, quint64& value);
+
+private:
+    struct Channel
+    {
+        QList<QString> strings;
+        QHash<QString, quint32> index;
+        QString previous;
+    };
+
+    void addString(Channel& channel, const QString& str, bool isWriting);
+
+    Channel m_channels[STRING_CHANNEL_COUNT];
+};
+
+#endif // GAMESORTING_STRINGDICTIONARY_H_
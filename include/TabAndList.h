@@ -21,14 +21,21 @@
 
 #include "DataStruct.h"
 #include "SqlUtilityTable.h"
+#include "SaveInterface.h"
+#include "SaveJournal.h"
+#include "AutoSave.h"
 
 #include <QWidget>
 #include <QSqlDatabase>
 #include <QTabBar>
+#include <QHash>
 
 class QTabBar;
+class QTimer;
 class SqlListView;
 class QStackedLayout;
+class AbstractListView;
+class TableModel;
 
 class TabAndList : public QWidget
 {
@@ -38,6 +45,8 @@ public:
     virtual ~TabAndList();
 
     bool maybeSave();
+    // Ask the user to restore the autosaved list if the program was not closed properly.
+    bool restoreAutoSave();
     const QString& filePath() const;
     const QString& currentDirectory() const;
     void setCurrentDit(const QString& dir);
@@ -52,6 +61,8 @@ public slots:
     void open(const QString& filePath);
     void save();
     void saveAs();
+    void exportList();
+    void importItems();
     void openUtility(UtilityTableName tableName);
     void addItem();
     void delItem();
@@ -64,6 +75,8 @@ signals:
     void listChanged(bool isChanged);
     void isAddDelEditVisible(bool value);
     void isCopyPasteEditVisible(bool value);
+    // The model of the current tab, nullptr if the current tab is not showing a list.
+    void currentListChanged(TableModel* model);
 
 private slots:
     void tabChanged(int index);
@@ -73,12 +86,25 @@ private slots:
     void tabAskEdit(int index);
     void tabChangeApplying(int tabIndex, const QString& tabName);
     void listUpdated();
+    void autoSave();
 
 private:
     void newEmptyList();
     void setupView();
-    bool saveFile(const QString& filePath) const;
+    bool saveFile(const QString& filePath);
+    bool appendJournal(const QString& filePath);
+    bool updateMetadata(const QString& filePath) const;
+    SaveInterface::FileMetadataTable pendingTableMetadata(const SaveInterface::FileMetadata& metadata, int tableIndex) const;
     bool openFile(const QString& filePath);
+    bool openSectionedFile(const QString& filePath, const SaveInterface::TableOfContents& toc);
+    bool createList(ListType type);
+    AbstractListView* addListView(const QString& tableName);
+    bool loadTable(AbstractListView* view);
+    bool loadTables(const QList<AbstractListView*>& views);
+    bool insertTable(AbstractListView* view, const SaveInterface::DecodedTable& table);
+    bool loadPendingTables();
+    void closeBaseFile();
+    void discardAutoSave();
 
     QSqlDatabase& m_db;
     ListType m_listType;
@@ -88,6 +114,19 @@ private:
     QString m_filePath;
     QString m_currentDirectory;
     bool m_isListModified;
+
+    // The tables of a sectioned file not loaded yet, with their index in the table of contents.
+    // They are loaded from m_baseFilePath on the first activation of their tab.
+    // The changes saved into the journal of m_baseFilePath are applied when the tables are loaded.
+    SaveInterface::TableOfContents m_tableOfContents;
+    QHash<AbstractListView*, int> m_pendingTables;
+    QString m_baseFilePath;
+    SaveJournal m_journal;
+
+    // Autosave of the list into the recovery file, when the list changed since the last autosave.
+    AutoSave m_autoSave;
+    QTimer* m_autoSaveTimer;
+    bool m_isAutoSaveNeeded;
 };
 
 #endif
\ No newline at end of file
@@ -23,7 +23,9 @@
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QString>
+#include <QStringList>
 #include <QList>
+#include <QHash>
 
 #include "DataStruct.h"
 #include "SqlUtilityTable.h"
@@ -42,6 +44,8 @@
     }
 
 class TableModel_UtilityInterface;
+class ListStatistics;
+class QDataStream;
 
 class TableModel : public QAbstractTableModel
 {
@@ -65,14 +69,37 @@ public:
     virtual long long int itemID(const QModelIndex& index) const = 0;
 
     virtual void updateQuery() = 0;
-    virtual QVariant retrieveData() const = 0;
     virtual bool setItemData(const QVariant& data) = 0;
+    // Insert the items of a SaveDataTable (without the utility interface) into the existing table.
+    virtual bool appendItemData(const QVariant& data) = 0;
+    // Write the table name, the items and the utility interface directly into the stream,
+    // same output than the beginning of the SaveDataTable.
+    virtual bool writeData(QDataStream& out) const = 0;
+    // Write the sorting column and the sorting order, the end of the SaveDataTable.
+    void writeSortingData(QDataStream& out) const;
+    // Number of items in the SQL table, without the filter.
+    long long int itemCount() const;
+    // The SQL tables of the model: the items table and the utility interface tables.
+    QStringList sqlTableNames();
+    // The names of the count best rated items, for the metadata of the file.
+    QStringList topItems(int count) const;
     virtual void setFilter(const ListFilter& filter);
     virtual bool isSortingEnabled() const;
     virtual bool isFilterEnabled() const;
 
     virtual TableModel_UtilityInterface* utilityInterface() = 0;
 
+    // Aggregates of the list kept up to date by the model, created on the first call.
+    ListStatistics* statistics();
+    // The SQL tables were changed without the model (bulk insertion, import), the statistics are computed again.
+    void invalidateStatistics();
+
+    // Bulk edit of the items of the selected rows, in one transaction with set-based statements.
+    // The edited rows are refreshed at once, with a single dataChanged.
+    bool bulkSetRate(const QModelIndexList& indexList, int rate);
+    bool bulkEditUtilities(const QModelIndexList& indexList, UtilityTableName tableName, const QList<long long int>& utilitiesID, BulkEditMode mode);
+    bool bulkSetSensitiveContent(const QModelIndexList& indexList, const SensitiveContent& sensitiveContent);
+
 signals:
     void listEdited();
     void tableNameChanged(const QString& tableName);
@@ -83,6 +110,11 @@ protected:
     virtual void createTable() = 0;
     virtual void deleteTable() = 0;
     virtual void utilityChanged(long long int itemID, UtilityTableName tableName) = 0;
+    // Apply a bulk edit to the rows (in ascending order) of the model, then emit one dataChanged for the range of rows.
+    // utilityNames contain the utilities of each item joined by a comma, the items without utilities are not in it.
+    virtual void setRowsRate(const QList<int>& rows, int rate) = 0;
+    virtual void setRowsUtility(const QList<int>& rows, UtilityTableName tableName, const QHash<long long int, QString>& utilityNames) = 0;
+    virtual void setRowsSensitiveContent(const QList<int>& rows, const SensitiveContent& sensitiveContent) = 0;
     QString checkingIfNameFree(const QString& name, int n = -1) const;
 
     QSqlDatabase& m_db;
@@ -93,6 +125,12 @@ protected:
     ListFilter m_listFilter;
     int m_sortingColumnID;
     Qt::SortOrder m_sortingOrder;
+    ListStatistics* m_statistics;
+
+private:
+    QList<int> selectedRows(const QModelIndexList& indexList) const;
+    QString itemIDList(const QList<int>& rows) const;
+    bool execBulkStatements(const QStringList& statements);
 };
 
 #endif // GAMESORTING_TABLEMODEL_H_
\ No newline at end of file
@@ -34,7 +34,6 @@ public:
     virtual void rowRemoved(const QList<long long int>& booksIDs) override;
     virtual void updateItemUtility(long long int booksID, UtilityTableName tableName, const QVariant& data) override;
     virtual ListType listType() const override;
-    virtual QVariant data() const;
 
 protected:
     virtual bool setData(const QVariant& data) override;
@@ -51,8 +51,11 @@ public:
     virtual long long int itemID(const QModelIndex& index) const override;
 
     virtual void updateQuery() override;
-    virtual QVariant retrieveData() const override;
     virtual bool setItemData(const QVariant& data) override;
+    virtual bool appendItemData(const QVariant& data) override;
+    virtual bool writeData(QDataStream& out) const override;
+    // Write a table of the database db into the stream, same output than writeData.
+    static bool writeTable(QDataStream& out, QSqlDatabase& db, const QString& tableName, const QStringList& interfaceTableNames);
 
     QString url(const QModelIndex& index) const;
     void setUrl(const QModelIndex& index, const QString& url);
@@ -69,6 +72,9 @@ protected:
     virtual void createTable() override;
     virtual void deleteTable() override;
     virtual void utilityChanged(long long int itemID, UtilityTableName tableName) override;
+    virtual void setRowsRate(const QList<int>& rows, int rate) override;
+    virtual void setRowsUtility(const QList<int>& rows, UtilityTableName tableName, const QHash<long long int, QString>& utilityNames) override;
+    virtual void setRowsSensitiveContent(const QList<int>& rows, const SensitiveContent& sensitiveContent) override;
 
 private:
     template<typename T>
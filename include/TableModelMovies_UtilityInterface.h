@@ -31,7 +31,6 @@ public:
     virtual void rowRemoved(const QList<long long int>& moviesID) override;
     virtual void updateItemUtility(long long int movieID, UtilityTableName tableName, const QVariant& data) override;
     virtual ListType listType() const override;
-    virtual QVariant data() const override;
 
 protected:
     virtual bool setData(const QVariant& data) override;
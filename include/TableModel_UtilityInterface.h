@@ -25,8 +25,11 @@
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QString>
+#include <QStringList>
 #include <QVariant>
 
+class QDataStream;
+
 class TableModel_UtilityInterface : public QObject
 {
 	Q_OBJECT
@@ -41,7 +44,15 @@ public:
 	virtual void updateItemUtility(long long int itemID, UtilityTableName tableName, const QVariant& data) = 0;
 	virtual ListType listType() const = 0;
 
-	virtual QVariant data() const = 0;
+	// The SQL tables of the utility interface, in the order they are written into the file.
+	QStringList tableNames() const;
+	// Write the utility interface directly into the stream, same output than the SaveUtilityInterfaceData.
+	virtual bool writeData(QDataStream& out) const;
+	// Write the utility interface tables of the database db into the stream, same output than writeData.
+	static bool writeTables(QDataStream& out, QSqlDatabase& db, const QStringList& tableNames);
+	// Insert rows into an utility interface table or the sensitive content table, used by the streaming open.
+	bool appendData(UtilityTableName tableName, const QList<Game::SaveUtilityInterfaceItem>& items);
+	bool appendSensitiveContent(const QList<Game::SaveUtilitySensitiveContentItem>& items);
 
 signals:
 	void interfaceChanged(long long int itemID, UtilityTableName tableName);
@@ -21,6 +21,8 @@
 
 #include <QAbstractListModel>
 #include <QList>
+#include <QHash>
+#include <QSet>
 #include <QSqlQuery>
 #include <QSqlDatabase>
 
@@ -66,6 +68,8 @@ public:
     void applyChange();
     // Return the selected utilities.
     QList<long long int> getSelectedUtilities() const;
+    // Show next to the name of each utility the number of items linked to it.
+    void setItemCounts(const QHash<long long int, int>& itemCounts);
 
 signals:
     void utilitiesUpdated(const QString& utilityList);
@@ -76,6 +80,9 @@ private slots:
 private:
     void retrieveSelectedUtilitiesOnItem();
     void retrieveUtilityData();
+    // Fill m_utilityListData with the utilities matching the filter, sorted if the sorting is enabled.
+    void filterAndSortData();
+    void updateRows();
     bool isUtilityIDChecked(long long int utilityID) const;
     void removeCheckedUtilityID(long long int utilityID);
 
@@ -94,8 +101,14 @@ private:
     QString m_strFilter;
 
     // Data
+    // All the utilities of the table, and the utilities shown (filtered and sorted).
+    QList<ItemUtilityData> m_allUtilityData;
     QList<ItemUtilityData> m_utilityListData;
+    QHash<long long int, QString> m_utilityNames;
+    // The checked utilities in the order they were checked, and the same IDs for the lookups.
     QList<long long int> m_checkedIDList;
+    QSet<long long int> m_checkedIDs;
+    QHash<long long int, int> m_itemCounts;
 };
 
 #endif
\ No newline at end of file
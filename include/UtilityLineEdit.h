@@ -25,6 +25,11 @@
 #include <QLineEdit>
 #include <QSqlDatabase>
 
+// Maximum number of names shown by the completion popup.
+#define UTILITY_COMPLETION_MAX_MATCHES 50
+
+class QStringListModel;
+
 class UtilityLineEdit : public QLineEdit
 {
     Q_OBJECT
@@ -44,11 +49,14 @@ private slots:
 
 private:
     void createCompleter();
+    void updateMatches(const QString& pattern);
 
     UtilityTableName m_tableName;
     SqlUtilityTable& m_utilityTable;
     QSqlDatabase& m_db;
     QCompleter* m_completer;
+    // The names matching the text being typed, the best match first.
+    QStringListModel* m_matches;
 };
 
 #endif // GAMESORTING_UTILITYLINEEDIT_H_
\ No newline at end of file
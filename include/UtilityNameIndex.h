@@ -0,0 +1,76 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GAMESORTING_UTILITYNAMEINDEX_H_
+#define GAMESORTING_UTILITYNAMEINDEX_H_
+
+#include <QString>
+#include <QList>
+#include <QHash>
+
+// Minimum trigram similarity (shared trigrams / all trigrams) of a fuzzy match.
+#define UTILITY_NAME_MIN_SIMILARITY 0.2
+
+/*
+In memory trigram index of the names of an utility table, used for the fuzzy search.
+The names are compared without the case, the diacritics and the extra spaces.
+A name match if it contain the pattern, or if it share enough trigrams with it,
+which tolerate the typos and the different spellings.
+*/
+class UtilityNameIndex
+{
+public:
+    UtilityNameIndex();
+    ~UtilityNameIndex();
+
+    void clear();
+    void insert(long long int utilityID, const QString& name);
+    void remove(long long int utilityID);
+    void rename(long long int utilityID, const QString& name);
+    bool contains(long long int utilityID) const;
+    QString name(long long int utilityID) const;
+    int size() const;
+
+    // The ID of the utilities matching the pattern, the best match first.
+    // If maxResults is positive, only the maxResults best matches are returned.
+    QList<long long int> search(const QString& pattern, int maxResults = -1) const;
+
+    // The name without the case, the diacritics and the extra spaces.
+    static QString normalize(const QString& name);
+
+private:
+    struct Entry
+    {
+        long long int utilityID;
+        QString name;
+        QString normalized;
+        int trigramCount;
+    };
+
+    static QList<quint64> trigrams(const QString& normalized);
+    static double score(const Entry& entry, const QString& pattern, int sharedTrigrams, int patternTrigrams);
+
+    // The entries are never moved, the slot of a removed entry is reused.
+    QList<Entry> m_entries;
+    QList<int> m_freeSlots;
+    QHash<long long int, int> m_slots;
+    // The slots of the entries having each trigram.
+    QHash<quint64, QList<int>> m_postings;
+};
+
+#endif // GAMESORTING_UTILITYNAMEINDEX_H_
@@ -17,10 +17,52 @@
 */
 
 #include "AbstractListView.h"
+#include "Settings.h"
+#include "StarEditor.h"
+#include <QTableView>
+#include <QHeaderView>
+#include <QtMath>
 
 AbstractListView::AbstractListView(QWidget* parent) :
     QWidget(parent)
 {}
 
 AbstractListView::~AbstractListView()
-{}
\ No newline at end of file
+{}
+
+bool AbstractListView::writeListData(QDataStream& out) const
+{
+    return false;
+}
+
+TableModel* AbstractListView::tableModel() const
+{
+    return nullptr;
+}
+
+void AbstractListView::setColumnsSizeAndSortingOrder(const QVariant& data)
+{}
+
+bool AbstractListView::writeViewSettings(QDataStream& out) const
+{
+    return false;
+}
+
+bool AbstractListView::readViewSettings(QDataStream& in)
+{
+    return false;
+}
+
+void AbstractListView::setupViewMetrics(QTableView* view)
+{
+    if (!Settings::instance().isFixedMetrics())
+        return;
+
+    // The rows are never resized to their contents, the height only need to fit the stars.
+    QHeaderView* verticalHeader = view->verticalHeader();
+    verticalHeader->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader->setDefaultSectionSize(qMax(verticalHeader->defaultSectionSize(), qCeil(StarEditor::paintFactor()) + 2));
+
+    // Fitting a column to its contents (double click on the header) only ask the size hint of a sample of the rows.
+    view->horizontalHeader()->setResizeContentsPrecision(LIST_VIEW_METRICS_SAMPLE_ROWS);
+}
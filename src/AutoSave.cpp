@@ -0,0 +1,212 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AutoSave.h"
+#include "SaveInterface.h"
+#include "SqlUtilityTable.h"
+#include "TableModel_UtilityInterface.h"
+#include "TableModelGame.h"
+#include "TableModelMovies.h"
+#include "TableModelCommon.h"
+#include "TableModelBooks.h"
+#include "TableModelSeries.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <iostream>
+
+#define AUTOSAVE_CONNECTION_NAME "GameSortingAutoSave"
+
+AutoSave::AutoSave(QSqlDatabase& db, QObject* parent) :
+    QObject(parent),
+    m_db(db)
+{}
+
+AutoSave::~AutoSave()
+{
+    // The worker thread use the snapshot file, it must end before the program.
+    m_watcher.waitForFinished();
+}
+
+QString AutoSave::recoveryDirectory()
+{
+#ifdef NDEBUG
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("recovery");
+#else
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("recovery_debug");
+#endif
+}
+
+QString AutoSave::recoveryFilePath()
+{
+    return QDir(recoveryDirectory()).filePath("autosave.list");
+}
+
+QString AutoSave::snapshotFilePath()
+{
+    return QDir(recoveryDirectory()).filePath("snapshot.sqlite");
+}
+
+QString AutoSave::listFilePathFile()
+{
+    return QDir(recoveryDirectory()).filePath("autosave.path");
+}
+
+bool AutoSave::hasRecovery()
+{
+    return QFile::exists(recoveryFilePath());
+}
+
+QString AutoSave::recoveryListFilePath()
+{
+    QFile file(listFilePathFile());
+    if (!file.open(QIODevice::ReadOnly))
+        return QString();
+    return QString::fromUtf8(file.readAll());
+}
+
+bool AutoSave::isRunning() const
+{
+    return m_watcher.isRunning();
+}
+
+bool AutoSave::save(ListType type, const QString& filePath, const QList<TableSnapshot>& tables)
+{
+    // Only one autosave at a time.
+    if (isRunning() || !QDir().mkpath(recoveryDirectory()))
+        return false;
+
+    // Copying the database into the snapshot file, SQLite rebuild the tables row by row into a new database
+    // without going through Qt, it's faster than reading the rows here. The snapshot must not exist.
+    QString snapshotPath = snapshotFilePath();
+    QFile::remove(snapshotPath);
+
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("VACUUM INTO '%1';").arg(QString(snapshotPath).replace('\'', "''"))))
+    {
+#ifndef NDEBUG
+        std::cerr << QString("Failed to take a snapshot of the database.\n\t%1")
+            .arg(query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+#endif
+        return false;
+    }
+
+    // Writing the recovery file from the snapshot on a worker thread.
+    m_watcher.setFuture(QtConcurrent::run(&AutoSave::writeRecovery, type, filePath, tables));
+    return true;
+}
+
+void AutoSave::discard()
+{
+    // The list is saved or closed, the recovery file is not needed anymore.
+    m_watcher.waitForFinished();
+    QFile::remove(recoveryFilePath());
+    QFile::remove(listFilePathFile());
+    QFile::remove(snapshotFilePath());
+}
+
+// Write a table of the snapshot, the first SQL table is the items table, the others are the utility interface.
+static bool writeSnapshotTable(QDataStream& out, QSqlDatabase& db, ListType type, const QStringList& sqlTableNames)
+{
+    if (sqlTableNames.size() < 2)
+        return false;
+
+    const QString& tableName = sqlTableNames.first();
+    const QStringList interfaceTableNames = sqlTableNames.mid(1);
+    switch (type)
+    {
+    case ListType::GAMELIST:
+        return TableModelGame::writeTable(out, db, tableName, interfaceTableNames);
+    case ListType::MOVIESLIST:
+        return TableModelMovies::writeTable(out, db, tableName, interfaceTableNames);
+    case ListType::COMMONLIST:
+        return TableModelCommon::writeTable(out, db, tableName, interfaceTableNames);
+    case ListType::BOOKSLIST:
+        return TableModelBooks::writeTable(out, db, tableName, interfaceTableNames);
+    case ListType::SERIESLIST:
+        return TableModelSeries::writeTable(out, db, tableName, interfaceTableNames);
+    default:
+        return false;
+    }
+}
+
+bool AutoSave::writeRecovery(ListType type, const QString& filePath, const QList<TableSnapshot>& tables)
+{
+    // Called on a worker thread, the snapshot is opened with a connection of this thread.
+    bool result = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", AUTOSAVE_CONNECTION_NAME);
+        db.setDatabaseName(snapshotFilePath());
+        if (db.open())
+        {
+            QList<SaveInterface::SaveTableSection> sections;
+            for (const TableSnapshot& table : tables)
+            {
+                // A table not loaded yet is copied from the list file, without being decoded.
+                if (!table.sourceFilePath.isEmpty())
+                {
+                    sections.append({table.sourceSection.tableName, table.rowCount, nullptr,
+                        table.topItems, table.sourceFilePath, table.sourceSection});
+                    continue;
+                }
+                if (table.sqlTableNames.isEmpty())
+                    continue;
+
+                sections.append({table.sqlTableNames.first(), table.rowCount,
+                    [&db, type, &table](QDataStream& out) -> bool
+                    {
+                        // The settings of the view are already serialized.
+                        if (!writeSnapshotTable(out, db, type, table.sqlTableNames))
+                            return false;
+                        out.writeRawData(table.viewSettings.constData(), table.viewSettings.size());
+                        return out.status() == QDataStream::Ok;
+                    },
+                    table.topItems});
+            }
+
+            result = SaveInterface::save(recoveryFilePath(), type, sections,
+                [&db, type](QDataStream& out) -> bool
+                {
+                    return SqlUtilityTable::writeTables(out, db, type);
+                });
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(AUTOSAVE_CONNECTION_NAME);
+    QFile::remove(snapshotFilePath());
+
+    // The file of the list, it's used when the recovery file is restored.
+    if (result)
+    {
+        QSaveFile file(listFilePathFile());
+        result = file.open(QIODevice::WriteOnly) &&
+            file.write(filePath.toUtf8()) == filePath.toUtf8().size() &&
+            file.commit();
+    }
+
+    return result;
+}
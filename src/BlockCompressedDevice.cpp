@@ -0,0 +1,313 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlockCompressedDevice.h"
+
+#include <QDataStream>
+#include <QBuffer>
+#include <QThread>
+#include <QtEndian>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <cstring>
+
+static QByteArray uncompressBlock(const QByteArray& block)
+{
+    return qUncompress(block);
+}
+
+quint32 blockChecksum(const char* data, qint64 size, quint32 crc)
+{
+    // Table driven CRC-32 (polynomial 0xEDB88320), the same than zlib.
+    static const QList<quint32> table = []()
+    {
+        QList<quint32> table(256);
+        for (quint32 i = 0; i < 256; i++)
+        {
+            quint32 c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }();
+
+    crc = ~crc;
+    for (qint64 i = 0; i < size; i++)
+        crc = table.at((crc ^ (quint8)data[i]) & 0xFF) ^ (crc >> 8);
+    return ~crc;
+}
+
+BlockCompressedWriter::BlockCompressedWriter(QIODevice* device, qint64 baseOffset) :
+    QIODevice(),
+    m_device(device),
+    m_baseOffset(baseOffset),
+    m_checksum(0),
+    m_isFailed(false)
+{}
+
+BlockCompressedWriter::~BlockCompressedWriter()
+{}
+
+bool BlockCompressedWriter::isSequential() const
+{
+    return true;
+}
+
+bool BlockCompressedWriter::finish()
+{
+    // Writing the last block, then the index of the blocks.
+    if (m_isFailed || !m_device)
+        return false;
+
+    if (!m_buffer.isEmpty())
+    {
+        if (!writeBlock(m_buffer))
+            return false;
+        m_buffer.clear();
+    }
+
+    qint64 indexOffset = m_device->pos() - m_baseOffset;
+    QByteArray index;
+    QDataStream out(&index, QIODevice::WriteOnly);
+    int blockCount = m_blocks.size();
+    out << blockCount;
+    for (const CompressedBlockInfo& info : m_blocks)
+    {
+        out << info.offset;
+        out << info.compressedSize;
+        out << info.uncompressedSize;
+    }
+    out << indexOffset;
+
+    if (m_device->write(index) != index.size())
+        return false;
+    m_checksum = blockChecksum(index.constData(), index.size(), m_checksum);
+    return true;
+}
+
+quint32 BlockCompressedWriter::checksum() const
+{
+    return m_checksum;
+}
+
+qint64 BlockCompressedWriter::readData(char* data, qint64 maxSize)
+{
+    return -1;
+}
+
+qint64 BlockCompressedWriter::writeData(const char* data, qint64 maxSize)
+{
+    // The data is buffered until a whole block can be compressed.
+    if (m_isFailed || !m_device)
+        return -1;
+
+    m_buffer.append(data, maxSize);
+    while (m_buffer.size() >= COMPRESSED_BLOCK_SIZE)
+    {
+        if (!writeBlock(m_buffer.left(COMPRESSED_BLOCK_SIZE)))
+        {
+            m_isFailed = true;
+            return -1;
+        }
+        m_buffer.remove(0, COMPRESSED_BLOCK_SIZE);
+    }
+
+    return maxSize;
+}
+
+bool BlockCompressedWriter::writeBlock(const QByteArray& block)
+{
+    // Compressing a block and writing it into the device.
+    CompressedBlockInfo info = {};
+    info.offset = m_device->pos() - m_baseOffset;
+    QByteArray compressed = qCompress(block);
+    info.compressedSize = compressed.size();
+    info.uncompressedSize = block.size();
+
+    if (m_device->write(compressed) != compressed.size())
+        return false;
+
+    m_checksum = blockChecksum(compressed.constData(), compressed.size(), m_checksum);
+    m_blocks.append(info);
+    return true;
+}
+
+BlockCompressedReader::BlockCompressedReader(QIODevice* device) :
+    QIODevice(),
+    m_device(device),
+    m_payloadOffset(device ? device->pos() : 0),
+    m_memory(nullptr),
+    m_nextBlock(0),
+    m_blockPos(0),
+    m_remainingSize(0)
+{}
+
+BlockCompressedReader::~BlockCompressedReader()
+{}
+
+bool BlockCompressedReader::open(OpenMode mode)
+{
+    // The reader is read only, the index is read before anything else.
+    if ((mode & QIODevice::WriteOnly) || !m_device || !readIndex())
+        return false;
+
+    // If the device is a buffer, the blocks are read directly from its memory.
+    const QBuffer* buffer = qobject_cast<const QBuffer*>(m_device);
+    if (buffer && buffer->data().size() == m_device->size())
+        m_memory = buffer->data().constData();
+
+    return QIODevice::open(mode);
+}
+
+bool BlockCompressedReader::isSequential() const
+{
+    return true;
+}
+
+qint64 BlockCompressedReader::bytesAvailable() const
+{
+    return m_remainingSize + QIODevice::bytesAvailable();
+}
+
+qint64 BlockCompressedReader::readData(char* data, qint64 maxSize)
+{
+    // Copying the decompressed blocks into data, the next blocks are decompressed when needed.
+    qint64 readSize = 0;
+    while (readSize < maxSize)
+    {
+        if (m_decompressedBlocks.isEmpty())
+        {
+            if (m_nextBlock >= m_blocks.size())
+                break;
+            if (!decompressNextBlocks())
+                return readSize > 0 ? readSize : -1;
+        }
+
+        const QByteArray& block = m_decompressedBlocks.first();
+        qint64 size = qMin(maxSize - readSize, block.size() - m_blockPos);
+        std::memcpy(data + readSize, block.constData() + m_blockPos, size);
+        readSize += size;
+        m_blockPos += size;
+        m_remainingSize -= size;
+
+        if (m_blockPos == block.size())
+        {
+            m_decompressedBlocks.removeFirst();
+            m_blockPos = 0;
+        }
+    }
+
+    return readSize;
+}
+
+qint64 BlockCompressedReader::writeData(const char* data, qint64 maxSize)
+{
+    return -1;
+}
+
+bool BlockCompressedReader::readIndex()
+{
+    // The offset of the index is stored at the end of the file.
+    qint64 fileSize = m_device->size();
+    if (fileSize - m_payloadOffset < (qint64)(sizeof(int) + sizeof(qint64)))
+        return false;
+
+    QDataStream in(m_device);
+    qint64 indexOffset;
+    if (!m_device->seek(fileSize - (qint64)sizeof(qint64)))
+        return false;
+    in >> indexOffset;
+    if (in.status() != QDataStream::Ok ||
+        indexOffset < m_payloadOffset ||
+        indexOffset > fileSize - (qint64)(sizeof(int) + sizeof(qint64)))
+        return false;
+
+    // Reading the index and checking that each block is inside the payload.
+    int blockCount;
+    if (!m_device->seek(indexOffset))
+        return false;
+    in >> blockCount;
+    qint64 indexSize = fileSize - (qint64)sizeof(qint64) - indexOffset - (qint64)sizeof(int);
+    if (in.status() != QDataStream::Ok || blockCount < 0 ||
+        (qint64)blockCount * (qint64)(sizeof(qint64) + 2 * sizeof(int)) != indexSize)
+        return false;
+
+    m_blocks.reserve(blockCount);
+    m_remainingSize = 0;
+    for (int i = 0; i < blockCount; i++)
+    {
+        CompressedBlockInfo info = {};
+        in >> info.offset;
+        in >> info.compressedSize;
+        in >> info.uncompressedSize;
+        if (in.status() != QDataStream::Ok ||
+            info.offset < m_payloadOffset ||
+            info.compressedSize <= (int)sizeof(quint32) ||
+            info.offset + info.compressedSize > indexOffset ||
+            info.uncompressedSize <= 0 ||
+            info.uncompressedSize > COMPRESSED_BLOCK_MAX_SIZE)
+            return false;
+        m_blocks.append(info);
+        m_remainingSize += info.uncompressedSize;
+    }
+
+    return true;
+}
+
+bool BlockCompressedReader::decompressNextBlocks()
+{
+    // Reading as much blocks as there are threads and decompressing them in parallel.
+    int count = qMin(qMax(QThread::idealThreadCount(), 1), (int)(m_blocks.size() - m_nextBlock));
+    QList<QByteArray> compressedBlocks;
+    compressedBlocks.reserve(count);
+    for (int i = m_nextBlock; i < m_nextBlock + count; i++)
+    {
+        const CompressedBlockInfo& info = m_blocks.at(i);
+        QByteArray block;
+        if (m_memory)
+        {
+            // The device is in memory (a mapped file), the block is used in place without copy.
+            // The index has already checked that the block is inside the data.
+            block = QByteArray::fromRawData(m_memory + info.offset, info.compressedSize);
+        }
+        else
+        {
+            if (!m_device->seek(info.offset))
+                return false;
+            block = m_device->read(info.compressedSize);
+        }
+        // The first four bytes of a qCompress block are the uncompressed size,
+        // it must match the index before letting qUncompress allocating it.
+        if (block.size() != info.compressedSize ||
+            qFromBigEndian<quint32>(block.constData()) != (quint32)info.uncompressedSize)
+            return false;
+        compressedBlocks.append(block);
+    }
+
+    QList<QByteArray> blocks = QtConcurrent::blockingMapped<QList<QByteArray>>(compressedBlocks, uncompressBlock);
+    for (int i = 0; i < blocks.size(); i++)
+    {
+        if (blocks.at(i).size() != m_blocks.at(m_nextBlock + i).uncompressedSize)
+            return false;
+    }
+
+    m_nextBlock += count;
+    m_decompressedBlocks.append(blocks);
+    return true;
+}
@@ -18,9 +18,13 @@
 
 #include "BooksListView.h"
 #include "TableModelBooks.h"
+#include "SaveInterface.h"
 #include "FilterDialog.h"
+#include "BulkEditDialog.h"
 #include "ListViewDelegate.h"
+#include "QuickFilter.h"
 #include <QTableView>
+#include <QDataStream>
 #include <QHeaderView>
 #include <QItemSelectionModel>
 #include <QSqlQuery>
@@ -91,6 +95,7 @@ void BooksListView::setupWidget()
     m_view->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
     m_view->setSortingEnabled(true);
     m_view->verticalHeader()->hide();
+    setupViewMetrics(m_view);
 
     // Setting custom item delegate ListViewDelegate.
     QAbstractItemDelegate* oldDelegate = m_view->itemDelegate();
@@ -224,6 +229,16 @@ void BooksListView::createMenu(QVBoxLayout* vLayout)
         connect(filterAct, &QAction::triggered, this, &BooksListView::filter);
         toolBar->addAction(filterAct);
 
+        QIcon bulkEditIcon(":/Images/Utility.svg");
+        QAction* bulkEditAct = new QAction(bulkEditIcon, tr("Bulk edit"), this);
+        bulkEditAct->setToolTip(tr("Editing the rate, the sensitive content or the utilities of the selected items."));
+        connect(bulkEditAct, &QAction::triggered, this, &BooksListView::bulkEdit);
+        toolBar->addAction(bulkEditAct);
+
+        // Search as you type on the names of the list.
+        toolBar->addSeparator();
+        toolBar->addWidget(new QuickFilter(m_view, m_model, Books::NAME, this));
+
         vLayout->setMenuBar(toolBar);
     }
 }
@@ -238,31 +253,54 @@ void BooksListView::deletingItems()
     }
 }
 
-QVariant BooksListView::listData() const
+Books::ColumnsSize BooksListView::columnsSize() const
 {
-    // Return the data inside the model.
-    if (m_model)
-    {
-        // Retrive the data of the model
-        QVariant variant = m_model->retrieveData();
-        // If the list is a books list.
-        if (variant.canConvert<Books::SaveDataTable>() && m_view)
-        {
-            // Retrieve the size of the column.
-            Books::SaveDataTable data = qvariant_cast<Books::SaveDataTable>(variant);
-            data.viewColumnsSize.name = m_view->columnWidth(Books::NAME);
-            data.viewColumnsSize.series = m_view->columnWidth(Books::SERIES);
-            data.viewColumnsSize.categories = m_view->columnWidth(Books::CATEGORIES);
-            data.viewColumnsSize.authors = m_view->columnWidth(Books::AUTHORS);
-            data.viewColumnsSize.publishers = m_view->columnWidth(Books::PUBLISHERS);
-            data.viewColumnsSize.services = m_view->columnWidth(Books::SERVICES);
-            data.viewColumnsSize.sensitiveContent = m_view->columnWidth(Books::SENSITIVE_CONTENT);
-            data.viewColumnsSize.rate = m_view->columnWidth(Books::RATE);
-            return QVariant::fromValue(data);
-        }
-    }
+    // Retrieve the size of the columns of the view.
+    Books::ColumnsSize columnsSize = {};
+    columnsSize.name = m_view->columnWidth(Books::NAME);
+    columnsSize.series = m_view->columnWidth(Books::SERIES);
+    columnsSize.categories = m_view->columnWidth(Books::CATEGORIES);
+    columnsSize.authors = m_view->columnWidth(Books::AUTHORS);
+    columnsSize.publishers = m_view->columnWidth(Books::PUBLISHERS);
+    columnsSize.services = m_view->columnWidth(Books::SERVICES);
+    columnsSize.sensitiveContent = m_view->columnWidth(Books::SENSITIVE_CONTENT);
+    columnsSize.rate = m_view->columnWidth(Books::RATE);
+    return columnsSize;
+}
+
+bool BooksListView::writeListData(QDataStream& out) const
+{
+    // Streaming the list into the data stream, without building the SaveDataTable.
+    if (!m_model || !m_view)
+        return false;
 
-    return QVariant();
+    if (!m_model->writeData(out))
+        return false;
+    return writeViewSettings(out);
+}
+
+bool BooksListView::writeViewSettings(QDataStream& out) const
+{
+    if (!m_model || !m_view)
+        return false;
+
+    out << columnsSize();
+    m_model->writeSortingData(out);
+    return true;
+}
+
+bool BooksListView::readViewSettings(QDataStream& in)
+{
+    // Reading the end of a Books::SaveDataTable and applying it to the view.
+    Books::SaveDataTable data = {};
+    in >> data.viewColumnsSize;
+    in >> data.columnSort;
+    in >> data.sortOrder;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    setColumnsSizeAndSortingOrder(QVariant::fromValue(data));
+    return true;
 }
 
 ListType BooksListView::listType() const
@@ -292,6 +330,11 @@ void BooksListView::setColumnsSizeAndSortingOrder(const QVariant& variant)
     }
 }
 
+TableModel* BooksListView::tableModel() const
+{
+    return m_model;
+}
+
 ViewType BooksListView::viewType() const
 {
     return ViewType::BOOKS;
@@ -420,6 +463,25 @@ void BooksListView::filter()
     filterDialog.exec();
 }
 
+void BooksListView::bulkEdit()
+{
+    // Opening the bulk edit dialog on the selected items.
+    QModelIndexList indexList = m_view->selectionModel()->selectedRows(0);
+    if (indexList.isEmpty())
+    {
+        QMessageBox::warning(
+            this,
+            tr("Bulk edit"),
+            tr("No items are selected."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
+
+    BulkEditDialog bulkEditDialog(m_model, indexList, m_utilityTable, m_db, this);
+    bulkEditDialog.exec();
+}
+
 void BooksListView::enableAction(QAction* action) const
 {
     if (m_model->isSortingEnabled() || m_model->isFilterEnabled())
@@ -0,0 +1,239 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BulkEditDialog.h"
+#include "TableModel.h"
+#include "UtilityInterfaceEditorModel.h"
+#include "StarWidget.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QStackedLayout>
+#include <QComboBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QLineEdit>
+#include <QTableView>
+#include <QHeaderView>
+#include <QMessageBox>
+
+#define BULK_EDIT_RATE_PAGE 0
+#define BULK_EDIT_SENSITIVE_CONTENT_PAGE 1
+#define BULK_EDIT_UTILITY_PAGE 2
+
+BulkEditDialog::BulkEditDialog(
+    TableModel* model,
+    const QModelIndexList& indexList,
+    SqlUtilityTable& utility,
+    QSqlDatabase& db,
+    QWidget* parent) :
+    QDialog(parent),
+    m_model(model),
+    m_indexList(indexList),
+    m_utility(utility),
+    m_db(db),
+    m_utilityTables(SqlUtilityTable::utilityTables(model->listType())),
+    m_stackedLayout(nullptr),
+    m_rateWidget(new StarWidget(this)),
+    m_explicitWidget(new StarWidget(this)),
+    m_violenceWidget(new StarWidget(this)),
+    m_badLanguageWidget(new StarWidget(this)),
+    m_modeComboBox(new QComboBox(this)),
+    m_searchLine(new QLineEdit(this)),
+    m_utilityVLayout(nullptr),
+    m_utilityTableName(UtilityTableName::CATEGORIES),
+    m_utilityModel(nullptr),
+    m_utilityView(nullptr)
+{
+    resize(480, 380);
+    setWindowTitle(tr("Bulk edit"));
+    createWidget();
+}
+
+BulkEditDialog::~BulkEditDialog()
+{}
+
+void BulkEditDialog::createWidget()
+{
+    // Create the widgets inside the Dialog.
+    QVBoxLayout* vLayout = new QVBoxLayout(this);
+
+    QLabel* selectionLabel = new QLabel(tr("%1 selected items.").arg(m_indexList.size()), this);
+    vLayout->addWidget(selectionLabel);
+
+    // The field edited: the rate, the sensitive content or one of the utility tables.
+    QComboBox* fieldComboBox = new QComboBox(this);
+    fieldComboBox->setEditable(false);
+    fieldComboBox->addItem(tr("Rate"));
+    fieldComboBox->addItem(tr("Sensitive content"));
+    for (UtilityTableName tName : m_utilityTables)
+        fieldComboBox->addItem(SqlUtilityTable::tableName(tName));
+    vLayout->addWidget(fieldComboBox);
+
+    m_stackedLayout = new QStackedLayout();
+    m_stackedLayout->setContentsMargins(0, 0, 0, 0);
+
+    // Rate
+    QWidget* rateBaseWidget = new QWidget(this);
+    QHBoxLayout* rateBaseWidgetLayout = new QHBoxLayout(rateBaseWidget);
+    rateBaseWidgetLayout->setContentsMargins(0, 0, 0, 0);
+    rateBaseWidgetLayout->addStretch(1);
+    rateBaseWidgetLayout->addWidget(new QLabel(tr("Rate:"), rateBaseWidget), 0);
+    rateBaseWidgetLayout->addWidget(m_rateWidget, 0);
+    rateBaseWidgetLayout->addStretch(1);
+    m_stackedLayout->addWidget(rateBaseWidget);
+
+    // Sensitive content
+    QWidget* sensitiveBaseWidget = new QWidget(this);
+    QFormLayout* sensitiveLayout = new QFormLayout(sensitiveBaseWidget);
+    sensitiveLayout->setContentsMargins(0, 0, 0, 0);
+    sensitiveLayout->addRow(tr("Explicit Content:"), m_explicitWidget);
+    sensitiveLayout->addRow(tr("Violence Content:"), m_violenceWidget);
+    sensitiveLayout->addRow(tr("Bad Language Content:"), m_badLanguageWidget);
+    m_stackedLayout->addWidget(sensitiveBaseWidget);
+
+    // Utilities
+    QWidget* utilitiesBaseWidget = new QWidget(this);
+    m_utilityVLayout = new QVBoxLayout(utilitiesBaseWidget);
+    m_utilityVLayout->setContentsMargins(0, 0, 0, 0);
+
+    m_modeComboBox->addItem(tr("Add the checked utilities"), (int)BulkEditMode::ADD);
+    m_modeComboBox->addItem(tr("Remove the checked utilities"), (int)BulkEditMode::REMOVE);
+    m_modeComboBox->addItem(tr("Replace by the checked utilities"), (int)BulkEditMode::REPLACE);
+    m_utilityVLayout->addWidget(m_modeComboBox, 0);
+
+    QHBoxLayout* searchLayout = new QHBoxLayout();
+    searchLayout->setContentsMargins(0, 0, 0, 0);
+    searchLayout->addWidget(new QLabel(tr("Search:"), utilitiesBaseWidget), 0);
+    searchLayout->addWidget(m_searchLine, 1);
+    m_utilityVLayout->addLayout(searchLayout, 0);
+    connect(m_searchLine, &QLineEdit::textChanged, [this](const QString& pattern)
+        {
+            if (this->m_utilityModel)
+                this->m_utilityModel->setFilter(pattern);
+        });
+
+    m_stackedLayout->addWidget(utilitiesBaseWidget);
+    vLayout->addLayout(m_stackedLayout, 1);
+
+    // Apply and Cancel button
+    QHBoxLayout* hLayout = new QHBoxLayout();
+    hLayout->setContentsMargins(0, 0, 0, 0);
+    QPushButton* cancelButton = new QPushButton(tr("Cancel"), this);
+    QPushButton* applyButton = new QPushButton(tr("Apply"), this);
+    hLayout->addStretch(1);
+    hLayout->addWidget(cancelButton, 0);
+    hLayout->addWidget(applyButton, 0);
+    vLayout->addLayout(hLayout);
+    applyButton->setDefault(true);
+
+    connect(fieldComboBox, &QComboBox::currentIndexChanged, this, &BulkEditDialog::fieldChanged);
+    connect(applyButton, &QPushButton::clicked, this, &BulkEditDialog::applyEdit);
+    connect(cancelButton, &QPushButton::clicked, this, &BulkEditDialog::reject);
+}
+
+void BulkEditDialog::fieldChanged(int index)
+{
+    // Change the page of the stacked layout, the list of the utilities is created for the selected utility table.
+    if (m_utilityView)
+    {
+        delete m_utilityView;
+        m_utilityView = nullptr;
+    }
+    if (m_utilityModel)
+    {
+        delete m_utilityModel;
+        m_utilityModel = nullptr;
+    }
+
+    if (index == BULK_EDIT_RATE_PAGE || index == BULK_EDIT_SENSITIVE_CONTENT_PAGE)
+    {
+        m_stackedLayout->setCurrentIndex(index);
+        return;
+    }
+
+    int tableIndex = index - BULK_EDIT_UTILITY_PAGE;
+    if (tableIndex < 0 || tableIndex >= m_utilityTables.size())
+        return;
+
+    m_searchLine->blockSignals(true);
+    m_searchLine->clear();
+    m_searchLine->blockSignals(false);
+
+    m_utilityTableName = m_utilityTables.at(tableIndex);
+    m_utilityModel = new UtilityInterfaceEditorModel(
+        m_utilityTableName,
+        m_model,
+        m_model->utilityInterface(),
+        m_utility,
+        m_db,
+        this);
+    m_utilityView = new QTableView(this);
+    m_utilityView->setModel(m_utilityModel);
+    m_utilityView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_utilityView->horizontalHeader()->setSortIndicatorClearable(true);
+    m_utilityView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    m_utilityView->setSortingEnabled(true);
+    m_utilityView->verticalHeader()->hide();
+    m_utilityVLayout->addWidget(m_utilityView, 1);
+    m_stackedLayout->setCurrentIndex(BULK_EDIT_UTILITY_PAGE);
+}
+
+void BulkEditDialog::applyEdit()
+{
+    // Applying the edit to all the selected items.
+    if (!m_model || m_indexList.isEmpty())
+    {
+        reject();
+        return;
+    }
+
+    bool result;
+    int page = m_stackedLayout->currentIndex();
+    if (page == BULK_EDIT_RATE_PAGE)
+        result = m_model->bulkSetRate(m_indexList, m_rateWidget->getValue());
+    else if (page == BULK_EDIT_SENSITIVE_CONTENT_PAGE)
+    {
+        SensitiveContent sensitiveContent = {};
+        sensitiveContent.explicitContent = m_explicitWidget->getValue();
+        sensitiveContent.violenceContent = m_violenceWidget->getValue();
+        sensitiveContent.badLanguageContent = m_badLanguageWidget->getValue();
+        result = m_model->bulkSetSensitiveContent(m_indexList, sensitiveContent);
+    }
+    else if (m_utilityModel)
+    {
+        result = m_model->bulkEditUtilities(
+            m_indexList,
+            m_utilityTableName,
+            m_utilityModel->getSelectedUtilities(),
+            static_cast<BulkEditMode>(m_modeComboBox->currentData().toInt()));
+    }
+    else
+        result = false;
+
+    if (result)
+        accept();
+    else
+        QMessageBox::critical(
+            this,
+            tr("Bulk edit"),
+            tr("Failed to apply the edit to the selected items."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+}
@@ -17,20 +17,24 @@
 */
 
 #include "CMDOpts.h"
+#include <cstring>
 
-CMDOpts::CMDOpts(QApplication& app) :
+CMDOpts::CMDOpts(QCoreApplication& app) :
     m_resetSettings(false),
-    m_doNotSaveSettings(false)
+    m_doNotSaveSettings(false),
+    m_stats(false),
+    m_validate(false)
 {
     // Parsing the command line argument.
     QCommandLineParser parser;
-    parser.setApplicationDescription(QApplication::translate(
+    parser.setApplicationDescription(QCoreApplication::translate(
         "cmd parser",
         "A little program to make list of wishing games."));
     parser.addHelpOption();
     parser.addVersionOption();
     parser.addPositionalArgument("itemList",
-        QCoreApplication::translate("cmd parser", "Loading an item list file (game, ...)"));
+        QCoreApplication::translate("cmd parser", "Loading an item list file (game, ...), several files can be given in headless mode."),
+        "[itemList...]");
     
     QCommandLineOption resetSettings(
         "reset-settings",
@@ -41,13 +45,77 @@ CMDOpts::CMDOpts(QApplication& app) :
         "do-not-save-settings",
         QCoreApplication::translate("cmd parser", "Do not save the settings"));
     parser.addOption(doNotSaveSettings);
+
+    // Headless mode, the list files are processed without creating any window.
+    QCommandLineOption stats(
+        "stats",
+        QCoreApplication::translate("cmd parser", "Print the statistics of the list files (headless)"));
+    parser.addOption(stats);
+
+    QCommandLineOption validate(
+        "validate",
+        QCoreApplication::translate("cmd parser", "Check if the list files are valid (headless)"));
+    parser.addOption(validate);
+
+    QCommandLineOption exportFormat(
+        "export",
+        QCoreApplication::translate("cmd parser", "Export the list files into csv, json or jsonl (headless)"),
+        "format");
+    parser.addOption(exportFormat);
+
+    QCommandLineOption convert(
+        "convert",
+        QCoreApplication::translate("cmd parser", "Save the list file with the current file version into output, output must be a directory if several files are given (headless)"),
+        "output");
+    parser.addOption(convert);
+
+    QCommandLineOption upgrade(
+        "upgrade",
+        QCoreApplication::translate("cmd parser", "Upgrade the list files of the directory and its sub directories older than the current file version (headless)"),
+        "directory");
+    parser.addOption(upgrade);
+
+    QCommandLineOption output(
+        QStringList() << "o" << "output",
+        QCoreApplication::translate("cmd parser", "File where the export is written, the standard output is used by default"),
+        "file");
+    parser.addOption(output);
     
     parser.process(app);
 
-    if (parser.positionalArguments().size() > 0)
-        m_itemListFile = parser.positionalArguments().first();
+    m_itemListFiles = parser.positionalArguments();
+    if (m_itemListFiles.size() > 0)
+        m_itemListFile = m_itemListFiles.first();
     m_resetSettings = parser.isSet(resetSettings);
     m_doNotSaveSettings = parser.isSet(doNotSaveSettings);
+    m_stats = parser.isSet(stats);
+    m_validate = parser.isSet(validate);
+    m_exportFormat = parser.value(exportFormat).toLower();
+    m_convertOutput = parser.value(convert);
+    m_upgradeDirectory = parser.value(upgrade);
+    m_output = parser.value(output);
+}
+
+bool CMDOpts::isHeadless(int argc, char** argv)
+{
+    // The parser cannot be used before the application object is created,
+    // so the arguments are checked by hand.
+    const char* headlessOptions[] = { "--stats", "--validate", "--export", "--convert", "--upgrade" };
+    for (int i = 1; i < argc; i++)
+    {
+        // Everything after "--" is a positional argument.
+        if (strcmp(argv[i], "--") == 0)
+            return false;
+
+        for (const char* option : headlessOptions)
+        {
+            size_t size = strlen(option);
+            if (strncmp(argv[i], option, size) == 0 &&
+                (argv[i][size] == '\0' || argv[i][size] == '='))
+                return true;
+        }
+    }
+    return false;
 }
 
 const QString& CMDOpts::itemListFile() const
@@ -55,6 +123,11 @@ const QString& CMDOpts::itemListFile() const
     return m_itemListFile;
 }
 
+const QStringList& CMDOpts::itemListFiles() const
+{
+    return m_itemListFiles;
+}
+
 bool CMDOpts::resetSettings() const
 {
     return m_resetSettings;
@@ -63,4 +136,34 @@ bool CMDOpts::resetSettings() const
 bool CMDOpts::doNotSaveSettings() const
 {
     return m_doNotSaveSettings;
+}
+
+bool CMDOpts::stats() const
+{
+    return m_stats;
+}
+
+bool CMDOpts::validate() const
+{
+    return m_validate;
+}
+
+const QString& CMDOpts::exportFormat() const
+{
+    return m_exportFormat;
+}
+
+const QString& CMDOpts::convertOutput() const
+{
+    return m_convertOutput;
+}
+
+const QString& CMDOpts::upgradeDirectory() const
+{
+    return m_upgradeDirectory;
+}
+
+const QString& CMDOpts::output() const
+{
+    return m_output;
 }
\ No newline at end of file
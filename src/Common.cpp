@@ -17,7 +17,10 @@
 */
 
 #include "Common.h"
+#include "SaveInterface.h"
+#include <QObject>
 #include <QFileInfo>
+#include <QLocale>
 
 QString removeFirstSpaces(const QString& str)
 {
@@ -155,4 +158,48 @@ RecentFileData getRecentFileData(const QString& filePath)
 	data.filePath = filePath;
 	data.fileName = QFileInfo(filePath).fileName();
 	return data;
-}
\ No newline at end of file
+}
+
+QString getFilePreview(const QString& filePath)
+{
+	// Only the metadata block of the file is read.
+	SaveInterface::FileMetadata metadata = {};
+	if (!SaveInterface::readMetadata(filePath, metadata))
+		return QString();
+
+	QString listType;
+	switch (metadata.type)
+	{
+	case ListType::GAMELIST:
+		listType = QObject::tr("Game list");
+		break;
+	case ListType::MOVIESLIST:
+		listType = QObject::tr("Movies list");
+		break;
+	case ListType::COMMONLIST:
+		listType = QObject::tr("Common list");
+		break;
+	case ListType::BOOKSLIST:
+		listType = QObject::tr("Books list");
+		break;
+	case ListType::SERIESLIST:
+		listType = QObject::tr("Series list");
+		break;
+	default:
+		return QString();
+	}
+
+	QStringList lines;
+	lines.append(QObject::tr("%1: %2 tabs, %3 items").arg(listType).arg(metadata.tableCount).arg(metadata.itemCount));
+	lines.append(QObject::tr("Saved: %1").arg(QLocale().toString(metadata.saveTime.toLocalTime(), QLocale::ShortFormat)));
+	for (const SaveInterface::FileMetadataTable& table : metadata.tables)
+	{
+		QString line = QObject::tr("%1 (%2)").arg(replaceUnderscoreBySpace(table.tableName)).arg(table.rowCount);
+		if (!table.topItems.isEmpty())
+			line += QString(": ") + table.topItems.join(", ");
+		lines.append(line);
+	}
+	if (metadata.tables.size() < metadata.tableCount)
+		lines.append(QObject::tr("..."));
+	return lines.join('\n');
+}
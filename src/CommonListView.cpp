@@ -18,9 +18,13 @@
 
 #include "CommonListView.h"
 #include "TableModelCommon.h"
+#include "SaveInterface.h"
 #include "FilterDialog.h"
+#include "BulkEditDialog.h"
 #include "ListViewDelegate.h"
+#include "QuickFilter.h"
 #include <QTableView>
+#include <QDataStream>
 #include <QHeaderView>
 #include <QItemSelectionModel>
 #include <QSqlQuery>
@@ -91,6 +95,7 @@ void CommonListView::setupWidget()
     m_view->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
     m_view->setSortingEnabled(true);
     m_view->verticalHeader()->hide();
+    setupViewMetrics(m_view);
 
     // Setting custom item delegate ListViewDelegate.
     QAbstractItemDelegate* oldDelegate = m_view->itemDelegate();
@@ -224,6 +229,16 @@ void CommonListView::createMenu(QVBoxLayout* vLayout)
         connect(filterAct, &QAction::triggered, this, &CommonListView::filter);
         toolBar->addAction(filterAct);
 
+        QIcon bulkEditIcon(":/Images/Utility.svg");
+        QAction* bulkEditAct = new QAction(bulkEditIcon, tr("Bulk edit"), this);
+        bulkEditAct->setToolTip(tr("Editing the rate, the sensitive content or the utilities of the selected items."));
+        connect(bulkEditAct, &QAction::triggered, this, &CommonListView::bulkEdit);
+        toolBar->addAction(bulkEditAct);
+
+        // Search as you type on the names of the list.
+        toolBar->addSeparator();
+        toolBar->addWidget(new QuickFilter(m_view, m_model, Common::NAME, this));
+
         vLayout->setMenuBar(toolBar);
     }
 }
@@ -238,29 +253,52 @@ void CommonListView::deletingItems()
     }
 }
 
-QVariant CommonListView::listData() const
+Common::ColumnsSize CommonListView::columnsSize() const
 {
-    // Return the data inside the model.
-    if (m_model)
-    {
-        // Retrive the data of the model
-        QVariant variant = m_model->retrieveData();
-        // If the list is a common list.
-        if (variant.canConvert<Common::SaveDataTable>() && m_view)
-        {
-            // Retrieve the size of the column.
-            Common::SaveDataTable data = qvariant_cast<Common::SaveDataTable>(variant);
-            data.viewColumnsSize.name = m_view->columnWidth(Common::NAME);
-            data.viewColumnsSize.series = m_view->columnWidth(Common::SERIES);
-            data.viewColumnsSize.categories = m_view->columnWidth(Common::CATEGORIES);
-            data.viewColumnsSize.authors = m_view->columnWidth(Common::AUTHORS);
-            data.viewColumnsSize.sensitiveContent = m_view->columnWidth(Common::SENSITIVE_CONTENT);
-            data.viewColumnsSize.rate = m_view->columnWidth(Common::RATE);
-            return QVariant::fromValue(data);
-        }
-    }
+    // Retrieve the size of the columns of the view.
+    Common::ColumnsSize columnsSize = {};
+    columnsSize.name = m_view->columnWidth(Common::NAME);
+    columnsSize.series = m_view->columnWidth(Common::SERIES);
+    columnsSize.categories = m_view->columnWidth(Common::CATEGORIES);
+    columnsSize.authors = m_view->columnWidth(Common::AUTHORS);
+    columnsSize.sensitiveContent = m_view->columnWidth(Common::SENSITIVE_CONTENT);
+    columnsSize.rate = m_view->columnWidth(Common::RATE);
+    return columnsSize;
+}
+
+bool CommonListView::writeListData(QDataStream& out) const
+{
+    // Streaming the list into the data stream, without building the SaveDataTable.
+    if (!m_model || !m_view)
+        return false;
 
-    return QVariant();
+    if (!m_model->writeData(out))
+        return false;
+    return writeViewSettings(out);
+}
+
+bool CommonListView::writeViewSettings(QDataStream& out) const
+{
+    if (!m_model || !m_view)
+        return false;
+
+    out << columnsSize();
+    m_model->writeSortingData(out);
+    return true;
+}
+
+bool CommonListView::readViewSettings(QDataStream& in)
+{
+    // Reading the end of a Common::SaveDataTable and applying it to the view.
+    Common::SaveDataTable data = {};
+    in >> data.viewColumnsSize;
+    in >> data.columnSort;
+    in >> data.sortOrder;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    setColumnsSizeAndSortingOrder(QVariant::fromValue(data));
+    return true;
 }
 
 ListType CommonListView::listType() const
@@ -288,6 +326,11 @@ void CommonListView::setColumnsSizeAndSortingOrder(const QVariant& variant)
     }
 }
 
+TableModel* CommonListView::tableModel() const
+{
+    return m_model;
+}
+
 ViewType CommonListView::viewType() const
 {
     return ViewType::COMMON;
@@ -416,6 +459,25 @@ void CommonListView::filter()
     filterDialog.exec();
 }
 
+void CommonListView::bulkEdit()
+{
+    // Opening the bulk edit dialog on the selected items.
+    QModelIndexList indexList = m_view->selectionModel()->selectedRows(0);
+    if (indexList.isEmpty())
+    {
+        QMessageBox::warning(
+            this,
+            tr("Bulk edit"),
+            tr("No items are selected."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
+
+    BulkEditDialog bulkEditDialog(m_model, indexList, m_utilityTable, m_db, this);
+    bulkEditDialog.exec();
+}
+
 void CommonListView::enableAction(QAction* action) const
 {
     if (m_model->isSortingEnabled() || m_model->isFilterEnabled())
@@ -31,6 +31,13 @@
 #include <QStackedLayout>
 #include <QLineEdit>
 #include <QTableView>
+#include <QTimer>
+#include <QSet>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <iostream>
 
 FilterDialog::FilterDialog(
     TableModel* model,
@@ -49,11 +56,21 @@ FilterDialog::FilterDialog(
     m_utilityModel(nullptr),
     m_utilityView(nullptr),
     m_starWidget(new StarWidget(this)),
-    m_lastIndex(0)
+    m_lastIndex(0),
+    m_matchCountLabel(new QLabel(this)),
+    m_matchCountTimer(new QTimer(this))
 {
     resize(480, 380);
     setWindowTitle(tr("Filter selection"));
+
+    m_matchCountTimer->setSingleShot(true);
+    m_matchCountTimer->setInterval(FILTER_DIALOG_COUNT_DELAY);
+    connect(m_matchCountTimer, &QTimer::timeout, this, &FilterDialog::updateMatchCount);
+    connect(&m_matchCountWatcher, &QFutureWatcher<int>::finished, this, &FilterDialog::matchCountReady);
+
+    retrieveItems();
     createWidget();
+    updateMatchCount();
 }
 
 void FilterDialog::createWidget()
@@ -191,6 +208,11 @@ void FilterDialog::createWidget()
 
     vLayout->addLayout(m_stackedLayout);
 
+    // Number of items matching the filter, updated while the filter is edited.
+    vLayout->addWidget(m_matchCountLabel);
+    connect(m_nameText, &QLineEdit::textChanged, this, &FilterDialog::scheduleMatchCount);
+    connect(m_starWidget, &StarWidget::valueChanged, this, &FilterDialog::scheduleMatchCount);
+
     // Apply and Cancel button
     QHBoxLayout* hLayout = new QHBoxLayout(this);
     hLayout->setContentsMargins(0, 0, 0, 0);
@@ -484,6 +506,7 @@ void FilterDialog::comboBoxChanged(int index)
         delete m_utilityModel;
         m_utilityModel = nullptr;
     }
+    m_utilityPostings.clear();
 
     if (m_model->listType() == ListType::GAMELIST)
     {
@@ -526,6 +549,7 @@ void FilterDialog::comboBoxChanged(int index)
             m_utilityView->verticalHeader()->hide();
             m_utilityVLayout->addWidget(m_utilityView, 1);
             m_stackedLayout->setCurrentIndex(2);
+            retrieveUtilityPostings(tableName);
 
             emit tabChanged();
         }
@@ -578,6 +602,7 @@ void FilterDialog::comboBoxChanged(int index)
             m_utilityView->verticalHeader()->hide();
             m_utilityVLayout->addWidget(m_utilityView, 1);
             m_stackedLayout->setCurrentIndex(2);
+            retrieveUtilityPostings(tableName);
 
             emit tabChanged();
         }
@@ -622,6 +647,7 @@ void FilterDialog::comboBoxChanged(int index)
             m_utilityView->verticalHeader()->hide();
             m_utilityVLayout->addWidget(m_utilityView, 1);
             m_stackedLayout->setCurrentIndex(2);
+            retrieveUtilityPostings(tableName);
 
             emit tabChanged();
         }
@@ -670,6 +696,7 @@ void FilterDialog::comboBoxChanged(int index)
             m_utilityView->verticalHeader()->hide();
             m_utilityVLayout->addWidget(m_utilityView, 1);
             m_stackedLayout->setCurrentIndex(2);
+            retrieveUtilityPostings(tableName);
 
             emit tabChanged();
         }
@@ -720,6 +747,7 @@ void FilterDialog::comboBoxChanged(int index)
             m_utilityView->verticalHeader()->hide();
             m_utilityVLayout->addWidget(m_utilityView, 1);
             m_stackedLayout->setCurrentIndex(2);
+            retrieveUtilityPostings(tableName);
 
             emit tabChanged();
         }
@@ -733,10 +761,162 @@ void FilterDialog::comboBoxChanged(int index)
         m_stackedLayout->setCurrentIndex(0);
 
     m_lastIndex = index;
+    updateMatchCount();
 }
 
 void FilterDialog::searchUtilities(const QString& pattern)
 {
     if (m_utilityModel)
         m_utilityModel->setFilter(pattern);
+}
+
+void FilterDialog::retrieveItems()
+{
+    // Retrieve the name and the rate of all the items of the list, the name and rate filters are counted from them.
+    m_itemNames.clear();
+    m_rateCounts.clear();
+    if (!m_model) return;
+
+    QString statement = QString(
+        "SELECT\n"
+        "   Name,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\";")
+        .arg(m_model->rawTableName());
+
+#ifndef NDEBUG
+    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+    QSqlQuery query(m_db);
+    if (query.exec(statement))
+    {
+        while (query.next())
+        {
+            m_itemNames.append(query.value(0).toString());
+            m_rateCounts[query.value(1).toInt()]++;
+        }
+    }
+    else
+        std::cerr << QString("Failed to retrieve the items of the table %1.\n\t%2")
+            .arg(m_model->rawTableName(), query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+}
+
+void FilterDialog::retrieveUtilityPostings(UtilityTableName tableName)
+{
+    // Retrieve the items linked to each utility, the number of items of each utility is shown next to its name.
+    m_utilityPostings.clear();
+    if (!m_interface || !m_utilityModel) return;
+
+    QString statement = QString(
+        "SELECT DISTINCT\n"
+        "   UtilityID,\n"
+        "   ItemID\n"
+        "FROM\n"
+        "   \"%1\";")
+        .arg(m_interface->tableName(tableName));
+
+#ifndef NDEBUG
+    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+    QSqlQuery query(m_db);
+    if (query.exec(statement))
+    {
+        while (query.next())
+            m_utilityPostings[query.value(0).toLongLong()].append(query.value(1).toLongLong());
+    }
+    else
+        std::cerr << QString("Failed to retrieve the items of the utility table %1.\n\t%2")
+            .arg(m_interface->tableName(tableName), query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+
+    QHash<long long int, int> itemCounts;
+    itemCounts.reserve(m_utilityPostings.size());
+    for (QHash<long long int, QList<long long int>>::const_iterator it = m_utilityPostings.constBegin();
+        it != m_utilityPostings.constEnd();
+        it++)
+        itemCounts.insert(it.key(), it.value().size());
+    m_utilityModel->setItemCounts(itemCounts);
+
+    connect(m_utilityModel, &UtilityInterfaceEditorModel::utilitiesUpdated, this, &FilterDialog::scheduleMatchCount);
+}
+
+void FilterDialog::scheduleMatchCount()
+{
+    // Wait for the end of the edition before counting again.
+    m_matchCountTimer->start();
+}
+
+void FilterDialog::updateMatchCount()
+{
+    // Count the items matching the filter of the current page.
+    // The result of a previous count still running is not needed anymore.
+    m_matchCountTimer->stop();
+    m_matchCountWatcher.cancel();
+
+    int page = m_stackedLayout ? m_stackedLayout->currentIndex() : 0;
+    if (page == 1)
+    {
+        m_matchCountLabel->setText(tr("Counting the matching items..."));
+        m_matchCountWatcher.setFuture(QtConcurrent::run(
+            &FilterDialog::countNameMatches,
+            m_itemNames,
+            m_nameText->text()));
+    }
+    else if (page == 2 && m_utilityModel)
+    {
+        m_matchCountLabel->setText(tr("Counting the matching items..."));
+        m_matchCountWatcher.setFuture(QtConcurrent::run(
+            &FilterDialog::countUtilityMatches,
+            m_utilityPostings,
+            m_utilityModel->getSelectedUtilities()));
+    }
+    else if (page == 3)
+        setMatchCountText(m_rateCounts.value(m_starWidget->getValue()));
+    else
+        setMatchCountText(m_itemNames.size());
+}
+
+void FilterDialog::matchCountReady()
+{
+    if (m_matchCountWatcher.isCanceled())
+        return;
+    setMatchCountText(m_matchCountWatcher.result());
+}
+
+void FilterDialog::setMatchCountText(int count)
+{
+    m_matchCountLabel->setText(tr("%1 of %2 items match the filter.").arg(count).arg(m_itemNames.size()));
+}
+
+int FilterDialog::countNameMatches(const QStringList& itemNames, const QString& pattern)
+{
+    // Same matching as the LIKE "%pattern%" of the SQL filter.
+    int count = 0;
+    for (const QString& name : itemNames)
+    {
+        if (name.contains(pattern, Qt::CaseInsensitive))
+            count++;
+    }
+    return count;
+}
+
+int FilterDialog::countUtilityMatches(const QHash<long long int, QList<long long int>>& utilityPostings, const QList<long long int>& utilities)
+{
+    // An item is matching when it is linked to at least one of the utilities.
+    QSet<long long int> items;
+    for (long long int utilityID : utilities)
+    {
+        QHash<long long int, QList<long long int>>::const_iterator it = utilityPostings.constFind(utilityID);
+        if (it == utilityPostings.constEnd())
+            continue;
+        for (long long int itemID : it.value())
+            items.insert(itemID);
+    }
+    return items.size();
 }
\ No newline at end of file
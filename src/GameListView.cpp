@@ -18,8 +18,11 @@
 
 #include "GameListView.h"
 #include "TableModelGame.h"
+#include "SaveInterface.h"
 #include "FilterDialog.h"
+#include "BulkEditDialog.h"
 #include <QTableView>
+#include <QDataStream>
 #include <QHeaderView>
 #include <QItemSelectionModel>
 #include <QSqlQuery>
@@ -40,6 +43,7 @@
 #include <iostream>
 
 #include "ListViewDelegate.h"
+#include "QuickFilter.h"
 
 GameListView::GameListView(const QString& tableName, ListType type, QSqlDatabase& db, SqlUtilityTable& utilityTable, QWidget* parent) :
     AbstractListView(parent),
@@ -94,6 +98,7 @@ void GameListView::setupWidget()
     m_view->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
     m_view->setSortingEnabled(true);
     m_view->verticalHeader()->hide();
+    setupViewMetrics(m_view);
 
     // Setting the custom item delegate ListViewDelegate.
     QAbstractItemDelegate* oldDelegate = m_view->itemDelegate();
@@ -227,6 +232,16 @@ void GameListView::createMenu(QVBoxLayout* vLayout)
         connect(filterAct, &QAction::triggered, this, &GameListView::filter);
         toolBar->addAction(filterAct);
 
+        QIcon bulkEditIcon(":/Images/Utility.svg");
+        QAction* bulkEditAct = new QAction(bulkEditIcon, tr("Bulk edit"), this);
+        bulkEditAct->setToolTip(tr("Editing the rate, the sensitive content or the utilities of the selected items."));
+        connect(bulkEditAct, &QAction::triggered, this, &GameListView::bulkEdit);
+        toolBar->addAction(bulkEditAct);
+
+        // Search as you type on the names of the list.
+        toolBar->addSeparator();
+        toolBar->addWidget(new QuickFilter(m_view, m_model, Game::NAME, this));
+
         vLayout->setMenuBar(toolBar);
     }
 }
@@ -241,37 +256,55 @@ void GameListView::deletingItems()
     }
 }
 
-QVariant GameListView::listData() const
+Game::ColumnsSize GameListView::columnsSize() const
 {
-    // Return the data inside the model.
-    if (m_model)
-    {
-        // Retrieve the data of the model.
-        QVariant variant = m_model->retrieveData();
-        // If the list is a game list.
-        if (m_type == ListType::GAMELIST)
-        {
-            if (variant.canConvert<Game::SaveDataTable>() && m_view)
-            {
-                // Retrieve the size of the column.
-                Game::SaveDataTable data = qvariant_cast<Game::SaveDataTable>(variant);
-                data.viewColumnsSize.name = m_view->columnWidth(Game::NAME);
-                data.viewColumnsSize.series = m_view->columnWidth(Game::SERIES);
-                data.viewColumnsSize.categories = m_view->columnWidth(Game::CATEGORIES);
-                data.viewColumnsSize.developpers = m_view->columnWidth(Game::DEVELOPPERS);
-                data.viewColumnsSize.publishers = m_view->columnWidth(Game::PUBLISHERS);
-                data.viewColumnsSize.platform = m_view->columnWidth(Game::PLATFORMS);
-                data.viewColumnsSize.services = m_view->columnWidth(Game::SERVICES);
-                data.viewColumnsSize.sensitiveContent = m_view->columnWidth(Game::SENSITIVE_CONTENT);
-                data.viewColumnsSize.rate = m_view->columnWidth(Game::RATE);
-                return QVariant::fromValue(data);
-            }
-            else
-                return QVariant();
-        }
-    }
-    
-    return QVariant();
+    // Retrieve the size of the columns of the view.
+    Game::ColumnsSize columnsSize = {};
+    columnsSize.name = m_view->columnWidth(Game::NAME);
+    columnsSize.series = m_view->columnWidth(Game::SERIES);
+    columnsSize.categories = m_view->columnWidth(Game::CATEGORIES);
+    columnsSize.developpers = m_view->columnWidth(Game::DEVELOPPERS);
+    columnsSize.publishers = m_view->columnWidth(Game::PUBLISHERS);
+    columnsSize.platform = m_view->columnWidth(Game::PLATFORMS);
+    columnsSize.services = m_view->columnWidth(Game::SERVICES);
+    columnsSize.sensitiveContent = m_view->columnWidth(Game::SENSITIVE_CONTENT);
+    columnsSize.rate = m_view->columnWidth(Game::RATE);
+    return columnsSize;
+}
+
+bool GameListView::writeListData(QDataStream& out) const
+{
+    // Streaming the list into the data stream, without building the SaveDataTable.
+    if (!m_model || !m_view)
+        return false;
+
+    if (!m_model->writeData(out))
+        return false;
+    return writeViewSettings(out);
+}
+
+bool GameListView::writeViewSettings(QDataStream& out) const
+{
+    if (!m_model || !m_view)
+        return false;
+
+    out << columnsSize();
+    m_model->writeSortingData(out);
+    return true;
+}
+
+bool GameListView::readViewSettings(QDataStream& in)
+{
+    // Reading the end of a Game::SaveDataTable and applying it to the view.
+    Game::SaveDataTable data = {};
+    in >> data.viewColumnsSize;
+    in >> data.columnSort;
+    in >> data.sortOrder;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    setColumnsSizeAndSortingOrder(QVariant::fromValue(data));
+    return true;
 }
 
 ListType GameListView::listType() const
@@ -305,6 +338,11 @@ void GameListView::setColumnsSizeAndSortingOrder(const QVariant& variant)
     }
 }
 
+TableModel* GameListView::tableModel() const
+{
+    return m_model;
+}
+
 ViewType GameListView::viewType() const
 {
     return ViewType::GAME;
@@ -445,6 +483,25 @@ void GameListView::filter()
     filterDialog.exec();
 }
 
+void GameListView::bulkEdit()
+{
+    // Opening the bulk edit dialog on the selected items.
+    QModelIndexList indexList = m_view->selectionModel()->selectedRows(0);
+    if (indexList.isEmpty())
+    {
+        QMessageBox::warning(
+            this,
+            tr("Bulk edit"),
+            tr("No items are selected."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
+
+    BulkEditDialog bulkEditDialog(m_model, indexList, m_utilityTable, m_db, this);
+    bulkEditDialog.exec();
+}
+
 void GameListView::enableAction(QAction* action, bool value) const
 {
     if (this->m_model->isSortingEnabled() || this->m_model->isFilterEnabled())
@@ -0,0 +1,531 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "HeadlessMode.h"
+#include "CMDOpts.h"
+#include "SaveInterface.h"
+#include "SaveJournal.h"
+#include "SqlUtilityTable.h"
+#include "ListExporter.h"
+#include "ListUpgrader.h"
+#include "TableModelGame.h"
+#include "TableModelMovies.h"
+#include "TableModelCommon.h"
+#include "TableModelBooks.h"
+#include "TableModelSeries.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDataStream>
+#include <QTextStream>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+HeadlessMode::HeadlessMode(const CMDOpts& opts) :
+    m_opts(opts),
+    m_db(QSqlDatabase::addDatabase("QSQLITE")),
+    m_utilityTable(nullptr),
+    m_listType(ListType::UNKNOWN)
+{
+    // Same in memory database than the window.
+    m_db.setDatabaseName(":memory:");
+    if (m_db.open())
+        m_utilityTable = new SqlUtilityTable(ListType::UNKNOWN, m_db);
+}
+
+HeadlessMode::~HeadlessMode()
+{
+    unloadFile();
+    if (m_utilityTable)
+        delete m_utilityTable;
+    m_db.close();
+}
+
+int HeadlessMode::exec()
+{
+    if (!m_utilityTable)
+    {
+        std::cerr << "Failed to open sqlite database." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The upgrade process the files of a directory, not the files given.
+    if (!m_opts.upgradeDirectory().isEmpty())
+        return upgradeDirectory(m_opts.upgradeDirectory());
+
+    const QStringList& files = m_opts.itemListFiles();
+    if (files.isEmpty())
+    {
+        std::cerr << "No list file given." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Checking the options before processing anything.
+    bool isExport = !m_opts.exportFormat().isEmpty();
+    ListExporter::Format exportFormat = ListExporter::Format::CSV;
+    if (isExport && !ListExporter::format(m_opts.exportFormat(), exportFormat))
+    {
+        std::cerr << "Unknown export format: " << m_opts.exportFormat().toLocal8Bit().constData() << ", use csv, json or jsonl." << std::endl;
+        return EXIT_FAILURE;
+    }
+    bool isConvert = !m_opts.convertOutput().isEmpty();
+    if (isConvert && files.size() > 1 && !QFileInfo(m_opts.convertOutput()).isDir())
+    {
+        std::cerr << "The convert output must be an existing directory when several files are given." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The export is written into the output file, or into the standard output.
+    QFile outputFile;
+    if (!m_opts.output().isEmpty())
+    {
+        outputFile.setFileName(m_opts.output());
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        {
+            std::cerr << "Cannot open the output file: " << m_opts.output().toLocal8Bit().constData() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    else
+        outputFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    QTextStream out(&outputFile);
+
+    // With several files, the json export is an array of lists.
+    bool isJsonArray = isExport && exportFormat == ListExporter::Format::JSON && files.size() > 1;
+    if (isJsonArray)
+        out << "[\n";
+
+    int result = EXIT_SUCCESS;
+    // The lists skipped because they could not be loaded do not count, the first exported list has no separator.
+    int exportedCount = 0;
+    for (int i = 0; i < files.size(); i++)
+    {
+        const QString& filePath = files.at(i);
+
+        // The convert load the file and its journal on its own.
+        if (isConvert)
+        {
+            QString outputPath = m_opts.convertOutput();
+            if (QFileInfo(outputPath).isDir())
+                outputPath = QDir(outputPath).filePath(QFileInfo(filePath).fileName());
+            if (!convertFile(filePath, outputPath))
+            {
+                std::cerr << "Failed to convert the file: " << filePath.toLocal8Bit().constData() << std::endl;
+                result = EXIT_FAILURE;
+            }
+        }
+
+        if (!m_opts.stats() && !m_opts.validate() && !isExport)
+            continue;
+
+        if (m_opts.validate())
+        {
+            bool isValid = validateFile(filePath);
+            std::cout << (isValid ? "OK: " : "INVALID: ") << filePath.toLocal8Bit().constData() << std::endl;
+            if (!isValid)
+            {
+                // The list may be partially loaded, it's not printed nor exported.
+                result = EXIT_FAILURE;
+                unloadFile();
+                continue;
+            }
+        }
+        else if (!loadFile(filePath) || !applyJournal(filePath))
+        {
+            std::cerr << "Failed to open the file: " << filePath.toLocal8Bit().constData() << std::endl;
+            result = EXIT_FAILURE;
+            continue;
+        }
+
+        if (m_listType == ListType::UNKNOWN)
+            continue;
+
+        if (m_opts.stats())
+            printStats(out, filePath);
+
+        if (isExport)
+        {
+            if (!exportList(out, filePath, exportFormat, exportedCount == 0))
+                result = EXIT_FAILURE;
+            exportedCount++;
+        }
+
+        out.flush();
+        unloadFile();
+    }
+
+    if (isJsonArray)
+        out << "\n]\n";
+    out.flush();
+
+    return result;
+}
+
+bool HeadlessMode::loadFile(const QString& filePath)
+{
+    // Loading the file into the SQL database, like TabAndList::openFile.
+    unloadFile();
+
+    QVariant data;
+    if (!SaveInterface::open(filePath, data))
+        return false;
+
+    ListType type = ListType::UNKNOWN;
+    if (data.canConvert<Game::SaveData>())
+        type = ListType::GAMELIST;
+    else if (data.canConvert<Movie::SaveData>())
+        type = ListType::MOVIESLIST;
+    else if (data.canConvert<Common::SaveData>())
+        type = ListType::COMMONLIST;
+    else if (data.canConvert<Books::SaveData>())
+        type = ListType::BOOKSLIST;
+    else if (data.canConvert<Series::SaveData>())
+        type = ListType::SERIESLIST;
+    else
+        return false;
+
+    m_utilityTable->newList(type);
+    m_listType = type;
+    if (!m_utilityTable->setData(utilityData(data)))
+    {
+        unloadFile();
+        return false;
+    }
+
+    QList<QVariant> tables = tablesData(data);
+    for (const QVariant& table : tables)
+    {
+        TableModel* model = createModel(type, table, m_db, *m_utilityTable);
+        if (!model)
+        {
+            unloadFile();
+            return false;
+        }
+        m_models.append(model);
+    }
+
+    // Remembering the number of items in the file, used to validate the loading,
+    // and the settings of the views, written back by the convert.
+    if (type == ListType::GAMELIST)
+    {
+        for (const Game::SaveDataTable& table : qvariant_cast<Game::SaveData>(data).gameTables)
+        {
+            m_fileRowCount.append(table.gameList.size());
+            m_viewSettings.append(viewSettings(table));
+        }
+    }
+    else if (type == ListType::MOVIESLIST)
+    {
+        for (const Movie::SaveDataTable& table : qvariant_cast<Movie::SaveData>(data).movieTables)
+        {
+            m_fileRowCount.append(table.movieList.size());
+            m_viewSettings.append(viewSettings(table));
+        }
+    }
+    else if (type == ListType::COMMONLIST)
+    {
+        for (const Common::SaveDataTable& table : qvariant_cast<Common::SaveData>(data).commonTables)
+        {
+            m_fileRowCount.append(table.commonList.size());
+            m_viewSettings.append(viewSettings(table));
+        }
+    }
+    else if (type == ListType::BOOKSLIST)
+    {
+        for (const Books::SaveDataTable& table : qvariant_cast<Books::SaveData>(data).booksTables)
+        {
+            m_fileRowCount.append(table.booksList.size());
+            m_viewSettings.append(viewSettings(table));
+        }
+    }
+    else if (type == ListType::SERIESLIST)
+    {
+        for (const Series::SaveDataTable& table : qvariant_cast<Series::SaveData>(data).serieTables)
+        {
+            m_fileRowCount.append(table.serieList.size());
+            m_viewSettings.append(viewSettings(table));
+        }
+    }
+
+    return true;
+}
+
+bool HeadlessMode::applyJournal(const QString& filePath, bool isStrict)
+{
+    // The changes saved into the journal of the file are part of the list, like TabAndList::openSectionedFile.
+    // The window ignore a journal it cannot read, with isStrict (validation) it's an error.
+    bool hasJournal = SaveJournal::exists(filePath);
+    SaveInterface::TableOfContents toc = {};
+    if (!SaveInterface::readTableOfContents(filePath, toc))
+        return !(isStrict && hasJournal);
+
+    SaveJournal journal(m_db);
+    bool isComplete = false;
+    if (!journal.read(filePath, toc, &isComplete))
+        return !(isStrict && hasJournal);
+    if (isStrict && !isComplete)
+        return false;
+
+    QStringList tableNames;
+    for (UtilityTableName tableName : SqlUtilityTable::utilityTables(m_listType))
+        tableNames.append(SqlUtilityTable::tableName(tableName));
+    for (TableModel* model : m_models)
+        tableNames.append(model->sqlTableNames());
+    if (!journal.apply(tableNames))
+        return false;
+
+    for (int i = 0; i < m_models.size(); i++)
+    {
+        m_models.at(i)->updateQuery();
+        QByteArray journalSettings = journal.viewSettings(m_models.at(i)->rawTableName());
+        if (!journalSettings.isEmpty() && i < m_viewSettings.size())
+            m_viewSettings[i] = journalSettings;
+    }
+    return true;
+}
+
+void HeadlessMode::unloadFile()
+{
+    // Deleting the models drop their SQL tables.
+    qDeleteAll(m_models);
+    m_models.clear();
+    m_fileRowCount.clear();
+    m_viewSettings.clear();
+    if (m_utilityTable && m_listType != ListType::UNKNOWN)
+        m_utilityTable->newList(ListType::UNKNOWN);
+    m_listType = ListType::UNKNOWN;
+}
+
+bool HeadlessMode::validateFile(const QString& filePath)
+{
+    // A file is valid if it can be read and every items are inserted into the database,
+    // then its journal must be read entirely and applied.
+    if (!loadFile(filePath))
+        return false;
+
+    if (m_models.size() != m_fileRowCount.size())
+        return false;
+    for (int i = 0; i < m_models.size(); i++)
+    {
+        if (m_models.at(i)->columnCount() == 0 ||
+            m_models.at(i)->rowCount() != m_fileRowCount.at(i))
+            return false;
+    }
+    return applyJournal(filePath, true);
+}
+
+void HeadlessMode::printStats(QTextStream& out, const QString& filePath) const
+{
+    out << filePath << '\n';
+    out << "    Type: " << ListExporter::listTypeName(m_listType) << '\n';
+    out << "    Tables: " << m_models.size() << '\n';
+
+    for (const TableModel* model : m_models)
+    {
+        // The rate is always the last column.
+        int rateColumn = model->columnCount()-1;
+        int ratedItems = 0;
+        long long int rateSum = 0;
+        for (int row = 0; row < model->rowCount(); row++)
+        {
+            int rate = model->data(model->index(row, rateColumn)).toInt();
+            if (rate > 0)
+            {
+                ratedItems++;
+                rateSum += rate;
+            }
+        }
+
+        out << "    Table \"" << model->tableName() << "\": " << model->rowCount() << " items, "
+            << ratedItems << " rated";
+        if (ratedItems > 0)
+            out << ", average rate " << QString::number((double)rateSum / ratedItems, 'f', 2);
+        out << '\n';
+    }
+
+    QList<UtilityTableName> tables = SqlUtilityTable::utilityTables(m_listType);
+    for (UtilityTableName tableName : tables)
+        out << "    " << SqlUtilityTable::tableName(tableName) << ": "
+            << m_utilityTable->retrieveTableData(tableName).size() << '\n';
+}
+
+bool HeadlessMode::exportList(QTextStream& out, const QString& filePath, ListExporter::Format format, bool isFirst)
+{
+    // The tables are streamed from the SQL database, the lists are separated by
+    // a comma when they are written into a json array.
+    if (format == ListExporter::Format::JSON && !isFirst)
+        out << ",\n";
+
+    ListExporter exporter(m_db, m_listType, format, out);
+    exporter.begin(filePath);
+    bool result = true;
+    for (TableModel* model : m_models)
+    {
+        if (!exporter.exportTable(model->tableName(), model->sqlTableNames()))
+        {
+            std::cerr << "Failed to export the table " << model->tableName().toLocal8Bit().constData()
+                << " of the file: " << filePath.toLocal8Bit().constData() << std::endl;
+            result = false;
+        }
+    }
+    exporter.end();
+
+    if (format == ListExporter::Format::JSON && m_opts.itemListFiles().size() == 1)
+        out << '\n';
+    return result;
+}
+
+int HeadlessMode::upgradeDirectory(const QString& directory) const
+{
+    if (!QFileInfo(directory).isDir())
+    {
+        std::cerr << "The upgrade directory does not exist: " << directory.toLocal8Bit().constData() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // The files are upgraded in parallel, the files already up to date are not printed.
+    QList<ListUpgrader::Result> results = ListUpgrader::upgrade(ListUpgrader::findFiles(directory)).results();
+    int result = EXIT_SUCCESS;
+    int upgradedCount = 0;
+    for (const ListUpgrader::Result& fileResult : results)
+    {
+        if (fileResult.status == ListUpgrader::Status::UPGRADED)
+            upgradedCount++;
+        else if (fileResult.status != ListUpgrader::Status::UP_TO_DATE)
+            result = EXIT_FAILURE;
+
+        if (fileResult.status != ListUpgrader::Status::UP_TO_DATE)
+            std::cout << ListUpgrader::statusName(fileResult.status).toLocal8Bit().constData() << ": "
+                << fileResult.filePath.toLocal8Bit().constData() << std::endl;
+    }
+    std::cout << upgradedCount << " of " << results.size() << " files upgraded." << std::endl;
+    return result;
+}
+
+bool HeadlessMode::convertFile(const QString& filePath, const QString& outputPath)
+{
+    // Loading the file decode the legacy formats and apply its journal,
+    // then the tables are streamed from the database with the current version.
+    if (!loadFile(filePath) || !applyJournal(filePath) || m_models.size() != m_viewSettings.size())
+    {
+        unloadFile();
+        return false;
+    }
+
+    QList<SaveInterface::SaveTableSection> tables;
+    for (int i = 0; i < m_models.size(); i++)
+    {
+        const TableModel* model = m_models.at(i);
+        const QByteArray& viewSettings = m_viewSettings.at(i);
+        tables.append({model->rawTableName(), model->itemCount(),
+            [model, &viewSettings](QDataStream& out) -> bool
+            {
+                if (!model->writeData(out))
+                    return false;
+                out.writeRawData(viewSettings.constData(), viewSettings.size());
+                return out.status() == QDataStream::Ok;
+            },
+            model->topItems(FILE_METADATA_TOP_ITEMS)});
+    }
+
+    bool result = SaveInterface::save(outputPath, m_listType, tables,
+        [this](QDataStream& out) -> bool
+        {
+            return m_utilityTable->writeData(out);
+        });
+    unloadFile();
+
+    // The journal is part of the converted file, it's removed when the file is converted in place.
+    if (result && QFileInfo(outputPath).canonicalFilePath() == QFileInfo(filePath).canonicalFilePath())
+        SaveJournal::remove(filePath);
+    return result;
+}
+
+template<typename SaveDataTable>
+QByteArray HeadlessMode::viewSettings(const SaveDataTable& table)
+{
+    // Same values than the end of the SaveDataTable, see writeViewSettings of the list views.
+    QByteArray settings;
+    QDataStream out(&settings, QIODevice::WriteOnly);
+    out << table.viewColumnsSize;
+    out << table.columnSort;
+    out << table.sortOrder;
+    return settings;
+}
+
+QList<QVariant> HeadlessMode::tablesData(const QVariant& data)
+{
+    QList<QVariant> tables;
+    if (data.canConvert<Game::SaveData>())
+    {
+        for (const Game::SaveDataTable& table : qvariant_cast<Game::SaveData>(data).gameTables)
+            tables.append(QVariant::fromValue(table));
+    }
+    else if (data.canConvert<Movie::SaveData>())
+    {
+        for (const Movie::SaveDataTable& table : qvariant_cast<Movie::SaveData>(data).movieTables)
+            tables.append(QVariant::fromValue(table));
+    }
+    else if (data.canConvert<Common::SaveData>())
+    {
+        for (const Common::SaveDataTable& table : qvariant_cast<Common::SaveData>(data).commonTables)
+            tables.append(QVariant::fromValue(table));
+    }
+    else if (data.canConvert<Books::SaveData>())
+    {
+        for (const Books::SaveDataTable& table : qvariant_cast<Books::SaveData>(data).booksTables)
+            tables.append(QVariant::fromValue(table));
+    }
+    else if (data.canConvert<Series::SaveData>())
+    {
+        for (const Series::SaveDataTable& table : qvariant_cast<Series::SaveData>(data).serieTables)
+            tables.append(QVariant::fromValue(table));
+    }
+    return tables;
+}
+
+QVariant HeadlessMode::utilityData(const QVariant& data)
+{
+    if (data.canConvert<Game::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Game::SaveData>(data).utilityData);
+    else if (data.canConvert<Movie::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Movie::SaveData>(data).utilityData);
+    else if (data.canConvert<Common::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Common::SaveData>(data).utilityData);
+    else if (data.canConvert<Books::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Books::SaveData>(data).utilityData);
+    else if (data.canConvert<Series::SaveData>())
+        return QVariant::fromValue(qvariant_cast<Series::SaveData>(data).utilityData);
+    return QVariant();
+}
+
+TableModel* HeadlessMode::createModel(ListType type, const QVariant& table, QSqlDatabase& db, SqlUtilityTable& utilityTable)
+{
+    if (type == ListType::GAMELIST)
+        return new TableModelGame(table, db, utilityTable);
+    else if (type == ListType::MOVIESLIST)
+        return new TableModelMovies(table, db, utilityTable);
+    else if (type == ListType::COMMONLIST)
+        return new TableModelCommon(table, db, utilityTable);
+    else if (type == ListType::BOOKSLIST)
+        return new TableModelBooks(table, db, utilityTable);
+    else if (type == ListType::SERIESLIST)
+        return new TableModelSeries(table, db, utilityTable);
+    return nullptr;
+}
@@ -0,0 +1,80 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImportDialog.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QScrollArea>
+#include <QComboBox>
+#include <QPushButton>
+#include <QLabel>
+
+ImportDialog::ImportDialog(
+    const QStringList& fileColumns,
+    const QStringList& listColumns,
+    const QList<int>& mapping,
+    long long int rowCount,
+    QWidget* parent) :
+    QDialog(parent)
+{
+    resize(420, 380);
+    setWindowTitle(tr("Import items"));
+
+    QVBoxLayout* vLayout = new QVBoxLayout(this);
+    vLayout->addWidget(new QLabel(tr("%1 items found, choose the column of each column of the file:").arg(rowCount), this));
+
+    // One combo box by column of the file, the first item of the combo boxes is "Not imported".
+    QWidget* columnsWidget = new QWidget(this);
+    QFormLayout* formLayout = new QFormLayout(columnsWidget);
+    for (int i = 0; i < fileColumns.size(); i++)
+    {
+        QComboBox* comboBox = new QComboBox(columnsWidget);
+        comboBox->setEditable(false);
+        comboBox->addItem(tr("Not imported"));
+        comboBox->addItems(listColumns);
+        comboBox->setCurrentIndex(mapping.value(i, -1) + 1);
+        formLayout->addRow(fileColumns.at(i), comboBox);
+        m_columnComboBoxes.append(comboBox);
+    }
+    QScrollArea* scrollArea = new QScrollArea(this);
+    scrollArea->setWidgetResizable(true);
+    scrollArea->setWidget(columnsWidget);
+    vLayout->addWidget(scrollArea);
+
+    QHBoxLayout* buttonsLayout = new QHBoxLayout();
+    buttonsLayout->addStretch();
+    QPushButton* importButton = new QPushButton(tr("Import"), this);
+    importButton->setDefault(true);
+    QPushButton* cancelButton = new QPushButton(tr("Cancel"), this);
+    buttonsLayout->addWidget(importButton);
+    buttonsLayout->addWidget(cancelButton);
+    vLayout->addLayout(buttonsLayout);
+
+    connect(importButton, &QPushButton::clicked, this, &ImportDialog::accept);
+    connect(cancelButton, &QPushButton::clicked, this, &ImportDialog::reject);
+}
+
+QList<int> ImportDialog::mapping() const
+{
+    QList<int> mapping;
+    for (const QComboBox* comboBox : m_columnComboBoxes)
+        mapping.append(comboBox->currentIndex() - 1);
+    return mapping;
+}
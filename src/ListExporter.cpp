@@ -0,0 +1,393 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ListExporter.h"
+#include "SqlUtilityTable.h"
+
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QTextStream>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QList>
+
+#include <iostream>
+
+namespace
+{
+    // An item of a table, the utilities are in the order of SqlUtilityTable::utilityTables.
+    struct ExportItem
+    {
+        long long int position;
+        long long int id;
+        QString name;
+        QList<int> extraColumns;
+        QList<QStringList> utilities;
+        SensitiveContent sensitiveContent;
+        QString url;
+        int rate;
+    };
+
+    // The queries of the tables are ordered by the position then the id of the items,
+    // the two first columns of the queries.
+    bool isBefore(const QSqlQuery& query, const ExportItem& item)
+    {
+        long long int position = query.value(0).toLongLong();
+        return position < item.position || (position == item.position && query.value(1).toLongLong() < item.id);
+    }
+
+    bool isSame(const QSqlQuery& query, const ExportItem& item)
+    {
+        return query.value(0).toLongLong() == item.position && query.value(1).toLongLong() == item.id;
+    }
+
+    QString jsonString(const QString& str)
+    {
+        // QJsonDocument only write arrays and objects, the brackets are removed.
+        QByteArray json = QJsonDocument(QJsonArray({str})).toJson(QJsonDocument::Compact);
+        return QString::fromUtf8(json.mid(1, json.size()-2));
+    }
+}
+
+ListExporter::ListExporter(QSqlDatabase& db, ListType type, Format format, QTextStream& out) :
+    m_db(db),
+    m_type(type),
+    m_format(format),
+    m_out(out),
+    m_tableCount(0)
+{}
+
+void ListExporter::begin(const QString& filePath)
+{
+    m_tableCount = 0;
+    if (m_format == Format::CSV)
+    {
+        // Every table of the list is written with the same header.
+        m_out << "Table";
+        for (const QString& column : columnNames(m_type))
+            m_out << ',' << csvField(column);
+        m_out << '\n';
+    }
+    else if (m_format == Format::JSON)
+    {
+        m_out << "{\n    \"file\": " << jsonString(filePath) << ",\n"
+              << "    \"type\": " << jsonString(listTypeName(m_type)) << ",\n"
+              << "    \"tables\": [";
+    }
+}
+
+bool ListExporter::exportTable(const QString& tableName, const QStringList& sqlTableNames)
+{
+    QList<UtilityTableName> utilityTables = SqlUtilityTable::utilityTables(m_type);
+    if (utilityTables.isEmpty() || sqlTableNames.size() != utilityTables.size() + 2)
+        return false;
+
+    const QString itemsTable = sqlTableNames.first();
+    const QString idColumn = itemPrefix(m_type) + "ID";
+    const QString positionColumn = itemPrefix(m_type) + "Pos";
+    const QStringList extraColumns = ListExporter::extraColumns(m_type);
+
+    // The items of the table.
+    QString statement = QString(
+        "SELECT\n"
+        "   %2,\n"
+        "   %3,\n"
+        "   Name,\n"
+        "%4"
+        "   Url,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "ORDER BY\n"
+        "   %2, %3;")
+            .arg(itemsTable, positionColumn, idColumn);
+    QString extraSelect;
+    for (const QString& column : extraColumns)
+        extraSelect += QString("   %1,\n").arg(column);
+    statement = statement.arg(extraSelect);
+
+    QSqlQuery itemsQuery(m_db);
+    itemsQuery.setForwardOnly(true);
+    if (!itemsQuery.exec(statement))
+    {
+#ifndef NDEBUG
+        std::cerr << "Failed to export the table " << itemsTable.toLocal8Bit().constData() << "\n\t"
+            << itemsQuery.lastError().text().toLocal8Bit().constData() << std::endl;
+#endif
+        return false;
+    }
+
+    // The utility names of the items, in the order of the items.
+    QList<QSqlQuery*> utilityQueries;
+    auto deleteQueries = [&utilityQueries]()
+    {
+        qDeleteAll(utilityQueries);
+        utilityQueries.clear();
+    };
+    for (int i = 0; i < utilityTables.size(); i++)
+    {
+        QString utilityStatement = QString(
+            "SELECT\n"
+            "   \"%1\".%4,\n"
+            "   \"%1\".%5,\n"
+            "   \"%2\".Name\n"
+            "FROM\n"
+            "   \"%3\"\n"
+            "INNER JOIN \"%1\" ON \"%1\".%5 = \"%3\".ItemID\n"
+            "INNER JOIN \"%2\" ON \"%2\".\"%2ID\" = \"%3\".UtilityID\n"
+            "ORDER BY\n"
+            "   \"%1\".%4, \"%1\".%5, \"%2\".OrderID;")
+                .arg(itemsTable, SqlUtilityTable::tableName(utilityTables.at(i)), sqlTableNames.at(i+1),
+                     positionColumn, idColumn);
+
+        QSqlQuery* query = new QSqlQuery(m_db);
+        query->setForwardOnly(true);
+        utilityQueries.append(query);
+        if (!query->exec(utilityStatement))
+        {
+            deleteQueries();
+            return false;
+        }
+    }
+
+    // The sensitive content of the items.
+    QSqlQuery sensitiveQuery(m_db);
+    sensitiveQuery.setForwardOnly(true);
+    statement = QString(
+        "SELECT\n"
+        "   \"%1\".%3,\n"
+        "   \"%1\".%4,\n"
+        "   ExplicitContent,\n"
+        "   ViolenceContent,\n"
+        "   BadLanguage\n"
+        "FROM\n"
+        "   \"%2\"\n"
+        "INNER JOIN \"%1\" ON \"%1\".%4 = \"%2\".ItemID\n"
+        "ORDER BY\n"
+        "   \"%1\".%3, \"%1\".%4;")
+            .arg(itemsTable, sqlTableNames.last(), positionColumn, idColumn);
+    if (!sensitiveQuery.exec(statement))
+    {
+        deleteQueries();
+        return false;
+    }
+
+    QList<bool> utilityValid;
+    for (QSqlQuery* query : utilityQueries)
+        utilityValid.append(query->next());
+    bool sensitiveValid = sensitiveQuery.next();
+
+    if (m_format == Format::JSON)
+    {
+        if (m_tableCount > 0)
+            m_out << ',';
+        m_out << "\n        {\n            \"name\": " << jsonString(tableName) << ",\n"
+              << "            \"items\": [";
+    }
+
+    const QStringList columns = columnNames(m_type);
+    const QString csvTableName = csvField(tableName);
+    QList<ExportItem> chunk;
+    chunk.reserve(EXPORT_CHUNK_SIZE);
+    long long int itemCount = 0;
+    bool isEnd = !itemsQuery.next();
+    while (!isEnd)
+    {
+        // Reading a chunk of items.
+        chunk.clear();
+        while (!isEnd && chunk.size() < EXPORT_CHUNK_SIZE)
+        {
+            ExportItem item = {};
+            item.position = itemsQuery.value(0).toLongLong();
+            item.id = itemsQuery.value(1).toLongLong();
+            item.name = itemsQuery.value(2).toString();
+            for (int i = 0; i < extraColumns.size(); i++)
+                item.extraColumns.append(itemsQuery.value(3+i).toInt());
+            item.url = itemsQuery.value(3+extraColumns.size()).toString();
+            item.rate = itemsQuery.value(4+extraColumns.size()).toInt();
+            chunk.append(item);
+            isEnd = !itemsQuery.next();
+        }
+
+        // Merging the utilities and the sensitive content of the items of the chunk.
+        for (ExportItem& item : chunk)
+        {
+            for (int i = 0; i < utilityQueries.size(); i++)
+            {
+                QSqlQuery* query = utilityQueries.at(i);
+                QStringList names;
+                while (utilityValid.at(i) && isBefore(*query, item))
+                    utilityValid[i] = query->next();
+                while (utilityValid.at(i) && isSame(*query, item))
+                {
+                    names.append(query->value(2).toString());
+                    utilityValid[i] = query->next();
+                }
+                item.utilities.append(names);
+            }
+
+            while (sensitiveValid && isBefore(sensitiveQuery, item))
+                sensitiveValid = sensitiveQuery.next();
+            if (sensitiveValid && isSame(sensitiveQuery, item))
+            {
+                item.sensitiveContent.explicitContent = sensitiveQuery.value(2).toInt();
+                item.sensitiveContent.violenceContent = sensitiveQuery.value(3).toInt();
+                item.sensitiveContent.badLanguageContent = sensitiveQuery.value(4).toInt();
+            }
+        }
+
+        // Writing the chunk.
+        for (const ExportItem& item : chunk)
+        {
+            if (m_format == Format::CSV)
+            {
+                m_out << csvTableName << ',' << csvField(item.name);
+                for (int value : item.extraColumns)
+                    m_out << ',' << value;
+                for (const QStringList& names : item.utilities)
+                    m_out << ',' << csvField(names.join(", "));
+                m_out << ',' << item.sensitiveContent.explicitContent << '/'
+                      << item.sensitiveContent.violenceContent << '/'
+                      << item.sensitiveContent.badLanguageContent;
+                m_out << ',' << csvField(item.url) << ',' << item.rate << '\n';
+                continue;
+            }
+
+            // The columns are in the order of columnNames.
+            QJsonObject object;
+            if (m_format == Format::JSON_LINES)
+                object["Table"] = tableName;
+            int column = 0;
+            object[columns.at(column++)] = item.name;
+            for (int value : item.extraColumns)
+                object[columns.at(column++)] = value;
+            for (const QStringList& names : item.utilities)
+                object[columns.at(column++)] = QJsonArray::fromStringList(names);
+            QJsonObject sensitiveObject;
+            sensitiveObject["explicit"] = item.sensitiveContent.explicitContent;
+            sensitiveObject["violence"] = item.sensitiveContent.violenceContent;
+            sensitiveObject["badLanguage"] = item.sensitiveContent.badLanguageContent;
+            object[columns.at(column++)] = sensitiveObject;
+            object[columns.at(column++)] = item.url;
+            object[columns.at(column++)] = item.rate;
+
+            QString json = QString::fromUtf8(QJsonDocument(object).toJson(QJsonDocument::Compact));
+            if (m_format == Format::JSON_LINES)
+                m_out << json << '\n';
+            else
+                m_out << (itemCount > 0 ? ",\n                " : "\n                ") << json;
+            itemCount++;
+        }
+        m_out.flush();
+    }
+
+    if (m_format == Format::JSON)
+        m_out << (itemCount > 0 ? "\n            ]\n        }" : "]\n        }");
+
+    m_tableCount++;
+    deleteQueries();
+    return m_out.status() == QTextStream::Ok;
+}
+
+void ListExporter::end()
+{
+    if (m_format == Format::JSON)
+        m_out << (m_tableCount > 0 ? "\n    ]\n}" : "]\n}");
+    m_out.flush();
+}
+
+bool ListExporter::format(const QString& name, Format& format)
+{
+    if (name == "csv")
+        format = Format::CSV;
+    else if (name == "json")
+        format = Format::JSON;
+    else if (name == "jsonl")
+        format = Format::JSON_LINES;
+    else
+        return false;
+    return true;
+}
+
+QString ListExporter::listTypeName(ListType type)
+{
+    if (type == ListType::GAMELIST)
+        return "game";
+    else if (type == ListType::MOVIESLIST)
+        return "movies";
+    else if (type == ListType::COMMONLIST)
+        return "common";
+    else if (type == ListType::BOOKSLIST)
+        return "books";
+    else if (type == ListType::SERIESLIST)
+        return "series";
+    return "unknown";
+}
+
+QString ListExporter::csvField(const QString& field)
+{
+    // Quoting the field if it contains a separator, a quote or a new line.
+    if (field.contains(',') || field.contains('"') || field.contains('\n') || field.contains('\r'))
+    {
+        QString quoted = field;
+        quoted.replace("\"", "\"\"");
+        return QString("\"%1\"").arg(quoted);
+    }
+    return field;
+}
+
+QStringList ListExporter::columnNames(ListType type)
+{
+    // The columns of the views, then the url.
+    QStringList columns;
+    columns.append("Name");
+    columns.append(extraColumns(type));
+    for (UtilityTableName tableName : SqlUtilityTable::utilityTables(type))
+        columns.append(SqlUtilityTable::tableName(tableName));
+    columns.append("Sensitive Content");
+    columns.append("Url");
+    columns.append("Rate");
+    return columns;
+}
+
+QStringList ListExporter::extraColumns(ListType type)
+{
+    if (type == ListType::SERIESLIST)
+        return { "Episode", "Season" };
+    return {};
+}
+
+QString ListExporter::itemPrefix(ListType type)
+{
+    switch (type)
+    {
+    case ListType::GAMELIST:
+        return "Game";
+    case ListType::MOVIESLIST:
+        return "Movie";
+    case ListType::COMMONLIST:
+        return "Common";
+    case ListType::BOOKSLIST:
+        return "Books";
+    case ListType::SERIESLIST:
+        return "Series";
+    default:
+        return QString();
+    }
+}
@@ -0,0 +1,61 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ListFileDialog.h"
+#include "Common.h"
+
+#include <QLabel>
+#include <QGridLayout>
+#include <QtConcurrent/QtConcurrentRun>
+
+ListFileDialog::ListFileDialog(QWidget* parent, const QString& caption, const QString& directory, const QString& filter) :
+    QFileDialog(parent, caption, directory, filter),
+    m_preview(nullptr)
+{
+    setOption(QFileDialog::DontUseNativeDialog, true);
+    setFileMode(QFileDialog::ExistingFile);
+    setAcceptMode(QFileDialog::AcceptOpen);
+
+    // The preview is added on the right of the files list.
+    m_preview = new QLabel(this);
+    m_preview->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    m_preview->setWordWrap(true);
+    m_preview->setMinimumWidth(200);
+    QGridLayout* gridLayout = qobject_cast<QGridLayout*>(layout());
+    if (gridLayout)
+        gridLayout->addWidget(m_preview, 0, gridLayout->columnCount(), gridLayout->rowCount(), 1);
+
+    connect(this, &QFileDialog::currentChanged, this, &ListFileDialog::readPreview);
+    connect(&m_previewWatcher, &QFutureWatcher<QString>::finished, this, &ListFileDialog::previewRead);
+}
+
+void ListFileDialog::readPreview(const QString& filePath)
+{
+    // Only the metadata block of the file is read, but it's still done in the background
+    // so a slow drive does not block the dialog.
+    m_preview->clear();
+    if (filePath.isEmpty())
+        return;
+
+    m_previewWatcher.setFuture(QtConcurrent::run(&getFilePreview, filePath));
+}
+
+void ListFileDialog::previewRead()
+{
+    m_preview->setText(m_previewWatcher.result());
+}
@@ -0,0 +1,410 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ListImporter.h"
+#include "ListExporter.h"
+#include "SqlUtilityTable.h"
+#include "Common.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QHash>
+
+#include <iostream>
+
+ListImporter::ListImporter(QSqlDatabase& db, SqlUtilityTable& utilityTable, ListType type) :
+    m_db(db),
+    m_utilityTable(utilityTable),
+    m_type(type)
+{}
+
+bool ListImporter::read(const QString& filePath)
+{
+    m_fileColumns.clear();
+    m_rows.clear();
+
+    if (QFileInfo(filePath).suffix().compare("jsonl", Qt::CaseInsensitive) == 0)
+        return readJSONLines(filePath);
+    return readCSV(filePath);
+}
+
+const QStringList& ListImporter::fileColumns() const
+{
+    return m_fileColumns;
+}
+
+long long int ListImporter::rowCount() const
+{
+    return m_rows.size();
+}
+
+QStringList ListImporter::listColumns() const
+{
+    return ListExporter::columnNames(m_type);
+}
+
+QList<int> ListImporter::defaultMapping() const
+{
+    // The columns of the file are mapped to the columns of the list with the same name.
+    QStringList columns = listColumns();
+    QList<int> mapping;
+    for (const QString& column : m_fileColumns)
+    {
+        int index = -1;
+        for (int i = 0; i < columns.size(); i++)
+        {
+            if (columns.at(i).compare(column.trimmed(), Qt::CaseInsensitive) == 0)
+            {
+                index = i;
+                break;
+            }
+        }
+        mapping.append(index);
+    }
+    return mapping;
+}
+
+bool ListImporter::readCSV(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+    QTextStream in(&file);
+    const QString text = in.readAll();
+
+    // The fields can be quoted, a quoted field can contain separators, quotes ("") and new lines.
+    QVariantList row;
+    QString field;
+    bool isQuoted = false, isRowEmpty = true;
+    auto endField = [&row, &field, &isRowEmpty]()
+    {
+        if (!field.isEmpty())
+            isRowEmpty = false;
+        row.append(field);
+        field.clear();
+    };
+    auto endRow = [this, &row, &isRowEmpty]()
+    {
+        // The first row is the header.
+        if (!isRowEmpty)
+        {
+            if (m_fileColumns.isEmpty())
+            {
+                for (const QVariant& column : row)
+                    m_fileColumns.append(column.toString());
+            }
+            else
+                m_rows.append(row);
+        }
+        row.clear();
+        isRowEmpty = true;
+    };
+
+    for (int i = 0; i < text.size(); i++)
+    {
+        const QChar c = text.at(i);
+        if (isQuoted)
+        {
+            if (c == '"' && i+1 < text.size() && text.at(i+1) == '"')
+            {
+                field += '"';
+                i++;
+            }
+            else if (c == '"')
+                isQuoted = false;
+            else
+                field += c;
+        }
+        else if (c == '"')
+            isQuoted = true;
+        else if (c == ',')
+            endField();
+        else if (c == '\n')
+        {
+            endField();
+            endRow();
+        }
+        else if (c != '\r')
+            field += c;
+    }
+    if (!field.isEmpty() || !row.isEmpty())
+    {
+        endField();
+        endRow();
+    }
+
+    return !isQuoted && !m_fileColumns.isEmpty();
+}
+
+bool ListImporter::readJSONLines(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Each line is an object, the columns are the keys in the order they are found.
+    QHash<QString, int> columnIndexes;
+    while (!file.atEnd())
+    {
+        QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty())
+            continue;
+
+        QJsonParseError error;
+        QJsonDocument document = QJsonDocument::fromJson(line, &error);
+        if (error.error != QJsonParseError::NoError || !document.isObject())
+            return false;
+
+        QJsonObject object = document.object();
+        QVariantList row(m_fileColumns.size());
+        for (QJsonObject::const_iterator it = object.constBegin(); it != object.constEnd(); it++)
+        {
+            int index = columnIndexes.value(it.key(), -1);
+            if (index == -1)
+            {
+                index = m_fileColumns.size();
+                columnIndexes.insert(it.key(), index);
+                m_fileColumns.append(it.key());
+            }
+            if (index >= row.size())
+                row.resize(index+1);
+
+            if (it.value().isArray())
+            {
+                QStringList names;
+                for (const QJsonValue& value : it.value().toArray())
+                    names.append(value.toVariant().toString());
+                row[index] = names;
+            }
+            else
+                row[index] = it.value().toVariant();
+        }
+        m_rows.append(row);
+    }
+
+    return !m_fileColumns.isEmpty();
+}
+
+bool ListImporter::import(const QStringList& sqlTableNames, const QList<int>& mapping, const Progress& progress)
+{
+    if (mapping.size() != m_fileColumns.size() ||
+        sqlTableNames.size() != SqlUtilityTable::utilityTables(m_type).size() + 2)
+        return false;
+
+    // Everything is inserted in one transaction, nothing is kept if anything fail.
+    if (!m_db.transaction())
+        return false;
+    if (!insertRows(sqlTableNames, mapping, progress))
+    {
+        m_db.rollback();
+        return false;
+    }
+    return m_db.commit();
+}
+
+bool ListImporter::insertRows(const QStringList& sqlTableNames, const QList<int>& mapping, const Progress& progress)
+{
+    const QList<UtilityTableName> utilityTables = SqlUtilityTable::utilityTables(m_type);
+    const QStringList extraColumns = ListExporter::extraColumns(m_type);
+    const QString itemsTable = sqlTableNames.first();
+    const QString positionColumn = ListExporter::itemPrefix(m_type) + "Pos";
+
+    // The index of each column of the list, see ListExporter::columnNames.
+    const int firstExtra = 1;
+    const int firstUtility = firstExtra + extraColumns.size();
+    const int sensitiveColumn = firstUtility + utilityTables.size();
+    const int urlColumn = sensitiveColumn + 1;
+    const int rateColumn = sensitiveColumn + 2;
+
+    // Resolving the utility names of every rows at once.
+    QList<QHash<QString, long long int>> utilityIDs;
+    for (int i = 0; i < utilityTables.size(); i++)
+    {
+        QStringList names;
+        for (const QVariantList& row : m_rows)
+        {
+            for (int column = 0; column < mapping.size() && column < row.size(); column++)
+            {
+                if (mapping.at(column) == firstUtility + i)
+                    names.append(utilityNames(row.at(column)));
+            }
+        }
+        names.removeDuplicates();
+        bool isAdded = false;
+        utilityIDs.append(m_utilityTable.addItems(utilityTables.at(i), names, &isAdded));
+        // A missing name would drop the links of the items to it, the whole import is rolled back.
+        if (!isAdded)
+            return false;
+    }
+
+    // The items are added after the last item of the table.
+    QSqlQuery query(m_db);
+    long long int position = 0;
+    if (query.exec(QString("SELECT MAX(%1) FROM \"%2\";").arg(positionColumn, itemsTable)) &&
+        query.next() && !query.value(0).isNull())
+        position = query.value(0).toLongLong()+1;
+
+    QString extraNames, extraValues;
+    for (const QString& column : extraColumns)
+    {
+        extraNames += QString(", %1").arg(column);
+        extraValues += ", ?";
+    }
+    QSqlQuery itemQuery(m_db);
+    QSqlQuery sensitiveQuery(m_db);
+    QList<QSqlQuery*> utilityQueries;
+    bool result =
+        itemQuery.prepare(QString(
+            "INSERT INTO \"%1\" (%2, Name%3, Url, Rate)\n"
+            "VALUES (?, ?%4, ?, ?);")
+                .arg(itemsTable, positionColumn, extraNames, extraValues)) &&
+        sensitiveQuery.prepare(QString(
+            "INSERT INTO \"%1\" (ItemID, ExplicitContent, ViolenceContent, BadLanguage)\n"
+            "VALUES (?, ?, ?, ?);")
+                .arg(sqlTableNames.last()));
+    for (int i = 0; i < utilityTables.size() && result; i++)
+    {
+        QSqlQuery* utilityQuery = new QSqlQuery(m_db);
+        utilityQueries.append(utilityQuery);
+        result = utilityQuery->prepare(QString(
+            "INSERT INTO \"%1\" (ItemID, UtilityID)\n"
+            "VALUES (?, ?);")
+                .arg(sqlTableNames.at(i+1)));
+    }
+
+    for (long long int rowIndex = 0; rowIndex < m_rows.size() && result; rowIndex++)
+    {
+        const QVariantList& row = m_rows.at(rowIndex);
+
+        // The values of the row, by column of the list.
+        QVariantList values(rateColumn+1);
+        QList<QStringList> names(utilityTables.size());
+        for (int column = 0; column < mapping.size() && column < row.size(); column++)
+        {
+            int listColumn = mapping.at(column);
+            if (listColumn >= firstUtility && listColumn < sensitiveColumn)
+                names[listColumn - firstUtility].append(utilityNames(row.at(column)));
+            else if (listColumn >= 0 && listColumn <= rateColumn)
+                values[listColumn] = row.at(column);
+        }
+
+        QString name = values.at(0).toString().trimmed();
+        if (name.isEmpty())
+            continue;
+
+        int bindIndex = 0;
+        itemQuery.bindValue(bindIndex++, position);
+        itemQuery.bindValue(bindIndex++, name);
+        for (int i = 0; i < extraColumns.size(); i++)
+            itemQuery.bindValue(bindIndex++, values.at(firstExtra + i).toInt());
+        QString url = values.at(urlColumn).toString().trimmed();
+        itemQuery.bindValue(bindIndex++, url.isEmpty() ? QVariant() : QVariant(url));
+        itemQuery.bindValue(bindIndex++, inRange(values.at(rateColumn).toInt(), 0, 5));
+        result = itemQuery.exec();
+        if (!result)
+            break;
+        long long int itemID = itemQuery.lastInsertId().toLongLong();
+        position++;
+
+        for (int i = 0; i < utilityTables.size() && result; i++)
+        {
+            names[i].removeDuplicates();
+            for (const QString& utilityName : names.at(i))
+            {
+                long long int utilityID = utilityIDs.at(i).value(utilityName, -1);
+                if (utilityID < 0)
+                    continue;
+                utilityQueries.at(i)->bindValue(0, itemID);
+                utilityQueries.at(i)->bindValue(1, utilityID);
+                result = utilityQueries.at(i)->exec();
+                if (!result)
+                    break;
+            }
+        }
+
+        SensitiveContent content = sensitiveContent(values.at(sensitiveColumn));
+        if (result && (content.explicitContent > 0 || content.violenceContent > 0 || content.badLanguageContent > 0))
+        {
+            sensitiveQuery.bindValue(0, itemID);
+            sensitiveQuery.bindValue(1, content.explicitContent);
+            sensitiveQuery.bindValue(2, content.violenceContent);
+            sensitiveQuery.bindValue(3, content.badLanguageContent);
+            result = sensitiveQuery.exec();
+        }
+
+        if (result && progress && ((rowIndex+1) % IMPORT_PROGRESS_STEP == 0 || rowIndex+1 == m_rows.size()))
+            result = progress(rowIndex+1, m_rows.size());
+    }
+
+#ifndef NDEBUG
+    if (!result && itemQuery.lastError().isValid())
+        std::cerr << "Failed to import the items into the table " << itemsTable.toLocal8Bit().constData() << "\n\t"
+            << itemQuery.lastError().text().toLocal8Bit().constData() << std::endl;
+#endif
+
+    qDeleteAll(utilityQueries);
+    return result;
+}
+
+QStringList ListImporter::utilityNames(const QVariant& value)
+{
+    // A JSON array, or the names separated by commas like the views and the CSV export.
+    QStringList names;
+    QStringList values = value.typeId() == QMetaType::QStringList ?
+        value.toStringList() : value.toString().split(',');
+    for (const QString& name : values)
+    {
+        QString trimmedName = removeFirtAndLastSpaces(name);
+        if (!trimmedName.isEmpty())
+            names.append(trimmedName);
+    }
+    return names;
+}
+
+SensitiveContent ListImporter::sensitiveContent(const QVariant& value)
+{
+    // A JSON object, or explicit/violence/bad language like the CSV export.
+    SensitiveContent content = {};
+    if (value.typeId() == QMetaType::QVariantMap)
+    {
+        QVariantMap map = value.toMap();
+        content.explicitContent = map.value("explicit").toInt();
+        content.violenceContent = map.value("violence").toInt();
+        content.badLanguageContent = map.value("badLanguage").toInt();
+    }
+    else
+    {
+        QStringList values = value.toString().split('/');
+        if (values.size() == 3)
+        {
+            content.explicitContent = values.at(0).toInt();
+            content.violenceContent = values.at(1).toInt();
+            content.badLanguageContent = values.at(2).toInt();
+        }
+    }
+    content.explicitContent = inRange(content.explicitContent, 0, 5);
+    content.violenceContent = inRange(content.violenceContent, 0, 5);
+    content.badLanguageContent = inRange(content.badLanguageContent, 0, 5);
+    return content;
+}
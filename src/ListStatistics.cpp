@@ -0,0 +1,407 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ListStatistics.h"
+#include "TableModel.h"
+#include "TableModel_UtilityInterface.h"
+#include "SqlUtilityTable.h"
+#include "UtilityNameIndex.h"
+
+#include <QSqlQuery>
+#include <QSqlError>
+
+#include <iostream>
+
+ListStatistics::ListStatistics(TableModel* model, SqlUtilityTable& utilityTable, QSqlDatabase& db) :
+    QObject(model),
+    m_model(model),
+    m_utilityTable(utilityTable),
+    m_db(db),
+    m_isUpToDate(false)
+{}
+
+ListStatistics::~ListStatistics()
+{}
+
+long long int ListStatistics::itemCount()
+{
+    update();
+    return m_itemRates.size();
+}
+
+const QHash<int, long long int>& ListStatistics::rateCounts()
+{
+    update();
+    return m_rateCounts;
+}
+
+const QHash<long long int, long long int>& ListStatistics::utilityCounts(UtilityTableName tableName)
+{
+    update();
+    return m_utilityCounts[(int)tableName];
+}
+
+const QHash<int, long long int>& ListStatistics::sensitiveContentCounts(SensitiveContentKind kind)
+{
+    update();
+    return m_sensitiveContentCounts[kind];
+}
+
+QString ListStatistics::utilityName(UtilityTableName tableName, long long int utilityID)
+{
+    return m_utilityTable.nameIndex(tableName).name(utilityID);
+}
+
+void ListStatistics::invalidate()
+{
+    // The list changed too much to be updated item by item, computing everything again on the next read.
+    m_isUpToDate = false;
+    emit statisticsChanged();
+}
+
+void ListStatistics::itemInserted(long long int itemID, int rate)
+{
+    // A new item does not have utilities or sensitive content yet.
+    if (!m_isUpToDate)
+        return;
+
+    if (m_itemRates.contains(itemID))
+        itemsRemoved({itemID});
+    m_itemRates.insert(itemID, rate);
+    addCount(m_rateCounts, rate, 1);
+    emit statisticsChanged();
+}
+
+void ListStatistics::itemsRemoved(const QList<long long int>& itemsID)
+{
+    // Removing the counts of the removed items.
+    if (!m_isUpToDate)
+        return;
+
+    QList<UtilityTableName> tables = SqlUtilityTable::utilityTables(m_model->listType());
+    for (long long int itemID : itemsID)
+    {
+        QHash<long long int, int>::iterator rateIt = m_itemRates.find(itemID);
+        if (rateIt == m_itemRates.end())
+            continue;
+        addCount(m_rateCounts, rateIt.value(), -1);
+        m_itemRates.erase(rateIt);
+
+        for (UtilityTableName tName : tables)
+            setItemUtilities(itemID, tName, QList<long long int>());
+        setItemSensitiveContent(itemID, nullptr);
+    }
+    emit statisticsChanged();
+}
+
+void ListStatistics::rateChanged(long long int itemID, int rate)
+{
+    if (!m_isUpToDate)
+        return;
+
+    QHash<long long int, int>::iterator rateIt = m_itemRates.find(itemID);
+    if (rateIt == m_itemRates.end() || rateIt.value() == rate)
+        return;
+    addCount(m_rateCounts, rateIt.value(), -1);
+    addCount(m_rateCounts, rate, 1);
+    rateIt.value() = rate;
+    emit statisticsChanged();
+}
+
+void ListStatistics::utilityChanged(long long int itemID, UtilityTableName tableName)
+{
+    // Only the utilities of the edited item are queried again.
+    if (!m_isUpToDate || !m_itemRates.contains(itemID))
+        return;
+
+    if (tableName == UtilityTableName::SENSITIVE_CONTENT)
+    {
+        QString statement = QString(
+            "SELECT\n"
+            "   ExplicitContent,\n"
+            "   ViolenceContent,\n"
+            "   BadLanguage\n"
+            "FROM\n"
+            "   \"%1\"\n"
+            "WHERE\n"
+            "   ItemID = %2;")
+                .arg(m_model->utilityInterface()->tableName(UtilityTableName::SENSITIVE_CONTENT))
+                .arg(itemID);
+
+#ifndef NDEBUG
+        std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+        QSqlQuery query(m_db);
+        if (!query.exec(statement))
+        {
+            std::cerr << QString("Failed to query the sensitive content of the item %1.\n\t%2")
+                .arg(itemID)
+                .arg(query.lastError().text())
+                .toLocal8Bit().constData()
+                << std::endl;
+            invalidate();
+            return;
+        }
+
+        if (query.next())
+        {
+            SensitiveContent sensData = {};
+            sensData.explicitContent = query.value(0).toInt();
+            sensData.violenceContent = query.value(1).toInt();
+            sensData.badLanguageContent = query.value(2).toInt();
+            setItemSensitiveContent(itemID, &sensData);
+        }
+        else
+            setItemSensitiveContent(itemID, nullptr);
+    }
+    else
+        setItemUtilities(itemID, tableName, retrieveItemUtilities(itemID, tableName));
+
+    emit statisticsChanged();
+}
+
+void ListStatistics::update()
+{
+    // Computing all the aggregates from the SQL tables, only after a bulk change.
+    if (m_isUpToDate)
+        return;
+
+    m_itemRates.clear();
+    m_rateCounts.clear();
+    m_itemUtilities.clear();
+    m_utilityCounts.clear();
+    m_itemSensitiveContent.clear();
+    for (int i = 0; i < 3; i++)
+        m_sensitiveContentCounts[i].clear();
+
+    if (!m_model->utilityInterface() || !retrieveRates())
+        return;
+    QList<UtilityTableName> tables = SqlUtilityTable::utilityTables(m_model->listType());
+    for (UtilityTableName tName : tables)
+    {
+        if (!retrieveUtilities(tName))
+            return;
+    }
+    if (!retrieveSensitiveContent())
+        return;
+
+    m_isUpToDate = true;
+}
+
+bool ListStatistics::retrieveRates()
+{
+    QString statement = QString(
+        "SELECT\n"
+        "   rowid,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\";")
+            .arg(m_model->rawTableName());
+
+#ifndef NDEBUG
+    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    if (!query.exec(statement))
+    {
+        std::cerr << QString("Failed to query the rates of the table %1.\n\t%2")
+            .arg(m_model->rawTableName(), query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+        return false;
+    }
+
+    while (query.next())
+    {
+        int rate = query.value(1).toInt();
+        m_itemRates.insert(query.value(0).toLongLong(), rate);
+        addCount(m_rateCounts, rate, 1);
+    }
+    return true;
+}
+
+bool ListStatistics::retrieveUtilities(UtilityTableName tableName)
+{
+    QString statement = QString(
+        "SELECT\n"
+        "   ItemID,\n"
+        "   UtilityID\n"
+        "FROM\n"
+        "   \"%1\";")
+            .arg(m_model->utilityInterface()->tableName(tableName));
+
+#ifndef NDEBUG
+    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    if (!query.exec(statement))
+    {
+        std::cerr << QString("Failed to query the utilities of the table %1.\n\t%2")
+            .arg(m_model->utilityInterface()->tableName(tableName), query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+        return false;
+    }
+
+    QHash<long long int, QList<long long int>>& itemUtilities = m_itemUtilities[(int)tableName];
+    QHash<long long int, long long int>& utilityCounts = m_utilityCounts[(int)tableName];
+    while (query.next())
+    {
+        long long int itemID = query.value(0).toLongLong();
+        long long int utilityID = query.value(1).toLongLong();
+        QList<long long int>& utilities = itemUtilities[itemID];
+        if (utilities.contains(utilityID))
+            continue;
+        utilities.append(utilityID);
+        addCount(utilityCounts, utilityID, 1);
+    }
+    return true;
+}
+
+bool ListStatistics::retrieveSensitiveContent()
+{
+    QString statement = QString(
+        "SELECT\n"
+        "   ItemID,\n"
+        "   ExplicitContent,\n"
+        "   ViolenceContent,\n"
+        "   BadLanguage\n"
+        "FROM\n"
+        "   \"%1\";")
+            .arg(m_model->utilityInterface()->tableName(UtilityTableName::SENSITIVE_CONTENT));
+
+#ifndef NDEBUG
+    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    if (!query.exec(statement))
+    {
+        std::cerr << QString("Failed to query the sensitive content of the table %1.\n\t%2")
+            .arg(m_model->utilityInterface()->tableName(UtilityTableName::SENSITIVE_CONTENT), query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+        return false;
+    }
+
+    while (query.next())
+    {
+        SensitiveContent sensData = {};
+        sensData.explicitContent = query.value(1).toInt();
+        sensData.violenceContent = query.value(2).toInt();
+        sensData.badLanguageContent = query.value(3).toInt();
+        setItemSensitiveContent(query.value(0).toLongLong(), &sensData);
+    }
+    return true;
+}
+
+QList<long long int> ListStatistics::retrieveItemUtilities(long long int itemID, UtilityTableName tableName)
+{
+    QList<long long int> utilitiesID;
+
+    QString statement = QString(
+        "SELECT DISTINCT\n"
+        "   UtilityID\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "WHERE\n"
+        "   ItemID = %2;")
+            .arg(m_model->utilityInterface()->tableName(tableName))
+            .arg(itemID);
+
+#ifndef NDEBUG
+    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+    QSqlQuery query(m_db);
+    if (query.exec(statement))
+    {
+        while (query.next())
+            utilitiesID.append(query.value(0).toLongLong());
+    }
+    else
+        std::cerr << QString("Failed to query the utilities of the item %1.\n\t%2")
+            .arg(itemID)
+            .arg(query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+    return utilitiesID;
+}
+
+void ListStatistics::setItemUtilities(long long int itemID, UtilityTableName tableName, const QList<long long int>& utilitiesID)
+{
+    // Replace the utilities of an item, only the counts of the old and the new utilities change.
+    QHash<long long int, QList<long long int>>& itemUtilities = m_itemUtilities[(int)tableName];
+    QHash<long long int, long long int>& utilityCounts = m_utilityCounts[(int)tableName];
+
+    QHash<long long int, QList<long long int>>::iterator it = itemUtilities.find(itemID);
+    if (it != itemUtilities.end())
+    {
+        for (long long int utilityID : it.value())
+            addCount(utilityCounts, utilityID, -1);
+        itemUtilities.erase(it);
+    }
+
+    if (utilitiesID.isEmpty())
+        return;
+    for (long long int utilityID : utilitiesID)
+        addCount(utilityCounts, utilityID, 1);
+    itemUtilities.insert(itemID, utilitiesID);
+}
+
+void ListStatistics::setItemSensitiveContent(long long int itemID, const SensitiveContent* sensitiveContent)
+{
+    // Replace the sensitive content of an item, nullptr to remove it.
+    QHash<long long int, SensitiveContent>::iterator it = m_itemSensitiveContent.find(itemID);
+    if (it != m_itemSensitiveContent.end())
+    {
+        addCount(m_sensitiveContentCounts[EXPLICIT_CONTENT], it.value().explicitContent, -1);
+        addCount(m_sensitiveContentCounts[VIOLENCE_CONTENT], it.value().violenceContent, -1);
+        addCount(m_sensitiveContentCounts[BAD_LANGUAGE], it.value().badLanguageContent, -1);
+        m_itemSensitiveContent.erase(it);
+    }
+
+    if (!sensitiveContent)
+        return;
+    addCount(m_sensitiveContentCounts[EXPLICIT_CONTENT], sensitiveContent->explicitContent, 1);
+    addCount(m_sensitiveContentCounts[VIOLENCE_CONTENT], sensitiveContent->violenceContent, 1);
+    addCount(m_sensitiveContentCounts[BAD_LANGUAGE], sensitiveContent->badLanguageContent, 1);
+    m_itemSensitiveContent.insert(itemID, *sensitiveContent);
+}
+
+void ListStatistics::addCount(QHash<int, long long int>& counts, int key, long long int count)
+{
+    long long int& value = counts[key];
+    value += count;
+    if (value <= 0)
+        counts.remove(key);
+}
+
+void ListStatistics::addCount(QHash<long long int, long long int>& counts, long long int key, long long int count)
+{
+    long long int& value = counts[key];
+    value += count;
+    if (value <= 0)
+        counts.remove(key);
+}
@@ -0,0 +1,147 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ListUpgrader.h"
+#include "SaveInterface.h"
+#include "SaveJournal.h"
+
+#include <QFile>
+#include <QDirIterator>
+#include <QByteArray>
+#include <QDataStream>
+#include <QVariant>
+#include <QtConcurrent/QtConcurrentMap>
+
+namespace
+{
+    // The data of a list serialized without compression or dictionary, to compare two lists.
+    QByteArray serializeData(const QVariant& data)
+    {
+        QByteArray bytes;
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        if (data.canConvert<Game::SaveData>())
+            out << qvariant_cast<Game::SaveData>(data);
+        else if (data.canConvert<Movie::SaveData>())
+            out << qvariant_cast<Movie::SaveData>(data);
+        else if (data.canConvert<Common::SaveData>())
+            out << qvariant_cast<Common::SaveData>(data);
+        else if (data.canConvert<Books::SaveData>())
+            out << qvariant_cast<Books::SaveData>(data);
+        else if (data.canConvert<Series::SaveData>())
+            out << qvariant_cast<Series::SaveData>(data);
+        return bytes;
+    }
+}
+
+QStringList ListUpgrader::findFiles(const QString& directory)
+{
+    QStringList files;
+    QDirIterator it(directory, { "*.gld", "*.mld", "*.cld", "*.bld", "*.sld" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        files.append(it.next());
+    files.sort();
+    return files;
+}
+
+QFuture<ListUpgrader::Result> ListUpgrader::upgrade(const QStringList& files)
+{
+    return QtConcurrent::mapped(files, &ListUpgrader::upgradeFile);
+}
+
+ListUpgrader::Result ListUpgrader::upgradeFile(const QString& filePath)
+{
+    Result result = { filePath, Status::FAILED };
+
+    // Only the files older than the current version are upgraded.
+    ListType type;
+    int version;
+    if (!SaveInterface::readFileVersion(filePath, type, version))
+        return result;
+    if (version >= SaveInterface::currentVersion(type))
+    {
+        result.status = Status::UP_TO_DATE;
+        return result;
+    }
+    if (SaveJournal::exists(filePath))
+    {
+        result.status = Status::HAS_JOURNAL;
+        return result;
+    }
+
+    QVariant data;
+    if (!SaveInterface::open(filePath, data))
+        return result;
+
+    // Writing the upgraded file next to the file, then checking it by reading it again.
+    const QString upgradePath = filePath + ".upgrade";
+    if (!SaveInterface::save(upgradePath, data))
+    {
+        QFile::remove(upgradePath);
+        return result;
+    }
+
+    QVariant upgradedData;
+    ListType upgradedType;
+    int upgradedVersion;
+    if (!SaveInterface::readFileVersion(upgradePath, upgradedType, upgradedVersion) ||
+        upgradedType != type ||
+        upgradedVersion != SaveInterface::currentVersion(type) ||
+        !SaveInterface::open(upgradePath, upgradedData) ||
+        serializeData(upgradedData) != serializeData(data))
+    {
+        QFile::remove(upgradePath);
+        result.status = Status::NOT_VERIFIED;
+        return result;
+    }
+
+    // Replacing the file, the original file is put back if the upgraded file cannot be moved.
+    const QString originalPath = filePath + ".original";
+    QFile::remove(originalPath);
+    if (!QFile::rename(filePath, originalPath))
+    {
+        QFile::remove(upgradePath);
+        return result;
+    }
+    if (!QFile::rename(upgradePath, filePath))
+    {
+        QFile::rename(originalPath, filePath);
+        QFile::remove(upgradePath);
+        return result;
+    }
+    QFile::remove(originalPath);
+
+    result.status = Status::UPGRADED;
+    return result;
+}
+
+QString ListUpgrader::statusName(Status status)
+{
+    switch (status)
+    {
+    case Status::UPGRADED:
+        return "UPGRADED";
+    case Status::UP_TO_DATE:
+        return "UP TO DATE";
+    case Status::HAS_JOURNAL:
+        return "SKIPPED (JOURNAL)";
+    case Status::NOT_VERIFIED:
+        return "NOT VERIFIED";
+    default:
+        return "FAILED";
+    }
+}
@@ -30,6 +30,7 @@
 #include <QPainter>
 #include <QBrush>
 #include <QColor>
+#include <QPixmap>
 #include <QSpinBox>
 #include <QSqlQuery>
 #include <QStringList>
@@ -1109,54 +1110,44 @@ void ListViewDelegate::commitAndCloseEditor(QWidget* editor)
 void ListViewDelegate::paintSensitiveStars(QPainter* painter, const QStyleOptionViewItem& options, const QModelIndex& index) const
 {
 	// Paint the stars of the three categories of sensitive content items.
-	painter->setRenderHint(QPainter::Antialiasing, true);
 	painter->save();
 
+	SensitiveContent sensitiveContent = qvariant_cast<SensitiveContent>(index.data());
 	if (options.rect.width() >= 15 * StarEditor::paintFactor())
 	{
-		QPolygonF starPolygons = StarEditor::polygonData();
-
-		// Sensitive Content
-		painter->setPen(Qt::NoPen);
-		painter->setBrush(QBrush(QColor(255, 0, 0)));
-		QRect rect = options.rect;
-		painter->translate(rect.x() + StarEditor::paintFactor() * 0.55, rect.y() + (rect.height() / 2.));
-		painter->scale(StarEditor::paintFactor(), StarEditor::paintFactor());
-
+		// Each category is a strip of five stars slots, the stars are cached pixmaps.
+		qreal devicePixelRatio = painter->device()->devicePixelRatio();
 		for (int i = 0; i < 3; i++)
 		{
 			QColor color;
+			int numStars;
 			if (i == 0)
+			{
 				color = QColor(255, 0, 0);
+				numStars = sensitiveContent.explicitContent;
+			}
 			else if (i == 1)
+			{
 				color = QColor(0, 255, 0);
+				numStars = sensitiveContent.violenceContent;
+			}
 			else
-				color = QColor(0, 0, 255);
-			
-			painter->setBrush(QBrush(color));
-
-			int numStars;
-			if (i == 0)
-				numStars = qvariant_cast<SensitiveContent>(index.data()).explicitContent;
-			else if (i == 1)
-				numStars = qvariant_cast<SensitiveContent>(index.data()).violenceContent;
-			else if (i == 2)
-				numStars = qvariant_cast<SensitiveContent>(index.data()).badLanguageContent;
-
-			for (int j = 0; j < 5; j++)
 			{
-				if (j < numStars)
-					painter->drawPolygon(starPolygons, Qt::WindingFill);
-				painter->translate(1, 0);
+				color = QColor(0, 0, 255);
+				numStars = sensitiveContent.badLanguageContent;
 			}
+
+			QPixmap stars = StarEditor::starsPixmap(inRange(numStars, 0, 5), options.rect.height(), devicePixelRatio, color);
+			if (!stars.isNull())
+				painter->drawPixmap(QPointF(options.rect.x() + i * 5 * StarEditor::paintFactor(), options.rect.y()), stars);
 		}
 	}
 	else
 	{
 		QString sensText = QString("%1 %2 %3")
-			.arg(qvariant_cast<SensitiveContent>(index.data()).explicitContent)
-			.arg(qvariant_cast<SensitiveContent>(index.data()).violenceContent)
-			.arg(qvariant_cast<SensitiveContent>(index.data()).badLanguageContent);
+			.arg(sensitiveContent.explicitContent)
+			.arg(sensitiveContent.violenceContent)
+			.arg(sensitiveContent.badLanguageContent);
 		
 		QFont font = painter->font();
 		font.setPixelSize(20);
@@ -1172,7 +1163,16 @@ void ListViewDelegate::paintSensitiveStars(QPainter* painter, const QStyleOption
 void ListViewDelegate::paintRateStars(QPainter* painter, const QStyleOptionViewItem& options, const QModelIndex& index) const
 {
 	if (options.rect.width() >= 5 * StarEditor::paintFactor())
-		StarEditor::paintStars(index.data().toInt(), painter, options.rect, options.palette);
+	{
+		// The stars are rasterized once and cached, a repaint is only a copy of the pixmap.
+		QPixmap stars = StarEditor::starsPixmap(
+			index.data().toInt(),
+			options.rect.height(),
+			painter->device()->devicePixelRatio(),
+			options.palette.windowText().color());
+		if (!stars.isNull())
+			painter->drawPixmap(options.rect.topLeft(), stars);
+	}
 	else
 	{
 		QString starNB = QString::number(index.data().toInt());
@@ -23,6 +23,8 @@
 #include "Common.h"
 #include "Settings.h"
 #include "SettingsDialog.h"
+#include "ListUpgrader.h"
+#include "StatisticsDock.h"
 
 #include <QApplication>
 #include <QVBoxLayout>
@@ -40,11 +42,15 @@
 #include <QSize>
 #include <QToolButton>
 #include <QFileInfo>
+#include <QFileDialog>
+#include <QProgressDialog>
+#include <QtConcurrent/QtConcurrentRun>
 
 MainWindow::MainWindow(const QString& filePath, bool resetSettings, bool doNotSaveSettings, QWidget* parent) :
 	QMainWindow(parent),
 	m_db(QSqlDatabase::addDatabase("QSQLITE")),
 	m_tabAndList(nullptr),
+	m_statisticsDock(nullptr),
 	m_listToolBar(nullptr),
 	m_listChanged(false),
 
@@ -161,8 +167,28 @@ void MainWindow::createMenu()
 	connect(saveAsListAct, &QAction::triggered, m_tabAndList, &TabAndList::saveAs);
 	m_fileMenu->addAction(saveAsListAct);
 
+	// Export the list into a CSV or a JSON Lines file.
+	QAction* exportListAct = new QAction(tr("Export"), this);
+	exportListAct->setToolTip(tr("Export the list into a CSV or a JSON Lines file."));
+	connect(exportListAct, &QAction::triggered, m_tabAndList, &TabAndList::exportList);
+	m_fileMenu->addAction(exportListAct);
+
+	// Import items from a CSV or a JSON Lines file into the current tab.
+	QAction* importItemsAct = new QAction(tr("Import"), this);
+	importItemsAct->setToolTip(tr("Import items from a CSV or a JSON Lines file into the current tab."));
+	connect(importItemsAct, &QAction::triggered, m_tabAndList, &TabAndList::importItems);
+	m_fileMenu->addAction(importItemsAct);
+
+	// Upgrade the list files of a directory to the current file version.
+	QAction* upgradeFilesAct = new QAction(tr("Upgrade list files"), this);
+	upgradeFilesAct->setToolTip(tr("Upgrade the list files of a directory to the current file version."));
+	connect(upgradeFilesAct, &QAction::triggered, this, &MainWindow::upgradeFiles);
+	m_fileMenu->addAction(upgradeFilesAct);
+
 	// Open recent file.
 	m_recentFileMenu = new QMenu(tr("Recent file"), this);
+	m_recentFileMenu->setToolTipsVisible(true);
+	connect(&m_recentFilePreviews, &QFutureWatcher<QStringList>::finished, this, &MainWindow::recentFilePreviewsRead);
 	m_fileMenu->addMenu(m_recentFileMenu);
 
 	// Exitting the application.
@@ -221,6 +247,12 @@ void MainWindow::createMenu()
 	connect(settingsAct, &QAction::triggered, this, &MainWindow::openSettings);
 	m_editMenu->addAction(settingsAct);
 
+	// View menu
+	QMenu* viewMenu = menuBar()->addMenu(tr("View"));
+	QAction* statisticsAct = m_statisticsDock->toggleViewAction();
+	statisticsAct->setToolTip(tr("Show the statistics of the current view."));
+	viewMenu->addAction(statisticsAct);
+
 	// Add help menu
 	m_helpMenu = menuBar()->addMenu(tr("Help"));
 	QAction* licenceAct = new QAction(tr("Licence"), this);
@@ -243,6 +275,12 @@ void MainWindow::createCentralWidget()
 	connect(m_tabAndList, &TabAndList::newListFileName, this, &MainWindow::listFilePathChanged);
 	connect(m_tabAndList, &TabAndList::listChanged, this, &MainWindow::listChanged);
 	setCentralWidget(m_tabAndList);
+
+	// Statistics of the current tab, hidden by default.
+	m_statisticsDock = new StatisticsDock(this);
+	addDockWidget(Qt::RightDockWidgetArea, m_statisticsDock);
+	m_statisticsDock->hide();
+	connect(m_tabAndList, &TabAndList::currentListChanged, m_statisticsDock, &StatisticsDock::setModel);
 }
 
 void MainWindow::createGameToolBar()
@@ -581,6 +619,7 @@ void MainWindow::writeSettings()
 
 	// Save the geometry of the window.
 	settings.setValue("mainwindow/geometry", saveGeometry());
+	settings.setValue("mainwindow/state", saveState());
 
 	// Save the opened file path.
 	if (!m_tabAndList->filePath().isEmpty())
@@ -631,10 +670,22 @@ void MainWindow::readSettings()
 			(screen()->size().height() - wSize.height()) / 2);
 		setGeometry(QRect(wPos, wSize));
 	}
+
+	// Read the state of the docks.
+	QVariant vState = settings.value("mainwindow/state");
+	if (vState.isValid() && !m_isResetSettings)
+		restoreState(vState.toByteArray());
 	
+	// Read "isFixedMetrics" bool value, before the views of the list are created.
+	QVariant vIsFixedMetrics = settings.value("settings/isFixedMetrics");
+	if (vIsFixedMetrics.isValid() && !m_isResetSettings)
+		Settings::instance().setFixedMetrics(vIsFixedMetrics.toBool());
+
 	// Read the saved file path.
+	// If the program was not closed properly, the autosaved list is restored instead.
+	bool isRestored = m_tabAndList->restoreAutoSave();
 	QVariant vFilePath = settings.value("core/filepath");
-	if (vFilePath.isValid() && !m_isResetSettings)
+	if (!isRestored && vFilePath.isValid() && !m_isResetSettings)
 		m_tabAndList->open(vFilePath.toString());
 	
 	// Read the current directory.
@@ -726,9 +777,38 @@ void MainWindow::updateRecentFileMenu()
 	foreach (const RecentFileData& file, m_recentFileData)
 	{
 		QAction* recentFileAct = new QAction(file.fileName, m_recentFileMenu);
+		recentFileAct->setData(file.filePath);
+		recentFileAct->setToolTip(file.filePath);
 		connect(recentFileAct, &QAction::triggered, [this, file](){this->openRecentFile(file.filePath);});
 		m_recentFileMenu->addAction(recentFileAct);
 	}
+
+	// The previews of the files are read from their metadata in the background,
+	// the files are not opened on the GUI thread.
+	QStringList filePaths;
+	foreach (const RecentFileData& file, m_recentFileData)
+		filePaths.append(file.filePath);
+	m_recentFilePreviews.setFuture(QtConcurrent::run(
+		[filePaths]() -> QStringList
+		{
+			QStringList previews;
+			foreach (const QString& filePath, filePaths)
+				previews.append(getFilePreview(filePath));
+			return previews;
+		}));
+}
+
+void MainWindow::recentFilePreviewsRead()
+{
+	// The previews are shown in the tooltips of the recent file actions.
+	QStringList previews = m_recentFilePreviews.result();
+	QList<QAction*> actions = m_recentFileMenu->actions();
+	for (int i = 0; i < actions.size() && i < previews.size(); i++)
+	{
+		QString filePath = actions.at(i)->data().toString();
+		if (!previews.at(i).isEmpty() && filePath == m_recentFileData.value(i).filePath)
+			actions.at(i)->setToolTip(filePath + "\n" + previews.at(i));
+	}
 }
 
 void MainWindow::removeOldRecentFile()
@@ -785,4 +865,60 @@ void MainWindow::openSettings()
 	// Open the settings dialog.
 	SettingsDialog dialog(this);
 	dialog.exec();
-}
\ No newline at end of file
+}
+
+void MainWindow::upgradeFiles()
+{
+	QString directory = QFileDialog::getExistingDirectory(this, tr("Upgrade list files"), m_tabAndList->currentDirectory());
+	if (directory.isEmpty())
+		return;
+
+	// The opened list is not upgraded, its tables may not be loaded yet.
+	QStringList files = ListUpgrader::findFiles(directory);
+	if (!m_listFilePath.isEmpty())
+	{
+		QString listFilePath = QFileInfo(m_listFilePath).canonicalFilePath();
+		for (int i = files.size()-1; i >= 0; i--)
+		{
+			if (QFileInfo(files.at(i)).canonicalFilePath() == listFilePath)
+				files.removeAt(i);
+		}
+	}
+	if (files.isEmpty())
+	{
+		QMessageBox::information(this, tr("Upgrade list files"), tr("No list file found in %1.").arg(directory), QMessageBox::Ok);
+		return;
+	}
+
+	// The files are upgraded in parallel, the progress dialog follow the future.
+	QProgressDialog progress(tr("Upgrading the list files..."), tr("Cancel"), 0, files.size(), this);
+	progress.setWindowModality(Qt::WindowModal);
+	QFutureWatcher<ListUpgrader::Result> watcher;
+	connect(&watcher, &QFutureWatcher<ListUpgrader::Result>::progressValueChanged, &progress, &QProgressDialog::setValue);
+	connect(&watcher, &QFutureWatcher<ListUpgrader::Result>::finished, &progress, &QProgressDialog::reset);
+	connect(&progress, &QProgressDialog::canceled, &watcher, &QFutureWatcher<ListUpgrader::Result>::cancel);
+	watcher.setFuture(ListUpgrader::upgrade(files));
+	if (!watcher.isFinished())
+		progress.exec();
+	watcher.waitForFinished();
+
+	int upgradedCount = 0, upToDateCount = 0;
+	QStringList failedFiles;
+	for (int i = 0; i < watcher.future().resultCount(); i++)
+	{
+		ListUpgrader::Result result = watcher.future().resultAt(i);
+		if (result.status == ListUpgrader::Status::UPGRADED)
+			upgradedCount++;
+		else if (result.status == ListUpgrader::Status::UP_TO_DATE)
+			upToDateCount++;
+		else
+			failedFiles.append(QString("%1: %2").arg(ListUpgrader::statusName(result.status), result.filePath));
+	}
+
+	QString message = tr("%1 files upgraded, %2 files already up to date.").arg(upgradedCount).arg(upToDateCount);
+	if (!failedFiles.isEmpty())
+		message += "\n\n" + tr("Files not upgraded:") + "\n" + failedFiles.join('\n');
+	if (watcher.isCanceled())
+		message += "\n\n" + tr("The upgrade was canceled.");
+	QMessageBox::information(this, tr("Upgrade list files"), message, QMessageBox::Ok);
+}
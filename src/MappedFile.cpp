@@ -0,0 +1,65 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MappedFile.h"
+
+#include <QByteArray>
+
+MappedFile::MappedFile(const QString& filePath) :
+    m_file(filePath),
+    m_data(nullptr)
+{}
+
+MappedFile::~MappedFile()
+{
+    // The buffer must be closed before the memory is unmapped.
+    m_buffer.close();
+    if (m_data)
+        m_file.unmap(m_data);
+}
+
+bool MappedFile::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Mapping the whole file, the QByteArray does not copy the mapped bytes.
+    qint64 size = m_file.size();
+    if (size > 0)
+        m_data = m_file.map(0, size);
+    if (m_data)
+    {
+        m_buffer.setData(QByteArray::fromRawData(reinterpret_cast<const char*>(m_data), size));
+        return m_buffer.open(QIODevice::ReadOnly);
+    }
+
+    return true;
+}
+
+QIODevice* MappedFile::device()
+{
+    if (m_data)
+        return &m_buffer;
+    else
+        return &m_file;
+}
+
+bool MappedFile::isMapped() const
+{
+    return m_data != nullptr;
+}
@@ -18,9 +18,13 @@
 
 #include "MoviesListView.h"
 #include "TableModelMovies.h"
+#include "SaveInterface.h"
 #include "FilterDialog.h"
+#include "BulkEditDialog.h"
 #include "ListViewDelegate.h"
+#include "QuickFilter.h"
 #include <QTableView>
+#include <QDataStream>
 #include <QHeaderView>
 #include <QItemSelectionModel>
 #include <QSqlQuery>
@@ -92,6 +96,7 @@ void MoviesListView::setupWidget()
     m_view->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
     m_view->setSortingEnabled(true);
     m_view->verticalHeader()->hide();
+    setupViewMetrics(m_view);
 
     // Setting the custom item delegate ListViewDelegate.
     QAbstractItemDelegate* oldDelegate = m_view->itemDelegate();
@@ -225,6 +230,16 @@ void MoviesListView::createMenu(QVBoxLayout* vLayout)
         connect(filterAct, &QAction::triggered, this, &MoviesListView::filter);
         toolBar->addAction(filterAct);
 
+        QIcon bulkEditIcon(":/Images/Utility.svg");
+        QAction* bulkEditAct = new QAction(bulkEditIcon, tr("Bulk edit"), this);
+        bulkEditAct->setToolTip(tr("Editing the rate, the sensitive content or the utilities of the selected items."));
+        connect(bulkEditAct, &QAction::triggered, this, &MoviesListView::bulkEdit);
+        toolBar->addAction(bulkEditAct);
+
+        // Search as you type on the names of the list.
+        toolBar->addSeparator();
+        toolBar->addWidget(new QuickFilter(m_view, m_model, Movie::NAME, this));
+
         vLayout->setMenuBar(toolBar);
     }
 }
@@ -239,33 +254,56 @@ void MoviesListView::deletingItems()
     }
 }
 
-QVariant MoviesListView::listData() const
+Movie::ColumnsSize MoviesListView::columnsSize() const
 {
-    // Return the data inside the model.
-    if (m_model)
-    {
-        // Retrieve the data of the model
-        QVariant variant = m_model->retrieveData();
-        // If the list is a movie list.
-        if (variant.canConvert<Movie::SaveDataTable>() && m_view)
-        {
-            // Retrieve the size of the column.
-            Movie::SaveDataTable data = qvariant_cast<Movie::SaveDataTable>(variant);
-            data.viewColumnsSize.name = m_view->columnWidth(Movie::NAME);
-            data.viewColumnsSize.series = m_view->columnWidth(Movie::SERIES);
-            data.viewColumnsSize.categories = m_view->columnWidth(Movie::CATEGORIES);
-            data.viewColumnsSize.directors = m_view->columnWidth(Movie::DIRECTORS);
-            data.viewColumnsSize.actors = m_view->columnWidth(Movie::ACTORS);
-            data.viewColumnsSize.productions = m_view->columnWidth(Movie::PRODUCTIONS);
-            data.viewColumnsSize.music = m_view->columnWidth(Movie::MUSIC);
-            data.viewColumnsSize.services = m_view->columnWidth(Movie::SERVICES);
-            data.viewColumnsSize.sensitiveContent = m_view->columnWidth(Movie::SENSITIVE_CONTENT);
-            data.viewColumnsSize.rate = m_view->columnWidth(Movie::RATE);
-            return QVariant::fromValue(data);
-        }
-    }
+    // Retrieve the size of the columns of the view.
+    Movie::ColumnsSize columnsSize = {};
+    columnsSize.name = m_view->columnWidth(Movie::NAME);
+    columnsSize.series = m_view->columnWidth(Movie::SERIES);
+    columnsSize.categories = m_view->columnWidth(Movie::CATEGORIES);
+    columnsSize.directors = m_view->columnWidth(Movie::DIRECTORS);
+    columnsSize.actors = m_view->columnWidth(Movie::ACTORS);
+    columnsSize.productions = m_view->columnWidth(Movie::PRODUCTIONS);
+    columnsSize.music = m_view->columnWidth(Movie::MUSIC);
+    columnsSize.services = m_view->columnWidth(Movie::SERVICES);
+    columnsSize.sensitiveContent = m_view->columnWidth(Movie::SENSITIVE_CONTENT);
+    columnsSize.rate = m_view->columnWidth(Movie::RATE);
+    return columnsSize;
+}
+
+bool MoviesListView::writeListData(QDataStream& out) const
+{
+    // Streaming the list into the data stream, without building the SaveDataTable.
+    if (!m_model || !m_view)
+        return false;
+
+    if (!m_model->writeData(out))
+        return false;
+    return writeViewSettings(out);
+}
+
+bool MoviesListView::writeViewSettings(QDataStream& out) const
+{
+    if (!m_model || !m_view)
+        return false;
 
-    return QVariant();
+    out << columnsSize();
+    m_model->writeSortingData(out);
+    return true;
+}
+
+bool MoviesListView::readViewSettings(QDataStream& in)
+{
+    // Reading the end of a Movie::SaveDataTable and applying it to the view.
+    Movie::SaveDataTable data = {};
+    in >> data.viewColumnsSize;
+    in >> data.columnSort;
+    in >> data.sortOrder;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    setColumnsSizeAndSortingOrder(QVariant::fromValue(data));
+    return true;
 }
 
 ListType MoviesListView::listType() const
@@ -300,6 +338,11 @@ void MoviesListView::setColumnsSizeAndSortingOrder(const QVariant& variant)
     }
 }
 
+TableModel* MoviesListView::tableModel() const
+{
+    return m_model;
+}
+
 ViewType MoviesListView::viewType() const
 {
     return ViewType::MOVIE;
@@ -429,6 +472,25 @@ void MoviesListView::filter()
     filterDialog.exec();
 }
 
+void MoviesListView::bulkEdit()
+{
+    // Opening the bulk edit dialog on the selected items.
+    QModelIndexList indexList = m_view->selectionModel()->selectedRows(0);
+    if (indexList.isEmpty())
+    {
+        QMessageBox::warning(
+            this,
+            tr("Bulk edit"),
+            tr("No items are selected."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
+
+    BulkEditDialog bulkEditDialog(m_model, indexList, m_utilityTable, m_db, this);
+    bulkEditDialog.exec();
+}
+
 void MoviesListView::enableAction(QAction* action, bool value) const
 {
     if (this->m_model->isSortingEnabled() || this->m_model->isFilterEnabled())
@@ -0,0 +1,111 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "QuickFilter.h"
+#include <QTableView>
+#include <QAbstractItemModel>
+#include <QTimer>
+
+QuickFilter::QuickFilter(QTableView* view, QAbstractItemModel* model, int column, QWidget* parent) :
+    QLineEdit(parent),
+    m_view(view),
+    m_model(model),
+    m_column(column),
+    m_timer(new QTimer(this)),
+    m_isUpToDate(true)
+{
+    setPlaceholderText(tr("Quick filter"));
+    setToolTip(tr("Show only the items whose name contain the text."));
+    setClearButtonEnabled(true);
+    setMaximumWidth(250);
+
+    // The rows are filtered once the user stop typing.
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(QUICK_FILTER_DELAY);
+    connect(m_timer, &QTimer::timeout, this, &QuickFilter::applyPattern);
+    connect(this, &QLineEdit::textChanged, this, &QuickFilter::patternEdited);
+
+    // When the rows of the model change, the pattern is applied again on all the rows.
+    connect(m_model, &QAbstractItemModel::modelReset, this, &QuickFilter::rowsChanged);
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, &QuickFilter::rowsChanged);
+    connect(m_model, &QAbstractItemModel::rowsRemoved, this, &QuickFilter::rowsChanged);
+    connect(m_model, &QAbstractItemModel::layoutChanged, this, &QuickFilter::rowsChanged);
+    connect(m_model, &QAbstractItemModel::dataChanged, this,
+        [this](const QModelIndex& topLeft, const QModelIndex& bottomRight)
+        {
+            if (topLeft.column() <= m_column && bottomRight.column() >= m_column)
+                rowsChanged();
+        });
+}
+
+QuickFilter::~QuickFilter()
+{}
+
+void QuickFilter::patternEdited()
+{
+    m_timer->start();
+}
+
+void QuickFilter::rowsChanged()
+{
+    m_isUpToDate = false;
+    if (!m_pattern.isEmpty())
+        m_timer->start();
+}
+
+void QuickFilter::applyPattern()
+{
+    const QString pattern = text().trimmed();
+    if (pattern == m_pattern && m_isUpToDate)
+        return;
+
+    QList<int> matchingRows;
+    if (m_isUpToDate && !m_pattern.isEmpty() && pattern.contains(m_pattern, Qt::CaseInsensitive))
+    {
+        // The new pattern narrow the previous one, only the rows matching it can match the new one.
+        for (int row : m_matchingRows)
+        {
+            if (isMatching(row, pattern))
+                matchingRows.append(row);
+            else
+                m_view->setRowHidden(row, true);
+        }
+    }
+    else
+    {
+        // Checking all the rows, only the rows changing of state are shown or hidden.
+        const int rowCount = m_model->rowCount();
+        for (int row = 0; row < rowCount; row++)
+        {
+            bool isMatch = pattern.isEmpty() || isMatching(row, pattern);
+            if (isMatch)
+                matchingRows.append(row);
+            if (m_view->isRowHidden(row) == isMatch)
+                m_view->setRowHidden(row, !isMatch);
+        }
+    }
+
+    m_pattern = pattern;
+    m_matchingRows = matchingRows;
+    m_isUpToDate = true;
+}
+
+bool QuickFilter::isMatching(int row, const QString& pattern) const
+{
+    return m_model->data(m_model->index(row, m_column)).toString().contains(pattern, Qt::CaseInsensitive);
+}
@@ -17,13 +17,24 @@
 */
 
 #include "SaveInterface.h"
+#include "SqlUtilityTable.h"
+#include "BlockCompressedDevice.h"
+#include "MappedFile.h"
 
 #include <QString>
 #include <QList>
 #include <QFile>
+#include <QBuffer>
 #include <QSaveFile>
 #include <QDataStream>
 #include <QFileInfo>
+#include <QDateTime>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QThread>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <iostream>
 #include <cstring>
@@ -56,56 +67,1005 @@ bool SaveInterface::save(const QString& filePath, const QVariant& data)
 
 bool SaveInterface::open(const QString& filePath, QVariant& data)
 {
-    // Opening the file
-    QFile file(filePath);
-    if (file.open(QIODevice::ReadOnly))
+    // Opening the file, it's mapped into memory if possible.
+    MappedFile file(filePath);
+    if (file.open())
     {
         // Streaming from the file.
-        QDataStream in(&file);
-
-        // Read the primary identifier
-        char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE];
-        for (int i = 0; i < PRIMARY_IDENTIFIER_SIZE; i++)
-            primaryIdentifier[i] = 0x00; // Initialize to null
-        in.readRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
-
-        // Check if the primary identifier is a valid.
-        char validPrimaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
-        if (strcmp(primaryIdentifier, validPrimaryIdentifier) != 0)
-            return false;
+        QDataStream in(file.device());
 
-        // Reading the identifier
-        char fileIdentifier[4] = {0,0,0,0};
-        in.readRawData(fileIdentifier, 3);
+        // Reading the identifiers.
+        ListType type = readIdentifier(in);
 
         bool ret = false;
         // Checking if the file is a GameList file.
-        if (strcmp(fileIdentifier, GLD_IDENTIFIER) == 0)
+        if (type == ListType::GAMELIST)
             ret = openGame(&in, data);
         // Cheking if the file is a MovieList file.
-        else if (strcmp(fileIdentifier, MLD_IDENTIFIER) == 0)
+        else if (type == ListType::MOVIESLIST)
             ret = openMovies(&in, data);
         // Cheking if the file is a CommonList file.
-        else if (strcmp(fileIdentifier, CLD_IDENTIFIER) == 0)
+        else if (type == ListType::COMMONLIST)
             ret = openCommonList(&in, data);
         // Cheking if the file is a BooksList file.
-        else if (strcmp(fileIdentifier, BLD_IDENTIFIER) == 0)
+        else if (type == ListType::BOOKSLIST)
             ret = openBooksList(&in ,data);
         // Cheking if the file is a SeriesList file.
-        else if (strcmp(fileIdentifier, SLD_IDENTIFIER) == 0)
+        else if (type == ListType::SERIESLIST)
             ret = openSeriesList(&in, data);
-        file.close();
         return ret;
     }
     else
         return false;
 }
 
+// Read a list written as the number of rows followed by the rows,
+// the rows are given to chunkRead by chunk of OPEN_STREAM_CHUNK_SIZE rows.
+template<typename T>
+static bool readChunks(QDataStream& in, const std::function<bool(const QList<T>& chunk)>& chunkRead)
+{
+    long long int count;
+    in >> count;
+    if (in.status() != QDataStream::Ok || count < 0)
+        return false;
+
+    QList<T> chunk;
+    chunk.reserve(qMin(count, OPEN_STREAM_CHUNK_SIZE));
+    for (long long int i = 0; i < count; i++)
+    {
+        T item = {};
+        in >> item;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        chunk.append(item);
+
+        if (chunk.size() == OPEN_STREAM_CHUNK_SIZE || i == count-1)
+        {
+            if (!chunkRead(chunk))
+                return false;
+            chunk.clear();
+        }
+    }
+
+    return true;
+}
+
+// The utility tables written in the file, the legacy files do not have the series utility.
+static QList<UtilityTableName> fileUtilityTables(ListType type)
+{
+    QList<UtilityTableName> utilityTables = SqlUtilityTable::utilityTables(type);
+    if (SaveInterface::isLegacy())
+        utilityTables.removeAll(UtilityTableName::SERIES);
+    return utilityTables;
+}
+
+// Read a table of a list of type Table (Game::SaveDataTable, ...)
+// and give it chunk by chunk to the handler. itemList is the list of items of the table.
+template<typename Table, typename Item>
+static bool readTableChunks(QDataStream& in, ListType type, QList<Item> Table::*itemList, const SaveInterface::OpenStreamHandler& handler)
+{
+    Table table = {};
+    in >> table.tableName;
+    if (in.status() != QDataStream::Ok || !handler.beginTable(table.tableName))
+        return false;
+
+    // The items.
+    bool result = readChunks<Item>(in,
+        [&handler, &table, itemList](const QList<Item>& items) -> bool
+        {
+            Table chunk = {};
+            chunk.tableName = table.tableName;
+            chunk.*itemList = items;
+            return handler.itemsChunk(QVariant::fromValue(chunk));
+        });
+    if (!result)
+        return false;
+
+    // The utility interface.
+    for (UtilityTableName tName : fileUtilityTables(type))
+    {
+        result = readChunks<Game::SaveUtilityInterfaceItem>(in,
+            [&handler, tName](const QList<Game::SaveUtilityInterfaceItem>& items) -> bool
+            {
+                return handler.interfaceChunk(tName, items);
+            });
+        if (!result)
+            return false;
+    }
+    if (!readChunks<Game::SaveUtilitySensitiveContentItem>(in, handler.sensitiveContentChunk))
+        return false;
+
+    // The size of the columns and the sorting.
+    in >> table.viewColumnsSize;
+    in >> table.columnSort;
+    in >> table.sortOrder;
+    return in.status() == QDataStream::Ok && handler.endTable(QVariant::fromValue(table));
+}
+
+bool SaveInterface::open(const QString& filePath, const OpenStreamHandler& handler)
+{
+    // The file is mapped into memory if possible.
+    MappedFile file(filePath);
+    if (!file.open())
+        return false;
+
+    QDataStream in(file.device());
+
+    // Reading the identifiers and the version of the file.
+    FileFormat format = {};
+    ListType type = readIdentifier(in);
+    if (type == ListType::UNKNOWN || !readVersion(in, type, format))
+        return false;
+
+    // The sections are read one after the other, the tables first.
+    if (format.isSectioned)
+    {
+        if (!handler.beginList(type))
+            return false;
+        return readSections(&in, type, format,
+            [type, &handler](QDataStream& in) -> bool
+            {
+                return readTableStream(in, type, handler);
+            },
+            [type, &handler](QDataStream& in) -> bool
+            {
+                return readUtilityStream(in, type, handler);
+            });
+    }
+
+    // Then reading the tables, the blocks are decompressed while reading.
+    auto readList = [type, &handler](QDataStream& in) -> bool
+    {
+        return readListStream(in, type, handler);
+    };
+    if (!format.isBlockCompressed)
+        return readDataAndEnd(in, format.hasStringDictionary, readList);
+
+    BlockCompressedReader reader(file.device());
+    if (!reader.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream blockIn(&reader);
+    return readDataAndEnd(blockIn, format.hasStringDictionary, readList);
+}
+
+bool SaveInterface::readListStream(QDataStream& in, ListType type, const OpenStreamHandler& handler)
+{
+    if (!handler.beginList(type))
+        return false;
+
+    // Reading the tables.
+    int tableCount;
+    in >> tableCount;
+    if (in.status() != QDataStream::Ok || tableCount < 0)
+        return false;
+
+    for (int i = 0; i < tableCount; i++)
+    {
+        if (!readTableStream(in, type, handler))
+            return false;
+    }
+
+    // Reading the utility data.
+    return readUtilityStream(in, type, handler);
+}
+
+bool SaveInterface::readTableStream(QDataStream& in, ListType type, const OpenStreamHandler& handler)
+{
+    switch (type)
+    {
+    case ListType::GAMELIST:
+        return readTableChunks(in, type, &Game::SaveDataTable::gameList, handler);
+    case ListType::MOVIESLIST:
+        return readTableChunks(in, type, &Movie::SaveDataTable::movieList, handler);
+    case ListType::COMMONLIST:
+        return readTableChunks(in, type, &Common::SaveDataTable::commonList, handler);
+    case ListType::BOOKSLIST:
+        return readTableChunks(in, type, &Books::SaveDataTable::booksList, handler);
+    case ListType::SERIESLIST:
+        return readTableChunks(in, type, &Series::SaveDataTable::serieList, handler);
+    default:
+        return false;
+    }
+}
+
+bool SaveInterface::readUtilityStream(QDataStream& in, ListType type, const OpenStreamHandler& handler)
+{
+    for (UtilityTableName tName : fileUtilityTables(type))
+    {
+        bool result = readChunks<ItemUtilityData>(in,
+            [&handler, tName](const QList<ItemUtilityData>& items) -> bool
+            {
+                return handler.utilityChunk(tName, items);
+            });
+        if (!result)
+            return false;
+    }
+
+    return true;
+}
+
+bool SaveInterface::readPayload(QDataStream* in, const FileFormat& format, const std::function<bool(QDataStream& in)>& readData)
+{
+    if (!format.isBlockCompressed)
+        return readDataAndEnd(*in, format.hasStringDictionary, readData);
+
+    BlockCompressedReader reader(in->device());
+    if (!reader.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream blockIn(&reader);
+    return readDataAndEnd(blockIn, format.hasStringDictionary, readData);
+}
+
+bool SaveInterface::readDataAndEnd(QDataStream& in, bool hasStringDictionary, const std::function<bool(QDataStream& in)>& readData)
+{
+    // The dictionary is rebuilt while the strings are read.
+    StringDictionary dictionary;
+    StringDictionary* previousDictionary = m_stringDictionary;
+    m_stringDictionary = hasStringDictionary ? &dictionary : nullptr;
+
+    // Reading the data, then the unsigned char 0xFF at the end of the payload.
+    // If it's not there, it's mean the file is not loaded correctly.
+    bool result = readData(in) && in.status() == QDataStream::Ok && !in.atEnd();
+    if (result)
+    {
+        unsigned char endFile;
+        in >> endFile;
+        result = in.status() == QDataStream::Ok && endFile == 0xFF;
+    }
+
+    m_stringDictionary = previousDictionary;
+    return result;
+}
+
+static void writeFileSection(QDataStream& out, const SaveInterface::FileSection& section)
+{
+    out << section.tableName;
+    out << section.offset;
+    out << section.length;
+    out << section.rowCount;
+    out << section.checksum;
+}
+
+bool SaveInterface::readTableOfContents(const QString& filePath, TableOfContents& toc)
+{
+    MappedFile file(filePath);
+    if (!file.open())
+        return false;
+
+    QDataStream in(file.device());
+
+    FileFormat format = {};
+    ListType type = readIdentifier(in);
+    if (type == ListType::UNKNOWN || !readVersion(in, type, format) || !format.isSectioned)
+        return false;
+
+    return readTableOfContents(in, type, format, toc);
+}
+
+bool SaveInterface::readTableOfContents(QDataStream& in, ListType type, const FileFormat& format, TableOfContents& toc)
+{
+    // The offset of the table of contents is written after the version and the metadata.
+    QIODevice* device = in.device();
+    if (format.hasMetadata && in.skipRawData(FILE_METADATA_SIZE) != FILE_METADATA_SIZE)
+        return false;
+    qint64 tocOffset;
+    in >> tocOffset;
+    qint64 headerEnd = device->pos();
+    if (in.status() != QDataStream::Ok ||
+        tocOffset < headerEnd ||
+        tocOffset >= device->size() ||
+        !device->seek(tocOffset))
+        return false;
+
+    // Each section must be between the header and the table of contents.
+    auto readFileSection = [&in, headerEnd, tocOffset](FileSection& section) -> bool
+    {
+        in >> section.tableName;
+        in >> section.offset;
+        in >> section.length;
+        in >> section.rowCount;
+        in >> section.checksum;
+        return in.status() == QDataStream::Ok &&
+            section.offset >= headerEnd &&
+            section.length > 0 &&
+            section.offset <= tocOffset - section.length &&
+            section.rowCount >= 0;
+    };
+
+    toc.type = type;
+    toc.tables.clear();
+    if (!readFileSection(toc.utility))
+        return false;
+
+    int tableCount;
+    in >> tableCount;
+    if (in.status() != QDataStream::Ok || tableCount < 0)
+        return false;
+    for (int i = 0; i < tableCount; i++)
+    {
+        FileSection section = {};
+        if (!readFileSection(section))
+            return false;
+        toc.tables.append(section);
+    }
+
+    unsigned char endCheck;
+    in >> endCheck;
+    return in.status() == QDataStream::Ok && endCheck == 0xFF;
+}
+
+bool SaveInterface::readSection(QIODevice* device, const FileSection& section, const std::function<bool(QDataStream& in)>& readData)
+{
+    if (section.offset < 0 || section.length <= 0 || section.offset > device->size() - section.length)
+        return false;
+
+    // If the device is a mapped file, the section is used in place, otherwise it's read into memory.
+    QByteArray bytes;
+    const QBuffer* buffer = qobject_cast<const QBuffer*>(device);
+    if (buffer && buffer->data().size() == device->size())
+        bytes = QByteArray::fromRawData(buffer->data().constData() + section.offset, section.length);
+    else
+    {
+        if (!device->seek(section.offset))
+            return false;
+        bytes = device->read(section.length);
+        if (bytes.size() != section.length)
+            return false;
+    }
+
+    // Checking the section before decompressing anything.
+    if (blockChecksum(bytes.constData(), bytes.size()) != section.checksum)
+        return false;
+
+    // The offsets of the blocks are relative to the beginning of the section.
+    QBuffer sectionBuffer(&bytes);
+    if (!sectionBuffer.open(QIODevice::ReadOnly))
+        return false;
+    BlockCompressedReader reader(&sectionBuffer);
+    if (!reader.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&reader);
+    return readDataAndEnd(in, true, readData);
+}
+
+bool SaveInterface::writeSection(QIODevice* device, const std::function<bool(QDataStream& out)>& writeData, FileSection& section)
+{
+    // Each section is block compressed with its own dictionary,
+    // so it can be read without the other sections.
+    section.offset = device->pos();
+    BlockCompressedWriter writer(device, section.offset);
+    writer.open(QIODevice::WriteOnly);
+    QDataStream out(&writer);
+    StringDictionary dictionary;
+    StringDictionary* previousDictionary = m_stringDictionary;
+    m_stringDictionary = &dictionary;
+
+    // Writing the data of the section, then the end check.
+    bool result = writeData(out);
+    const unsigned char endCheck = 0xFF;
+    out << endCheck;
+    m_stringDictionary = previousDictionary;
+
+    if (!result || out.status() != QDataStream::Ok || !writer.finish())
+        return false;
+
+    section.length = device->pos() - section.offset;
+    section.checksum = writer.checksum();
+    return true;
+}
+
+bool SaveInterface::copySection(QIODevice* device, const QString& sourceFilePath, const FileSection& sourceSection, FileSection& section)
+{
+    // The offsets of the blocks are relative to the beginning of the section,
+    // so a section can be copied as is at another offset.
+    MappedFile file(sourceFilePath);
+    if (!file.open())
+        return false;
+    QIODevice* source = file.device();
+    if (sourceSection.offset < 0 || sourceSection.length <= 0 || sourceSection.offset > source->size() - sourceSection.length)
+        return false;
+
+    QByteArray bytes;
+    const QBuffer* buffer = qobject_cast<const QBuffer*>(source);
+    if (buffer && buffer->data().size() == source->size())
+        bytes = QByteArray::fromRawData(buffer->data().constData() + sourceSection.offset, sourceSection.length);
+    else
+    {
+        if (!source->seek(sourceSection.offset))
+            return false;
+        bytes = source->read(sourceSection.length);
+        if (bytes.size() != sourceSection.length)
+            return false;
+    }
+
+    // If the source file changed since its table of contents was read, the copy fail.
+    if (blockChecksum(bytes.constData(), bytes.size()) != sourceSection.checksum)
+        return false;
+
+    section.offset = device->pos();
+    if (device->write(bytes) != bytes.size())
+        return false;
+    section.length = sourceSection.length;
+    section.checksum = sourceSection.checksum;
+    return true;
+}
+
+bool SaveInterface::readSections(QDataStream* in, ListType type, const FileFormat& format, const std::function<bool(QDataStream& in)>& readTable, const std::function<bool(QDataStream& in)>& readUtility)
+{
+    TableOfContents toc = {};
+    if (!readTableOfContents(*in, type, format, toc))
+        return false;
+
+    for (const FileSection& section : toc.tables)
+    {
+        if (!readSection(in->device(), section, readTable))
+            return false;
+    }
+
+    return readSection(in->device(), toc.utility, readUtility);
+}
+
+bool SaveInterface::checkSectionedFile(QDataStream& in, ListType type)
+{
+    FileFormat format = {};
+    return readIdentifier(in) == type &&
+        readVersion(in, type, format) &&
+        format.isSectioned;
+}
+
+bool SaveInterface::openTable(const QString& filePath, const TableOfContents& toc, int index, const OpenStreamHandler& handler)
+{
+    if (index < 0 || index >= toc.tables.size())
+        return false;
+
+    MappedFile file(filePath);
+    if (!file.open())
+        return false;
+
+    // The section is checked with its checksum, if the file changed since
+    // the table of contents was read, the reading fail.
+    QDataStream in(file.device());
+    if (!checkSectionedFile(in, toc.type))
+        return false;
+
+    return readSection(file.device(), toc.tables.at(index),
+        [&toc, &handler](QDataStream& in) -> bool
+        {
+            return readTableStream(in, toc.type, handler);
+        });
+}
+
+SaveInterface::DecodedTable SaveInterface::decodeTable(const QString& filePath, const TableOfContents& toc, int index)
+{
+    // The chunks are stored as they are read, the SQL tables are not used.
+    DecodedTable table = {};
+    OpenStreamHandler handler;
+    handler.beginTable = [&table](const QString& tableName) -> bool
+    {
+        table.tableName = tableName;
+        return true;
+    };
+    handler.itemsChunk = [&table](const QVariant& items) -> bool
+    {
+        table.itemsChunks.append(items);
+        return true;
+    };
+    handler.interfaceChunk = [&table](UtilityTableName tableName, const QList<Game::SaveUtilityInterfaceItem>& items) -> bool
+    {
+        table.interfaceChunks.append({tableName, items});
+        return true;
+    };
+    handler.sensitiveContentChunk = [&table](const QList<Game::SaveUtilitySensitiveContentItem>& items) -> bool
+    {
+        table.sensitiveContentChunks.append(items);
+        return true;
+    };
+    handler.endTable = [&table](const QVariant& tableData) -> bool
+    {
+        table.table = tableData;
+        return true;
+    };
+
+    table.isDecoded = openTable(filePath, toc, index, handler);
+    return table;
+}
+
+bool SaveInterface::replayTable(const DecodedTable& table, const OpenStreamHandler& handler)
+{
+    if (!table.isDecoded || !handler.beginTable(table.tableName))
+        return false;
+
+    for (const QVariant& items : table.itemsChunks)
+    {
+        if (!handler.itemsChunk(items))
+            return false;
+    }
+    for (const QPair<UtilityTableName, QList<Game::SaveUtilityInterfaceItem>>& items : table.interfaceChunks)
+    {
+        if (!handler.interfaceChunk(items.first, items.second))
+            return false;
+    }
+    for (const QList<Game::SaveUtilitySensitiveContentItem>& items : table.sensitiveContentChunks)
+    {
+        if (!handler.sensitiveContentChunk(items))
+            return false;
+    }
+
+    return handler.endTable(table.table);
+}
+
+bool SaveInterface::openTables(const QString& filePath, const TableOfContents& toc, const QList<int>& indexes, const std::function<bool(int index, const DecodedTable& table)>& readTable)
+{
+    for (int index : indexes)
+    {
+        if (index < 0 || index >= toc.tables.size())
+            return false;
+    }
+
+    // Each worker map the file on its own. The tables are decoded ahead of the table being read,
+    // so the memory used is bounded by the number of threads.
+    int maxDecoding = qMax(QThread::idealThreadCount(), 1);
+    QList<QFuture<DecodedTable>> decoding;
+    int nextIndex = 0;
+    auto decodeNext = [&]()
+    {
+        decoding.append(QtConcurrent::run(&SaveInterface::decodeTable, filePath, toc, indexes.at(nextIndex)));
+        nextIndex++;
+    };
+    while (nextIndex < indexes.size() && nextIndex < maxDecoding)
+        decodeNext();
+
+    bool result = true;
+    for (int i = 0; i < indexes.size() && result; i++)
+    {
+        DecodedTable table = decoding.at(i).result();
+        decoding[i] = QFuture<DecodedTable>();
+        if (nextIndex < indexes.size())
+            decodeNext();
+
+        // The tables are read in order on the calling thread.
+        result = table.isDecoded && readTable(indexes.at(i), table);
+    }
+
+    // If a table failed, the tables still being decoded are ignored.
+    for (QFuture<DecodedTable>& future : decoding)
+        future.waitForFinished();
+    return result;
+}
+
+bool SaveInterface::openUtility(const QString& filePath, const TableOfContents& toc, const OpenStreamHandler& handler)
+{
+    MappedFile file(filePath);
+    if (!file.open())
+        return false;
+
+    QDataStream in(file.device());
+    if (!checkSectionedFile(in, toc.type))
+        return false;
+
+    return readSection(file.device(), toc.utility,
+        [&toc, &handler](QDataStream& in) -> bool
+        {
+            return readUtilityStream(in, toc.type, handler);
+        });
+}
+
+ListType SaveInterface::readIdentifier(QDataStream& in)
+{
+    // Read the primary identifier
+    char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE];
+    for (int i = 0; i < PRIMARY_IDENTIFIER_SIZE; i++)
+        primaryIdentifier[i] = 0x00; // Initialize to null
+    in.readRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
+
+    // Check if the primary identifier is a valid.
+    char validPrimaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
+    if (strcmp(primaryIdentifier, validPrimaryIdentifier) != 0)
+        return ListType::UNKNOWN;
+
+    // Reading the identifier
+    char fileIdentifier[4] = {0,0,0,0};
+    in.readRawData(fileIdentifier, 3);
+
+    if (strcmp(fileIdentifier, GLD_IDENTIFIER) == 0)
+        return ListType::GAMELIST;
+    else if (strcmp(fileIdentifier, MLD_IDENTIFIER) == 0)
+        return ListType::MOVIESLIST;
+    else if (strcmp(fileIdentifier, CLD_IDENTIFIER) == 0)
+        return ListType::COMMONLIST;
+    else if (strcmp(fileIdentifier, BLD_IDENTIFIER) == 0)
+        return ListType::BOOKSLIST;
+    else if (strcmp(fileIdentifier, SLD_IDENTIFIER) == 0)
+        return ListType::SERIESLIST;
+    else
+        return ListType::UNKNOWN;
+}
+
+bool SaveInterface::readVersion(QDataStream& in, ListType type, FileFormat& format)
+{
+    // Reading the version of the file and checking if it's supported,
+    // the same checks than the openGame, openMovies, ... member functions.
+    int fileVersion;
+    in >> fileVersion;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    int minVersion, maxVersion, blockVersion, dictionaryVersion, sectionVersion, metadataVersion, legacyMaxVersion = -1;
+    switch (type)
+    {
+    case ListType::GAMELIST:
+        minVersion = GLD_LEGACY_VERSION;
+        maxVersion = GLD_VERSION_MAX_SUPPORT;
+        blockVersion = GLD_BLOCK_VERSION;
+        dictionaryVersion = GLD_DICTIONARY_VERSION;
+        sectionVersion = GLD_SECTION_VERSION;
+        metadataVersion = GLD_METADATA_VERSION;
+        legacyMaxVersion = GLD_LEGACY_MAX_SUPPORT;
+        break;
+    case ListType::MOVIESLIST:
+        minVersion = MLD_LEGACY_VERSION;
+        maxVersion = MLD_VERSION_MAX_SUPPORT;
+        blockVersion = MLD_BLOCK_VERSION;
+        dictionaryVersion = MLD_DICTIONARY_VERSION;
+        sectionVersion = MLD_SECTION_VERSION;
+        metadataVersion = MLD_METADATA_VERSION;
+        legacyMaxVersion = MLD_LEGACY_MAX_SUPPORT;
+        break;
+    case ListType::COMMONLIST:
+        minVersion = CLD_MIN_VERSION;
+        maxVersion = CLD_VERSION_MAX_SUPPORT;
+        blockVersion = CLD_BLOCK_VERSION;
+        dictionaryVersion = CLD_DICTIONARY_VERSION;
+        sectionVersion = CLD_SECTION_VERSION;
+        metadataVersion = CLD_METADATA_VERSION;
+        break;
+    case ListType::BOOKSLIST:
+        minVersion = BLD_MIN_VERSION;
+        maxVersion = BLD_VERSION_MAX_SUPPORT;
+        blockVersion = BLD_BLOCK_VERSION;
+        dictionaryVersion = BLD_DICTIONARY_VERSION;
+        sectionVersion = BLD_SECTION_VERSION;
+        metadataVersion = BLD_METADATA_VERSION;
+        break;
+    case ListType::SERIESLIST:
+        minVersion = SLD_MIN_VERSION;
+        maxVersion = SLD_VERSION_MAX_SUPPORT;
+        blockVersion = SLD_BLOCK_VERSION;
+        dictionaryVersion = SLD_DICTIONARY_VERSION;
+        sectionVersion = SLD_SECTION_VERSION;
+        metadataVersion = SLD_METADATA_VERSION;
+        break;
+    default:
+        return false;
+    }
+
+    if (fileVersion < minVersion || fileVersion >= maxVersion)
+        return false;
+
+    m_isLegacy = fileVersion < legacyMaxVersion;
+    format.isBlockCompressed = fileVersion >= blockVersion;
+    format.hasStringDictionary = fileVersion >= dictionaryVersion;
+    format.isSectioned = fileVersion >= sectionVersion;
+    format.hasMetadata = fileVersion >= metadataVersion;
+    return true;
+}
+
+bool SaveInterface::save(const QString& filePath, ListType type, const QList<SaveTableSection>& tables, const std::function<bool(QDataStream& out)>& writeUtility)
+{
+    if (filePath.isEmpty())
+        return false;
+
+    // Choosing the identifier and the version of the file.
+    const char* fileIdentifier;
+    int fileVersion;
+    switch (type)
+    {
+    case ListType::GAMELIST:
+        fileIdentifier = GLD_IDENTIFIER;
+        fileVersion = GLD_VERSION;
+        break;
+    case ListType::MOVIESLIST:
+        fileIdentifier = MLD_IDENTIFIER;
+        fileVersion = MLD_VERSION;
+        break;
+    case ListType::COMMONLIST:
+        fileIdentifier = CLD_IDENTIFIER;
+        fileVersion = CLD_VERSION;
+        break;
+    case ListType::BOOKSLIST:
+        fileIdentifier = BLD_IDENTIFIER;
+        fileVersion = BLD_VERSION;
+        break;
+    case ListType::SERIESLIST:
+        fileIdentifier = SLD_IDENTIFIER;
+        fileVersion = SLD_VERSION;
+        break;
+    default:
+        return false;
+    }
+
+    // Opening the file in write mode.
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+#ifndef NDEBUG
+        std::cerr << "Cannot save the list into the file: " << filePath.toLocal8Bit().constData() << std::endl;
+#endif
+        return false;
+    }
+
+    QDataStream out(&file);
+
+    // Writing the headers.
+    const char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
+    out.writeRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
+    out.writeRawData(fileIdentifier, 3);
+    out << fileVersion;
+    writeMetadata(out, tables);
+
+    // The offset of the table of contents is written once the sections are written.
+    qint64 tocOffsetPos = file.pos();
+    qint64 tocOffset = 0;
+    out << tocOffset;
+
+    // Writing each table, then the utility data, into its own section.
+    TableOfContents toc = {};
+    toc.type = type;
+    bool result = true;
+    for (const SaveTableSection& table : tables)
+    {
+        FileSection section = {};
+        section.tableName = table.tableName;
+        section.rowCount = table.rowCount;
+        if (table.sourceFilePath.isEmpty())
+            result = writeSection(&file, table.writeTable, section);
+        else
+            result = copySection(&file, table.sourceFilePath, table.sourceSection, section);
+        if (!result)
+            break;
+        toc.tables.append(section);
+    }
+    if (result)
+        result = writeSection(&file, writeUtility, toc.utility);
+
+    // Writing the table of contents, then its offset after the version.
+    if (result)
+    {
+        tocOffset = file.pos();
+        writeFileSection(out, toc.utility);
+        int tableCount = toc.tables.size();
+        out << tableCount;
+        for (const FileSection& section : toc.tables)
+            writeFileSection(out, section);
+        const unsigned char endCheck = 0xFF;
+        out << endCheck;
+
+        result = file.seek(tocOffsetPos);
+        out << tocOffset;
+    }
+
+    // If anything failed, the file on the disk is not modified.
+    if (!result || out.status() != QDataStream::Ok)
+    {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+void SaveInterface::writeMetadata(QDataStream& out, const QList<SaveTableSection>& tables)
+{
+    // The metadata are written into a buffer, the tables are listed until the block is full.
+    QByteArray metadata;
+    QDataStream metadataOut(&metadata, QIODevice::WriteOnly);
+    const int headerSize = (int)(sizeof(quint32) * 2);
+
+    long long int itemCount = 0;
+    for (const SaveTableSection& table : tables)
+        itemCount += table.rowCount;
+    metadataOut << QDateTime::currentMSecsSinceEpoch();
+    metadataOut << (int)tables.size();
+    metadataOut << itemCount;
+
+    QByteArray tablesData;
+    int listedTables = 0;
+    for (const SaveTableSection& table : tables)
+    {
+        QByteArray tableData;
+        QDataStream tableOut(&tableData, QIODevice::WriteOnly);
+        tableOut << table.tableName.left(FILE_METADATA_NAME_SIZE);
+        tableOut << table.rowCount;
+        QStringList topItems;
+        for (int i = 0; i < table.topItems.size() && i < FILE_METADATA_TOP_ITEMS; i++)
+            topItems.append(table.topItems.at(i).left(FILE_METADATA_NAME_SIZE));
+        tableOut << topItems;
+
+        // The size of listedTables is added to the size of the metadata.
+        if (headerSize + metadata.size() + (int)sizeof(int) + tablesData.size() + tableData.size() > FILE_METADATA_SIZE)
+            break;
+        tablesData.append(tableData);
+        listedTables++;
+    }
+    metadataOut << listedTables;
+    metadata.append(tablesData);
+
+    // Writing the size and the checksum of the metadata, then padding the block with zeros.
+    out << (quint32)metadata.size();
+    out << blockChecksum(metadata.constData(), metadata.size());
+    out.writeRawData(metadata.constData(), metadata.size());
+    QByteArray padding(FILE_METADATA_SIZE - headerSize - metadata.size(), '\0');
+    out.writeRawData(padding.constData(), padding.size());
+}
+
+bool SaveInterface::readFileVersion(const QString& filePath, ListType& type, int& version)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    type = readIdentifier(in);
+    in >> version;
+    return type != ListType::UNKNOWN && in.status() == QDataStream::Ok;
+}
+
+int SaveInterface::currentVersion(ListType type)
+{
+    switch (type)
+    {
+    case ListType::GAMELIST:
+        return GLD_VERSION;
+    case ListType::MOVIESLIST:
+        return MLD_VERSION;
+    case ListType::COMMONLIST:
+        return CLD_VERSION;
+    case ListType::BOOKSLIST:
+        return BLD_VERSION;
+    case ListType::SERIESLIST:
+        return SLD_VERSION;
+    default:
+        return -1;
+    }
+}
+
+bool SaveInterface::readMetadata(const QString& filePath, FileMetadata& metadata)
+{
+    // Only the headers and the metadata block are read, not the whole file.
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    FileFormat format = {};
+    metadata.type = readIdentifier(in);
+    if (metadata.type == ListType::UNKNOWN || !readVersion(in, metadata.type, format) || !format.hasMetadata)
+        return false;
+
+    quint32 size, checksum;
+    in >> size;
+    in >> checksum;
+    if (in.status() != QDataStream::Ok || size > (quint32)(FILE_METADATA_SIZE - sizeof(quint32) * 2))
+        return false;
+    QByteArray bytes(size, Qt::Uninitialized);
+    if (in.readRawData(bytes.data(), size) != (int)size ||
+        blockChecksum(bytes.constData(), bytes.size()) != checksum)
+        return false;
+
+    QDataStream metadataIn(bytes);
+    qint64 saveTime;
+    int listedTables;
+    metadataIn >> saveTime;
+    metadataIn >> metadata.tableCount;
+    metadataIn >> metadata.itemCount;
+    metadataIn >> listedTables;
+    if (metadataIn.status() != QDataStream::Ok || listedTables < 0 || listedTables > metadata.tableCount)
+        return false;
+    metadata.saveTime = QDateTime::fromMSecsSinceEpoch(saveTime);
+
+    metadata.tables.clear();
+    for (int i = 0; i < listedTables; i++)
+    {
+        FileMetadataTable table = {};
+        metadataIn >> table.tableName;
+        metadataIn >> table.rowCount;
+        metadataIn >> table.topItems;
+        if (metadataIn.status() != QDataStream::Ok)
+            return false;
+        metadata.tables.append(table);
+    }
+    return true;
+}
+
+bool SaveInterface::updateMetadata(const QString& filePath, const QList<SaveTableSection>& tables)
+{
+    // The block is written at its position after the version. If the write is interrupted,
+    // the checksum of the block does not match: the preview is lost, not the list.
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadWrite))
+        return false;
+
+    QDataStream in(&file);
+    FileFormat format = {};
+    ListType type = readIdentifier(in);
+    if (type == ListType::UNKNOWN || !readVersion(in, type, format) || !format.hasMetadata)
+        return false;
+    qint64 metadataPos = file.pos();
+
+    QByteArray block;
+    QDataStream blockOut(&block, QIODevice::WriteOnly);
+    writeMetadata(blockOut, tables);
+    if (block.size() != FILE_METADATA_SIZE || !file.seek(metadataPos))
+        return false;
+
+    return file.write(block) == block.size() && file.flush();
+}
+
+bool SaveInterface::writeQuery(QDataStream& out, QSqlDatabase& db, const QString& statement, const std::function<void(QDataStream& out, const QSqlQuery& query)>& writeRow)
+{
+    // The number of rows is written before the rows, so it's queried first.
+    QString countStatement = statement.trimmed();
+    if (countStatement.endsWith(';'))
+        countStatement.chop(1);
+    countStatement = QString("SELECT COUNT(*) FROM (\n%1\n);").arg(countStatement);
+
+    QSqlQuery query(db);
+    if (!query.exec(countStatement) || !query.next())
+    {
+        std::cerr << QString("Failed to count the rows of the statement:\n%1\n\t%2")
+            .arg(statement, query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+        return false;
+    }
+    long long int count = query.value(0).toLongLong();
+    query.clear();
+    out << count;
+
+    // The query is forward only, so the rows are not cached by the driver.
+    query.setForwardOnly(true);
+    if (!query.exec(statement))
+    {
+        std::cerr << QString("Failed to query the statement:\n%1\n\t%2")
+            .arg(statement, query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+        return false;
+    }
+
+    long long int rowsWritten = 0;
+    while (query.next())
+    {
+        writeRow(out, query);
+        rowsWritten++;
+    }
+    query.clear();
+
+    // If the count is not the same, the file would be corrupted.
+    return rowsWritten == count;
+}
+
 bool SaveInterface::isLegacy()
 {
     return m_isLegacy;
 }
 
+void SaveInterface::writeString(QDataStream& out, const QString& str, StringChannel channel)
+{
+    if (m_stringDictionary)
+        m_stringDictionary->write(out, str, channel);
+    else
+        out << str;
+}
+
+void SaveInterface::readString(QDataStream& in, QString& str, StringChannel channel)
+{
+    if (!m_stringDictionary)
+        in >> str;
+    else if (in.status() == QDataStream::Ok && !m_stringDictionary->read(in, str, channel))
+        in.setStatus(QDataStream::ReadCorruptData);
+}
+
 // Item utility data
 QDataStream& operator<<(QDataStream& out, const ItemUtilityData& data)
 {
@@ -115,7 +1075,7 @@ QDataStream& operator<<(QDataStream& out, const ItemUtilityData& data)
     // Writing the position of the item in the list.
     out << data.order;
     // Then, writing the QString name;
-    out << data.name;
+    SaveInterface::writeString(out, data.name, StringChannel::UTILITY_NAME);
 
     // Returning the dataStream.
     return out;
@@ -129,7 +1089,7 @@ QDataStream& operator>>(QDataStream& in, ItemUtilityData& data)
     // Reading the position of the item in the list.
     in >> data.order;
     // Reading the QString name.
-    in >> data.name;
+    SaveInterface::readString(in, data.name, StringChannel::UTILITY_NAME);
 
     return in;
 }
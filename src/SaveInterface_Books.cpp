@@ -33,43 +33,27 @@ bool SaveInterface::saveBooksList(const QString& filePath, const QVariant& varia
     // Retrieving the data from the QVariant.
     Books::SaveData data = qvariant_cast<Books::SaveData>(variant);
 
-    // Opening the file in write mode.
-    QSaveFile file(filePath);
-    if (file.open(QIODevice::WriteOnly))
+    // Each table is written into its own section, then the utility data.
+    // The headers, the table of contents and the end checks are written by save.
+    QList<SaveTableSection> tables;
+    tables.reserve(data.booksTables.size());
+    for (const Books::SaveDataTable& table : data.booksTables)
     {
-        QDataStream out(&file);
-
-        // Headers
-        // Primary indentifier.
-        const char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
-        out.writeRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
-
-        // Identifier
-        const char* fileIdentifier = BLD_IDENTIFIER;
-        out.writeRawData(fileIdentifier, 3);
-
-        // Version
-        int fileVersion = BLD_VERSION;
-        out << fileVersion;
-
-        // Writing books data.
-        out << data;
-
-        // OxFF at the end of the file.
-        const unsigned char endCheck = 0xFF;
-        out << endCheck;
-
-        if (!file.commit())
-            return false;
-        return true;
-    }
-    else
-    {
-#ifndef NDEBUG
-    std::cerr << "Cannot save the books list into the file: " << filePath.toLocal8Bit().constData() << std::endl;
-#endif
-        return false;
+        tables.append({table.tableName, table.booksList.size(),
+            [&table](QDataStream& out) -> bool
+            {
+                out << table;
+                return true;
+            },
+            topItems(table.booksList)});
     }
+
+    return save(filePath, ListType::BOOKSLIST, tables,
+        [&data](QDataStream& out) -> bool
+        {
+            out << data.utilityData;
+            return true;
+        });
 }
 
 bool SaveInterface::openBooksList(QDataStream* in, QVariant& variant)
@@ -81,21 +65,39 @@ bool SaveInterface::openBooksList(QDataStream* in, QVariant& variant)
     // Version
     int fileVersion;
     *in >> fileVersion;
-    if (fileVersion >= BLD_VERSION && fileVersion < BLD_VERSION_MAX_SUPPORT)
+    if (fileVersion >= BLD_MIN_VERSION && fileVersion < BLD_VERSION_MAX_SUPPORT)
     {
         if (in->atEnd())
             return false;
         
-        // Data
+        // Reading the data, the payload is decompressed if it's a block compressed file
+        // and the strings are decoded if it's a dictionary encoded file.
+        // A sectioned file is read section by section.
         Books::SaveData data = {};
-        *in >> data;
-        if (in->atEnd())
-            return false;
-        
-        // 0xFF at the end of the file.
-        unsigned char endCheck;
-        *in >> endCheck;
-        if (endCheck != 0xFF)
+        FileFormat format = {fileVersion >= BLD_BLOCK_VERSION, fileVersion >= BLD_DICTIONARY_VERSION, fileVersion >= BLD_SECTION_VERSION, fileVersion >= BLD_METADATA_VERSION};
+        bool result;
+        if (format.isSectioned)
+            result = readSections(in, ListType::BOOKSLIST, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    Books::SaveDataTable table = {};
+                    in >> table;
+                    data.booksTables.append(table);
+                    return true;
+                },
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data.utilityData;
+                    return true;
+                });
+        else
+            result = readPayload(in, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data;
+                    return true;
+                });
+        if (!result)
             return false;
         
         // Store the data into the variant.
@@ -140,46 +142,15 @@ QDataStream& operator<<(QDataStream& out, const Books::SaveUtilityData& data)
 QDataStream& operator>>(QDataStream& in, Books::SaveUtilityData& data)
 {
     // Reading the SQL Utility data from the data stream.
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.series.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.series[i];
-    }
+    readList(in, data.series);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.authors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.authors[i];
-    }
+    readList(in, data.authors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.publishers.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.publishers[i];
-    }
+    readList(in, data.publishers);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
     return in;
 }
@@ -223,54 +194,17 @@ QDataStream& operator<<(QDataStream& out, const Books::SaveUtilityInterfaceData&
 QDataStream& operator>>(QDataStream& in, Books::SaveUtilityInterfaceData& data)
 {
     // Reading the books list utility interface data.
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.series.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.series[i];
-    }
+    readList(in, data.series);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.authors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.authors[i];
-    }
+    readList(in, data.authors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.publishers.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.publishers[i];
-    }
+    readList(in, data.publishers);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.sensitiveContent.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.sensitiveContent[i];
-    }
+    readList(in, data.sensitiveContent);
 
     return in;
 }
@@ -291,14 +225,7 @@ QDataStream& operator<<(QDataStream& out, const Books::SaveData& data)
 QDataStream& operator>>(QDataStream& in, Books::SaveData& data)
 {
     // Reading the Books::SaveData from the data stream.
-    int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.booksTables.resize(count);
-        for (int i = 0; i < count; i++)
-            in >> data.booksTables[i];
-    }
+    readList<int>(in, data.booksTables);
 
     in >> data.utilityData;
 
@@ -325,14 +252,7 @@ QDataStream& operator>>(QDataStream& in, Books::SaveDataTable& data)
 {
     // Readig the Books::SaveDataTable from the data stream.
     in >> data.tableName;
-    long long int  count;
-    in >> count;
-    if (count > 0)
-    {
-        data.booksList.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.booksList[i];
-    }
+    readList(in, data.booksList);
     in >> data.interface;
     in >> data.viewColumnsSize;
     in >> data.columnSort;
@@ -346,8 +266,8 @@ QDataStream& operator<<(QDataStream& out, const Books::SaveItem& data)
     // Writing the Books::SaveItem into the data stream.
     out << data.bookID;
     out << data.bookPos;
-    out << data.name;
-    out << data.url;
+    SaveInterface::writeString(out, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::writeString(out, data.url, StringChannel::ITEM_URL);
     unsigned char rate = data.rate;
     out << rate;
     return out;
@@ -358,8 +278,8 @@ QDataStream& operator>>(QDataStream& in, Books::SaveItem& data)
     // Reading the Books::SaveItem from the data stream.
     in >> data.bookID;
     in >> data.bookPos;
-    in >> data.name;
-    in >> data.url;
+    SaveInterface::readString(in, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::readString(in, data.url, StringChannel::ITEM_URL);
     unsigned char rate;
     in >> rate;
     data.rate = rate;
@@ -33,43 +33,27 @@ bool SaveInterface::saveCommonList(const QString& filePath, const QVariant& vari
     // Retrieving the data from the QVariant.
     Common::SaveData data = qvariant_cast<Common::SaveData>(variant);
 
-    // Opening the file in write mode.
-    QSaveFile file(filePath);
-    if (file.open(QIODevice::WriteOnly))
+    // Each table is written into its own section, then the utility data.
+    // The headers, the table of contents and the end checks are written by save.
+    QList<SaveTableSection> tables;
+    tables.reserve(data.commonTables.size());
+    for (const Common::SaveDataTable& table : data.commonTables)
     {
-        QDataStream out(&file);
-
-        // Headers
-        // Primary identifier.
-        const char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
-        out.writeRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
-
-        // Identifier
-        const char* fileIdentifier = CLD_IDENTIFIER;
-        out.writeRawData(fileIdentifier, 3);
-
-        // Version
-        int fileVersion = CLD_VERSION;
-        out << fileVersion;
-
-        // Writing commons data.
-        out << data;
-
-        // OxFF at the end of the file.
-        const unsigned char endCheck = 0xFF;
-        out << endCheck;
-
-        if (!file.commit())
-            return false;
-        return true;
-    }
-    else
-    {
-#ifndef NDEBUG
-        std::cerr << "Cannot save the common list into the file: " << filePath.toLocal8Bit().constData() << std::endl;
-#endif
-        return false;
+        tables.append({table.tableName, table.commonList.size(),
+            [&table](QDataStream& out) -> bool
+            {
+                out << table;
+                return true;
+            },
+            topItems(table.commonList)});
     }
+
+    return save(filePath, ListType::COMMONLIST, tables,
+        [&data](QDataStream& out) -> bool
+        {
+            out << data.utilityData;
+            return true;
+        });
 }
 
 bool SaveInterface::openCommonList(QDataStream* in, QVariant& variant)
@@ -81,21 +65,39 @@ bool SaveInterface::openCommonList(QDataStream* in, QVariant& variant)
     // Version
     int fileVersion;
     *in  >> fileVersion;
-    if (fileVersion >= CLD_VERSION && fileVersion < CLD_VERSION_MAX_SUPPORT)
+    if (fileVersion >= CLD_MIN_VERSION && fileVersion < CLD_VERSION_MAX_SUPPORT)
     {
         if (in->atEnd())
             return false;
         
-        // Data
+        // Reading the data, the payload is decompressed if it's a block compressed file
+        // and the strings are decoded if it's a dictionary encoded file.
+        // A sectioned file is read section by section.
         Common::SaveData data = {};
-        *in >> data;
-        if (in->atEnd())
-            return false;
-        
-        // OxFF at the end of the file.
-        unsigned char endFile;
-        *in >> endFile;
-        if (endFile != 0xFF)
+        FileFormat format = {fileVersion >= CLD_BLOCK_VERSION, fileVersion >= CLD_DICTIONARY_VERSION, fileVersion >= CLD_SECTION_VERSION, fileVersion >= CLD_METADATA_VERSION};
+        bool result;
+        if (format.isSectioned)
+            result = readSections(in, ListType::COMMONLIST, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    Common::SaveDataTable table = {};
+                    in >> table;
+                    data.commonTables.append(table);
+                    return true;
+                },
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data.utilityData;
+                    return true;
+                });
+        else
+            result = readPayload(in, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data;
+                    return true;
+                });
+        if (!result)
             return false;
         
         // Store the data into the variant.
@@ -130,30 +132,11 @@ QDataStream& operator<<(QDataStream& out, const Common::SaveUtilityData& data)
 QDataStream& operator>>(QDataStream& in, Common::SaveUtilityData& data)
 {
     // Reading the SQL Utility data from the data stream.
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.series.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.series[i];
-    }
+    readList(in, data.series);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.authors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.authors[i];
-    }
+    readList(in, data.authors);
 
     return in;
 }
@@ -187,38 +170,13 @@ QDataStream& operator<<(QDataStream& out, const Common::SaveUtilityInterfaceData
 QDataStream& operator>>(QDataStream& in, Common::SaveUtilityInterfaceData& data)
 {
     // Reading the commons list utility interface data.
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.series.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.series[i];
-    }
+    readList(in, data.series);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.authors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.authors[i];
-    }
+    readList(in, data.authors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.sensitiveContent.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.sensitiveContent[i];
-    }
+    readList(in, data.sensitiveContent);
 
     return in;
 }
@@ -239,14 +197,7 @@ QDataStream& operator<<(QDataStream& out, const Common::SaveData& data)
 QDataStream& operator>>(QDataStream& in, Common::SaveData& data)
 {
     // Reading the Common::SaveData from the data stream.
-    int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.commonTables.resize(count);
-        for (int i = 0; i < count; i++)
-            in >> data.commonTables[i];
-    }
+    readList<int>(in, data.commonTables);
 
     in >> data.utilityData;
 
@@ -273,14 +224,7 @@ QDataStream& operator>>(QDataStream& in, Common::SaveDataTable& data)
 {
     // Readig the Common::SaveDataTable from the data stream.
     in >> data.tableName;
-    long long int  count;
-    in >> count;
-    if (count > 0)
-    {
-        data.commonList.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.commonList[i];
-    }
+    readList(in, data.commonList);
     in >> data.interface;
     in >> data.viewColumnsSize;
     in >> data.columnSort;
@@ -294,8 +238,8 @@ QDataStream& operator<<(QDataStream& out, const Common::SaveItem& data)
     // Writing the Common::SaveItem into the data stream.
     out << data.commonID;
     out << data.commonPos;
-    out << data.name;
-    out << data.url;
+    SaveInterface::writeString(out, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::writeString(out, data.url, StringChannel::ITEM_URL);
     unsigned char rate = data.rate;
     out << rate;
     return out;
@@ -306,8 +250,8 @@ QDataStream& operator>>(QDataStream& in, Common::SaveItem& data)
     // Reading the Common::SaveItem from the data stream.
     in >> data.commonID;
     in >> data.commonPos;
-    in >> data.name;
-    in >> data.url;
+    SaveInterface::readString(in, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::readString(in, data.url, StringChannel::ITEM_URL);
     unsigned char rate;
     in >> rate;
     data.rate = rate;
@@ -28,52 +28,35 @@
 #include <iostream>
 #include <cstring>
 
-bool SaveInterface::m_isLegacy = false;
+thread_local bool SaveInterface::m_isLegacy = false;
+thread_local StringDictionary* SaveInterface::m_stringDictionary = nullptr;
 
 bool SaveInterface::saveGame(const QString& filePath, const QVariant& variant)
 {
     // Retrieving the data from the QVariant.
     Game::SaveData data = qvariant_cast<Game::SaveData>(variant);
 
-    // Opening the file in write mode.
-    QSaveFile file(filePath);
-    if (file.open(QIODevice::WriteOnly))
+    // Each table is written into its own section, then the utility data.
+    // The headers, the table of contents and the end checks are written by save.
+    QList<SaveTableSection> tables;
+    tables.reserve(data.gameTables.size());
+    for (const Game::SaveDataTable& table : data.gameTables)
     {
-        // Streaming into the file.
-        QDataStream out(&file);
-
-        // Writing the headers.
-        // Write the primary identifier
-        const char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
-        out.writeRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
-
-        // Writing the identifier
-        const char* fileIdentifier = GLD_IDENTIFIER;
-        out.writeRawData(fileIdentifier, 3);
-
-        // Writing the version of the file.
-        int fileVersion = GLD_VERSION;
-        out << fileVersion;
-
-        // Writing the data of the game list.
-        out << data;
-
-        // The last things, writing at the and of a file a unsigned char of value 0xFF (255),
-        // it's used to check if the file has been loaded correctly.
-        const unsigned char endCheck = 0xFF;
-        out << endCheck;
-
-        if (!file.commit())
-            return false;
-        return true;
-    }
-    else
-    {
-#ifndef NDEBUG
-        std::cerr << "Cannot save the game into the file: " << filePath.toLocal8Bit().constData() << std::endl;
-#endif
-        return false;
+        tables.append({table.tableName, table.gameList.size(),
+            [&table](QDataStream& out) -> bool
+            {
+                out << table;
+                return true;
+            },
+            topItems(table.gameList)});
     }
+
+    return save(filePath, ListType::GAMELIST, tables,
+        [&data](QDataStream& out) -> bool
+        {
+            out << data.utilityData;
+            return true;
+        });
 }
 
 bool SaveInterface::openGame(QDataStream* in, QVariant& variant)
@@ -96,17 +79,34 @@ bool SaveInterface::openGame(QDataStream* in, QVariant& variant)
         else
             m_isLegacy = false;
         
-        // Reading the data.
+        // Reading the data, the payload is decompressed if it's a block compressed file
+        // and the strings are decoded if it's a dictionary encoded file.
+        // A sectioned file is read section by section.
         Game::SaveData data = {};
-        *in >> data;
-        if (in->atEnd())
-            return false;
-
-        // Retrieve the unsigned char and check if is value is equal to 0x55 (255).
-        // If it's not true, it's mean the file is not loaded correctly.
-        unsigned char endFile;
-        *in >> endFile;
-        if (endFile != 0xFF)
+        FileFormat format = {fileVersion >= GLD_BLOCK_VERSION, fileVersion >= GLD_DICTIONARY_VERSION, fileVersion >= GLD_SECTION_VERSION, fileVersion >= GLD_METADATA_VERSION};
+        bool result;
+        if (format.isSectioned)
+            result = readSections(in, ListType::GAMELIST, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    Game::SaveDataTable table = {};
+                    in >> table;
+                    data.gameTables.append(table);
+                    return true;
+                },
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data.utilityData;
+                    return true;
+                });
+        else
+            result = readPayload(in, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data;
+                    return true;
+                });
+        if (!result)
             return false;
         
         // Set the data into the variant.
@@ -166,62 +166,22 @@ QDataStream& operator>>(QDataStream& in, Game::SaveUtilityData& data)
     // Reading the Item SQL Utility data from the data stream.
     // Categories
     // Reading the number of rows.
-    long long int count;
     if (!SaveInterface::isLegacy())
-    {
-        in >> count;
-        if (count > 0)
-        {
-            // Then, reading each row.
-            data.series.resize(count);
-            for (long long int i = 0; i < count; i++)
-                in >> data.series[i];
-        }
-    }
+        readList(in, data.series);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
     // Developpers
-    in >> count;
-    if (count > 0)
-    {
-        data.developpers.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.developpers[i];
-    }
+    readList(in, data.developpers);
 
     // Publishers
-    in >> count;
-    if (count > 0)
-    {
-        data.publishers.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.publishers[i];
-    }
+    readList(in, data.publishers);
 
     // Platform
-    in >> count;
-    if (count > 0)
-    {
-        data.platform.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.platform[i];
-    }
+    readList(in, data.platform);
 
     // Services
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
     return in;
 }
@@ -278,71 +238,26 @@ QDataStream& operator>>(QDataStream& in, Game::SaveUtilityInterfaceData& data)
 {
     // Reading the game list utility interface data from the data stream.
     // Series
-    long long int count;
     if (!SaveInterface::isLegacy())
-    {
-        in >> count;
-        if (count > 0)
-        {
-            data.series.resize(count);
-            for (long long int i = 0; i < count; i++)
-                in >> data.series[i];
-        }
-    }
+        readList(in, data.series);
 
     // Categories
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
     // Developpers
-    in >> count;
-    if (count > 0)
-    {
-        data.developpers.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.developpers[i];
-    }
+    readList(in, data.developpers);
 
     // Publishers
-    in >> count;
-    if (count > 0)
-    {
-        data.pubishers.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.pubishers[i];
-    }
+    readList(in, data.pubishers);
 
     // Platform
-    in >> count;
-    if (count > 0)
-    {
-        data.platform.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.platform[i];
-    }
+    readList(in, data.platform);
 
     // Services
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
     // Sensitive content
-    in >> count;
-    if (count > 0)
-    {
-        data.sensitiveContent.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.sensitiveContent[i];
-    }
+    readList(in, data.sensitiveContent);
 
     return in;
 }
@@ -370,14 +285,7 @@ QDataStream& operator>>(QDataStream& in, Game::SaveData& data)
 
     // Reading the games tables.
     // Retrieve the number of tables.
-    int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.gameTables.resize(count);
-        for (int i = 0; i < count; i++)
-            in >> data.gameTables[i];
-    }
+    readList<int>(in, data.gameTables);
 
     // Reading the Item SQL Utility data.
     in >> data.utilityData;
@@ -419,16 +327,7 @@ QDataStream& operator>>(QDataStream& in, Game::SaveDataTable& data)
     in >> data.tableName;
     // Reading the games item.
     // Reading the number of games.
-    long long int count;
-    in >> count;
-
-    // Reading the data.
-    if (count > 0)
-    {
-        data.gameList.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.gameList[i];
-    }
+    readList(in, data.gameList);
 
     // Reading the utility interface data.
     in >> data.interface;
@@ -448,8 +347,8 @@ QDataStream& operator<<(QDataStream& out, const Game::SaveItem& data)
     // Writing Game::SaveItem into a data stream.
     out << data.gameID;
     out << data.gamePos;
-    out << data.name;
-    out << data.url;
+    SaveInterface::writeString(out, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::writeString(out, data.url, StringChannel::ITEM_URL);
     unsigned char rate = data.rate;
     out << rate;
     return out;
@@ -460,8 +359,8 @@ QDataStream& operator>>(QDataStream& in, Game::SaveItem& data)
     // Reading Game::SaveItem form the data stream.
     in >> data.gameID;
     in >> data.gamePos;
-    in >> data.name;
-    in >> data.url;
+    SaveInterface::readString(in, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::readString(in, data.url, StringChannel::ITEM_URL);
     unsigned char rate;
     in >> rate;
     data.rate = rate;
@@ -30,46 +30,30 @@
 
 bool SaveInterface::saveMovies(const QString& filePath, const QVariant& variant)
 {
-    // Retreving the data from the QVariant.
+    // Retrieving the data from the QVariant.
     Movie::SaveData data = qvariant_cast<Movie::SaveData>(variant);
 
-    // Opening the file in write mode.
-    QSaveFile file(filePath);
-    if (file.open(QIODevice::WriteOnly))
+    // Each table is written into its own section, then the utility data.
+    // The headers, the table of contents and the end checks are written by save.
+    QList<SaveTableSection> tables;
+    tables.reserve(data.movieTables.size());
+    for (const Movie::SaveDataTable& table : data.movieTables)
     {
-        QDataStream out(&file);
-
-        // Headers.
-        // Primary identifier.
-        const char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
-        out.writeRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
-
-        // Identifier
-        const char* fileIdentifier = MLD_IDENTIFIER;
-        out.writeRawData(fileIdentifier, 3);
-
-        // Version
-        int fileVersion = MLD_VERSION;
-        out << fileVersion;
-
-        // Writing movies data.
-        out << data;
-
-        // 0xFF at the end of the file.
-        const unsigned char endCheck = 0xFF;
-        out << endCheck;
-
-        if (!file.commit())
-            return false;
-        return true;
-    }
-    else
-    {
-#ifndef NDEBUG
-        std::cerr << "Canot save the movie into the file: " << filePath.toLocal8Bit().constData() << std::endl;
-#endif
-        return false;
+        tables.append({table.tableName, table.movieList.size(),
+            [&table](QDataStream& out) -> bool
+            {
+                out << table;
+                return true;
+            },
+            topItems(table.movieList)});
     }
+
+    return save(filePath, ListType::MOVIESLIST, tables,
+        [&data](QDataStream& out) -> bool
+        {
+            out << data.utilityData;
+            return true;
+        });
 }
 
 bool SaveInterface::openMovies(QDataStream* in, QVariant& variant)
@@ -92,16 +76,34 @@ bool SaveInterface::openMovies(QDataStream* in, QVariant& variant)
         else
             m_isLegacy = false;
         
-        // Data.
+        // Reading the data, the payload is decompressed if it's a block compressed file
+        // and the strings are decoded if it's a dictionary encoded file.
+        // A sectioned file is read section by section.
         Movie::SaveData data = {};
-        *in >> data;
-        if (in->atEnd())
-            return false;
-        
-        // 0xFF at the end of the file.
-        unsigned char endFile;
-        *in >> endFile;
-        if (endFile != 0xFF)
+        FileFormat format = {fileVersion >= MLD_BLOCK_VERSION, fileVersion >= MLD_DICTIONARY_VERSION, fileVersion >= MLD_SECTION_VERSION, fileVersion >= MLD_METADATA_VERSION};
+        bool result;
+        if (format.isSectioned)
+            result = readSections(in, ListType::MOVIESLIST, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    Movie::SaveDataTable table = {};
+                    in >> table;
+                    data.movieTables.append(table);
+                    return true;
+                },
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data.utilityData;
+                    return true;
+                });
+        else
+            result = readPayload(in, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data;
+                    return true;
+                });
+        if (!result)
             return false;
         
         // Store the data into the variant.
@@ -156,65 +158,20 @@ QDataStream& operator<<(QDataStream& out, const Movie::SaveUtilityData& data)
 QDataStream& operator>>(QDataStream& in, Movie::SaveUtilityData& data)
 {
     // Reading the SQL Utility data from the data stream.
-    long long int count;
     if (!SaveInterface::isLegacy())
-    {
-        in >> count;
-        if (count > 0)
-        {
-            data.series.resize(count);
-            for (long long int i = 0; i < count; i++)
-                in >> data.series[i];
-        }
-    }
+        readList(in, data.series);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.directors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.directors[i];
-    }
+    readList(in, data.directors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.actors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.actors[i];
-    }
+    readList(in, data.actors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.productions.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.productions[i];
-    }
+    readList(in, data.productions);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.music.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.music[i];
-    }
+    readList(in, data.music);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
     return in;
 }
@@ -268,73 +225,22 @@ QDataStream& operator<<(QDataStream& out, const Movie::SaveUtilityInterfaceData&
 QDataStream& operator>>(QDataStream& in, Movie::SaveUtilityInterfaceData& data)
 {
     // Reading the movies list utility interface data.
-    long long int count;
     if (!SaveInterface::isLegacy())
-    {
-        in >> count;
-        if (count > 0)
-        {
-            data.series.resize(count);
-            for (long long int i = 0; i < count; i++)
-                in >> data.series[i];
-        }
-    }
+        readList(in, data.series);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.directors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.directors[i];
-    }
+    readList(in, data.directors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.actors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.actors[i];
-    }
+    readList(in, data.actors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.productions.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.productions[i];
-    }
+    readList(in, data.productions);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.music.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.music[i];
-    }
+    readList(in, data.music);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.sensitiveContent.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.sensitiveContent[i];
-    }
+    readList(in, data.sensitiveContent);
 
     return in;
 }
@@ -356,14 +262,7 @@ QDataStream& operator<<(QDataStream& out, const Movie::SaveData& data)
 QDataStream& operator>>(QDataStream& in, Movie::SaveData& data)
 {
     // Reading the Movie::SaveData from the data stream.
-    int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.movieTables.resize(count);
-        for (int i = 0; i < count; i++)
-            in >> data.movieTables[i];
-    }
+    readList<int>(in, data.movieTables);
 
     in >> data.utilityData;
 
@@ -390,14 +289,7 @@ QDataStream& operator>>(QDataStream& in, Movie::SaveDataTable& data)
 {
     // Reading the Movie::SaveDataTable from the data stream.
     in >> data.tableName;
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.movieList.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.movieList[i];
-    }
+    readList(in, data.movieList);
     in >> data.interface;
     in >> data.viewColumnsSize;
     in >> data.columnSort;
@@ -411,8 +303,8 @@ QDataStream& operator<<(QDataStream& out, const Movie::SaveItem& data)
     // Writing the Movie::SaveItem into the data stream.
     out << data.movieID;
     out << data.moviePos;
-    out << data.name;
-    out << data.url;
+    SaveInterface::writeString(out, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::writeString(out, data.url, StringChannel::ITEM_URL);
     unsigned char rate = data.rate;
     out << rate;
     return out;
@@ -423,8 +315,8 @@ QDataStream& operator>>(QDataStream& in, Movie::SaveItem& data)
     // Reading the Movie::SaveItem from the data stream.
     in >> data.movieID;
     in >> data.moviePos;
-    in >> data.name;
-    in >> data.url;
+    SaveInterface::readString(in, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::readString(in, data.url, StringChannel::ITEM_URL);
     unsigned char rate;
     in >> rate;
     data.rate = rate;
@@ -33,43 +33,27 @@ bool SaveInterface::saveSeriesList(const QString& filePath, const QVariant& vari
     // Retrieving the data from the QVariant.
     Series::SaveData data = qvariant_cast<Series::SaveData>(variant);
 
-    // Opening the file in write mode.
-    QSaveFile file(filePath);
-    if (file.open(QIODevice::WriteOnly))
+    // Each table is written into its own section, then the utility data.
+    // The headers, the table of contents and the end checks are written by save.
+    QList<SaveTableSection> tables;
+    tables.reserve(data.serieTables.size());
+    for (const Series::SaveDataTable& table : data.serieTables)
     {
-        QDataStream out(&file);
-
-        // Headers
-        // Primary identifier.
-        const char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
-        out.writeRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
-
-        // Identifier
-        const char* fileIdentifier = SLD_IDENTIFIER;
-        out.writeRawData(fileIdentifier, 3);
-
-        // Version
-        int fileVersion = SLD_VERSION;
-        out << fileVersion;
-
-        // Writing series data.
-        out << data;
-
-        // 0xFF at the end of the file.
-        const unsigned char endCheck = 0xFF;
-        out << endCheck;
-
-        if (!file.commit())
-            return false;
-        return true;
-    }
-    else
-    {
-#ifndef NDEBUG
-        std::cerr << "Cannot save the series list into the file: " << filePath.toLocal8Bit().constData() << std::endl;
-#endif
-        return false;
+        tables.append({table.tableName, table.serieList.size(),
+            [&table](QDataStream& out) -> bool
+            {
+                out << table;
+                return true;
+            },
+            topItems(table.serieList)});
     }
+
+    return save(filePath, ListType::SERIESLIST, tables,
+        [&data](QDataStream& out) -> bool
+        {
+            out << data.utilityData;
+            return true;
+        });
 }
 
 bool SaveInterface::openSeriesList(QDataStream* in, QVariant& variant)
@@ -81,21 +65,39 @@ bool SaveInterface::openSeriesList(QDataStream* in, QVariant& variant)
     // Version
     int fileVersion;
     *in >> fileVersion;
-    if (fileVersion >= SLD_VERSION && fileVersion < SLD_VERSION_MAX_SUPPORT)
+    if (fileVersion >= SLD_MIN_VERSION && fileVersion < SLD_VERSION_MAX_SUPPORT)
     {
         if (in->atEnd())
             return false;
 
-        // Data
+        // Reading the data, the payload is decompressed if it's a block compressed file
+        // and the strings are decoded if it's a dictionary encoded file.
+        // A sectioned file is read section by section.
         Series::SaveData data = {};
-        *in >> data;
-        if (in->atEnd())
-            return false;
-        
-        // 0xFF at the end of the file.
-        unsigned char endFile;
-        *in >> endFile;
-        if (endFile != 0xFF)
+        FileFormat format = {fileVersion >= SLD_BLOCK_VERSION, fileVersion >= SLD_DICTIONARY_VERSION, fileVersion >= SLD_SECTION_VERSION, fileVersion >= SLD_METADATA_VERSION};
+        bool result;
+        if (format.isSectioned)
+            result = readSections(in, ListType::SERIESLIST, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    Series::SaveDataTable table = {};
+                    in >> table;
+                    data.serieTables.append(table);
+                    return true;
+                },
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data.utilityData;
+                    return true;
+                });
+        else
+            result = readPayload(in, format,
+                [&data](QDataStream& in) -> bool
+                {
+                    in >> data;
+                    return true;
+                });
+        if (!result)
             return false;
 
         // Store the data into the variant.
@@ -145,54 +147,17 @@ QDataStream& operator<<(QDataStream& out, const Series::SaveUtilityData& data)
 QDataStream& operator>>(QDataStream& in, Series::SaveUtilityData& data)
 {
     // Reading the SQL Utility data from the data stream.
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.directors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.directors[i];
-    }
+    readList(in, data.directors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.actors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.actors[i];
-    }
+    readList(in, data.actors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.production.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.production[i];
-    }
+    readList(in, data.production);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.music.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.music[i];
-    }
+    readList(in, data.music);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
     return in;
 }
@@ -241,62 +206,19 @@ QDataStream& operator<<(QDataStream& out, const Series::SaveUtilityInterfaceData
 QDataStream& operator>>(QDataStream& in, Series::SaveUtilityInterfaceData& data)
 {
     // Reading the series list utility interface data.
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.categories.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.categories[i];
-    }
+    readList(in, data.categories);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.directors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.directors[i];
-    }
+    readList(in, data.directors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.actors.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.actors[i];
-    }
+    readList(in, data.actors);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.production.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.production[i];
-    }
+    readList(in, data.production);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.music.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.music[i];
-    }
+    readList(in, data.music);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.services.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.services[i];
-    }
+    readList(in, data.services);
 
-    in >> count;
-    if (count > 0)
-    {
-        data.sensitiveContent.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.sensitiveContent[i];
-    }
+    readList(in, data.sensitiveContent);
 
     return in;
 }
@@ -317,14 +239,7 @@ QDataStream& operator<<(QDataStream& out, const Series::SaveData& data)
 QDataStream& operator>>(QDataStream& in, Series::SaveData& data)
 {
     // Reading the Series::SaveData from the data stream.
-    int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.serieTables.resize(count);
-        for (int i = 0; i < count; i++)
-            in >> data.serieTables[i];
-    }
+    readList<int>(in, data.serieTables);
 
     in >> data.utilityData;
 
@@ -351,14 +266,7 @@ QDataStream& operator>>(QDataStream& in, Series::SaveDataTable& data)
 {
     // Reading the Series::SaveDataTable drom the data stream.
     in >> data.tableName;
-    long long int count;
-    in >> count;
-    if (count > 0)
-    {
-        data.serieList.resize(count);
-        for (long long int i = 0; i < count; i++)
-            in >> data.serieList[i];
-    }
+    readList(in, data.serieList);
     in >> data.interface;
     in >> data.viewColumnsSize;
     in >> data.columnSort;
@@ -374,8 +282,8 @@ QDataStream& operator<<(QDataStream& out, const Series::SaveItem& data)
     out << data.seriePos;
     out << data.episodePos;
     out << data.seasonPos;
-    out << data.name;
-    out << data.url;
+    SaveInterface::writeString(out, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::writeString(out, data.url, StringChannel::ITEM_URL);
     unsigned char rate = data.rate;
     out << rate;
     return out;
@@ -388,8 +296,8 @@ QDataStream& operator>>(QDataStream& in, Series::SaveItem& data)
     in >> data.seriePos;
     in >> data.episodePos;
     in >> data.seasonPos;
-    in >> data.name;
-    in >> data.url;
+    SaveInterface::readString(in, data.name, StringChannel::ITEM_NAME);
+    SaveInterface::readString(in, data.url, StringChannel::ITEM_URL);
     unsigned char rate;
     in >> rate;
     data.rate = rate;
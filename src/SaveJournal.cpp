@@ -0,0 +1,515 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SaveJournal.h"
+#include "BlockCompressedDevice.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlIndex>
+#include <QSqlError>
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+SaveJournal::SaveJournal(QSqlDatabase& db) :
+    m_db(db),
+    m_isTracking(false)
+{}
+
+SaveJournal::~SaveJournal()
+{}
+
+QString SaveJournal::journalPath(const QString& filePath)
+{
+    return filePath + ".journal";
+}
+
+bool SaveJournal::exists(const QString& filePath)
+{
+    return QFile::exists(journalPath(filePath));
+}
+
+bool SaveJournal::remove(const QString& filePath)
+{
+    return !exists(filePath) || QFile::remove(journalPath(filePath));
+}
+
+bool SaveJournal::needCompaction(const QString& filePath)
+{
+    // The journal is replayed at each opening, it must stay small compared to the file.
+    qint64 journalSize = QFileInfo(journalPath(filePath)).size();
+    qint64 fileSize = QFileInfo(filePath).size();
+    return journalSize > qMax(fileSize / JOURNAL_COMPACTION_RATIO, JOURNAL_COMPACTION_MIN_SIZE);
+}
+
+quint32 SaveJournal::baseIdentifier(const SaveInterface::TableOfContents& toc)
+{
+    // The position and the checksum of each section identify the version of the file.
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out << toc.utility.offset << toc.utility.length << toc.utility.checksum;
+    for (const SaveInterface::FileSection& section : toc.tables)
+        out << section.offset << section.length << section.checksum;
+    return blockChecksum(bytes.constData(), bytes.size());
+}
+
+QStringList SaveJournal::userTables() const
+{
+    // The tables of the list, without the journal and the SQLite tables.
+    QStringList tables = m_db.tables();
+    tables.removeAll("JournalChanges");
+    tables.erase(
+        std::remove_if(tables.begin(), tables.end(),
+            [](const QString& tableName) { return tableName.startsWith("sqlite_"); }),
+        tables.end());
+    tables.sort();
+    return tables;
+}
+
+QStringList SaveJournal::keyColumns(const QString& tableName) const
+{
+    // The primary key of the table, or every columns if the table has none (the utility interface).
+    QStringList columns;
+    QSqlIndex index = m_db.primaryIndex(tableName);
+    for (int i = 0; i < index.count(); i++)
+        columns.append(index.fieldName(i));
+
+    if (columns.isEmpty())
+    {
+        QSqlRecord record = m_db.record(tableName);
+        for (int i = 0; i < record.count(); i++)
+            columns.append(record.fieldName(i));
+    }
+
+    return columns;
+}
+
+static QString sqlIdentifier(const QString& name)
+{
+    return '"' + QString(name).replace('"', "\"\"") + '"';
+}
+
+static QString sqlLiteral(const QString& str)
+{
+    return '\'' + QString(str).replace('\'', "''") + '\'';
+}
+
+// The WHERE clause matching the key columns, the values are bound.
+static QString keyCondition(const QStringList& keyColumns)
+{
+    QStringList conditions;
+    for (const QString& column : keyColumns)
+        conditions.append(sqlIdentifier(column) + " IS ?");
+    return conditions.join(" AND ");
+}
+
+bool SaveJournal::track()
+{
+    // Recording the key of every rows inserted, updated or deleted into the JournalChanges table.
+    untrack();
+
+    QSqlQuery query(m_db);
+    if (!query.exec("CREATE TEMP TABLE \"JournalChanges\" (TableName TEXT, Key1, Key2);"))
+    {
+#ifndef NDEBUG
+        std::cerr << QString("Failed to create the journal table.\n\t%1")
+            .arg(query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+#endif
+        return false;
+    }
+
+    const QStringList tables = userTables();
+    for (const QString& tableName : tables)
+    {
+        // The keys are stored into two columns, the tables of the lists have at most two.
+        QStringList keys = keyColumns(tableName);
+        if (keys.isEmpty() || keys.size() > 2)
+        {
+            untrack();
+            return false;
+        }
+
+        auto recordRow = [&tableName, &keys](const QString& row) -> QString
+        {
+            QString statement = "INSERT INTO \"JournalChanges\" VALUES (" + sqlLiteral(tableName) + ", " +
+                row + '.' + sqlIdentifier(keys.at(0)) + ", ";
+            if (keys.size() > 1)
+                statement += row + '.' + sqlIdentifier(keys.at(1));
+            else
+                statement += "NULL";
+            return statement + ");";
+        };
+
+        const QString table = sqlIdentifier(tableName);
+        const QStringList statements =
+        {
+            "CREATE TEMP TRIGGER " + sqlIdentifier("JournalInsert_" + tableName) + " AFTER INSERT ON " + table +
+                " BEGIN " + recordRow("NEW") + " END;",
+            "CREATE TEMP TRIGGER " + sqlIdentifier("JournalUpdate_" + tableName) + " AFTER UPDATE ON " + table +
+                " BEGIN " + recordRow("OLD") + ' ' + recordRow("NEW") + " END;",
+            "CREATE TEMP TRIGGER " + sqlIdentifier("JournalDelete_" + tableName) + " AFTER DELETE ON " + table +
+                " BEGIN " + recordRow("OLD") + " END;"
+        };
+
+        for (const QString& statement : statements)
+        {
+            if (!query.exec(statement))
+            {
+#ifndef NDEBUG
+                std::cerr << QString("Failed to create the journal triggers of the table %1.\n\t%2")
+                    .arg(tableName, query.lastError().text())
+                    .toLocal8Bit().constData()
+                    << std::endl;
+#endif
+                untrack();
+                return false;
+            }
+        }
+    }
+
+    m_trackedTables = tables;
+    m_isTracking = true;
+    return true;
+}
+
+void SaveJournal::untrack()
+{
+    // Removing the triggers and the recorded changes.
+    QSqlQuery query(m_db);
+    QStringList triggers;
+    if (query.exec("SELECT name FROM sqlite_temp_master WHERE type = 'trigger' AND name LIKE 'Journal%';"))
+    {
+        while (query.next())
+            triggers.append(query.value(0).toString());
+    }
+    query.clear();
+
+    for (const QString& trigger : triggers)
+        query.exec("DROP TRIGGER IF EXISTS " + sqlIdentifier(trigger) + ';');
+    query.exec("DROP TABLE IF EXISTS temp.\"JournalChanges\";");
+
+    m_trackedTables.clear();
+    m_isTracking = false;
+}
+
+bool SaveJournal::isTracking() const
+{
+    // If a table has been created, dropped or renamed, some changes are not recorded.
+    if (!m_isTracking || userTables() != m_trackedTables)
+        return false;
+
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT COUNT(*) FROM sqlite_temp_master WHERE type = 'trigger' AND name LIKE 'Journal%';") ||
+        !query.next())
+        return false;
+    return query.value(0).toLongLong() == 3 * (long long int)m_trackedTables.size();
+}
+
+void SaveJournal::clearChanges(const QStringList& tableNames)
+{
+    if (!m_isTracking)
+        return;
+
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM \"JournalChanges\" WHERE TableName = ?;");
+    for (const QString& tableName : tableNames)
+    {
+        query.addBindValue(tableName);
+        query.exec();
+    }
+}
+
+bool SaveJournal::append(const QString& filePath, const SaveInterface::TableOfContents& toc, const QHash<QString, QByteArray>& viewSettings)
+{
+    if (!isTracking())
+        return false;
+
+    // Writing the batch: the settings of the views, then the current rows of each key changed.
+    QByteArray batch;
+    QDataStream batchOut(&batch, QIODevice::WriteOnly);
+    batchOut << viewSettings;
+
+    QSqlQuery keysQuery(m_db);
+    keysQuery.setForwardOnly(true);
+    if (!keysQuery.exec("SELECT DISTINCT TableName, Key1, Key2 FROM \"JournalChanges\";"))
+        return false;
+
+    QList<QPair<QString, RowChange>> changes;
+    while (keysQuery.next())
+    {
+        QString tableName = keysQuery.value(0).toString();
+        RowChange change = {};
+        change.keyColumns = keyColumns(tableName);
+        change.keyValues.append(keysQuery.value(1));
+        if (change.keyColumns.size() > 1)
+            change.keyValues.append(keysQuery.value(2));
+
+        // If the row has been deleted, there is no row, the key is deleted when the journal is applied.
+        QSqlQuery rowsQuery(m_db);
+        rowsQuery.setForwardOnly(true);
+        rowsQuery.prepare("SELECT * FROM " + sqlIdentifier(tableName) + " WHERE " + keyCondition(change.keyColumns) + ';');
+        for (const QVariant& value : change.keyValues)
+            rowsQuery.addBindValue(value);
+        if (!rowsQuery.exec())
+            return false;
+
+        QSqlRecord record = rowsQuery.record();
+        for (int i = 0; i < record.count(); i++)
+            change.columns.append(record.fieldName(i));
+        while (rowsQuery.next())
+        {
+            QVariantList row;
+            row.reserve(record.count());
+            for (int i = 0; i < record.count(); i++)
+                row.append(rowsQuery.value(i));
+            change.rows.append(row);
+        }
+
+        changes.append({tableName, change});
+    }
+    keysQuery.clear();
+
+    long long int count = changes.size();
+    batchOut << count;
+    for (const QPair<QString, RowChange>& change : changes)
+    {
+        batchOut << change.first;
+        batchOut << change.second.keyColumns;
+        batchOut << change.second.keyValues;
+        batchOut << change.second.columns;
+        batchOut << change.second.rows;
+    }
+    if (batchOut.status() != QDataStream::Ok)
+        return false;
+
+    // The valid part of the journal is kept, an interrupted batch at the end is removed.
+    quint32 baseId = baseIdentifier(toc);
+    qint64 validSize = -1;
+    if (exists(filePath))
+    {
+        validSize = readJournal(filePath, baseId, [](const QByteArray& batch) { return true; });
+        if (validSize < 0)
+            return false;
+    }
+
+    QFile file(journalPath(filePath));
+    if (!file.open(QIODevice::ReadWrite))
+        return false;
+
+    QDataStream out(&file);
+    if (validSize < 0)
+    {
+        // New journal, writing the headers.
+        const char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
+        if (!file.resize(0))
+            return false;
+        out.writeRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
+        out.writeRawData(JOURNAL_IDENTIFIER, 3);
+        out << JOURNAL_VERSION;
+        out << baseId;
+    }
+    else if (!file.resize(validSize) || !file.seek(validSize))
+        return false;
+
+    qint64 batchSize = batch.size();
+    out << batchSize;
+    out.writeRawData(batch.constData(), batch.size());
+    out << blockChecksum(batch.constData(), batch.size());
+    if (out.status() != QDataStream::Ok || !file.flush())
+        return false;
+    file.close();
+
+    // The changes are saved, recording the next ones.
+    QSqlQuery query(m_db);
+    query.exec("DELETE FROM \"JournalChanges\";");
+    return true;
+}
+
+qint64 SaveJournal::readJournal(const QString& filePath, quint32 baseId, const std::function<bool(const QByteArray& batch)>& readBatch)
+{
+    // Return the size of the valid part of the journal, -1 if it's not a journal of this version of the file.
+    QFile file(journalPath(filePath));
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    QDataStream in(&file);
+    char primaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = {};
+    char validPrimaryIdentifier[PRIMARY_IDENTIFIER_SIZE] = PRIMARY_IDENTIFIER;
+    char fileIdentifier[4] = {0,0,0,0};
+    int version;
+    quint32 fileBaseId;
+    in.readRawData(primaryIdentifier, PRIMARY_IDENTIFIER_SIZE-1);
+    in.readRawData(fileIdentifier, 3);
+    in >> version;
+    in >> fileBaseId;
+    if (in.status() != QDataStream::Ok ||
+        strcmp(primaryIdentifier, validPrimaryIdentifier) != 0 ||
+        strcmp(fileIdentifier, JOURNAL_IDENTIFIER) != 0 ||
+        version != JOURNAL_VERSION ||
+        fileBaseId != baseId)
+        return -1;
+
+    // Reading the batches until the end or until an incomplete batch.
+    qint64 validSize = file.pos();
+    while (!in.atEnd())
+    {
+        qint64 batchSize;
+        in >> batchSize;
+        if (in.status() != QDataStream::Ok ||
+            batchSize <= 0 ||
+            batchSize > file.size() - file.pos() - (qint64)sizeof(quint32))
+            break;
+
+        QByteArray batch = file.read(batchSize);
+        quint32 checksum;
+        in >> checksum;
+        if (batch.size() != batchSize ||
+            in.status() != QDataStream::Ok ||
+            blockChecksum(batch.constData(), batch.size()) != checksum ||
+            !readBatch(batch))
+            break;
+
+        validSize = file.pos();
+    }
+
+    return validSize;
+}
+
+bool SaveJournal::read(const QString& filePath, const SaveInterface::TableOfContents& toc, bool* isComplete)
+{
+    clear();
+
+    qint64 size = readJournal(filePath, baseIdentifier(toc),
+        [this](const QByteArray& batch) -> bool
+        {
+            // The batch is decoded before being added to the changes.
+            QDataStream in(batch);
+            QHash<QString, QByteArray> viewSettings;
+            in >> viewSettings;
+            long long int count;
+            in >> count;
+            if (in.status() != QDataStream::Ok || count < 0)
+                return false;
+
+            QList<QPair<QString, RowChange>> changes;
+            for (long long int i = 0; i < count; i++)
+            {
+                QPair<QString, RowChange> change;
+                in >> change.first;
+                in >> change.second.keyColumns;
+                in >> change.second.keyValues;
+                in >> change.second.columns;
+                in >> change.second.rows;
+                if (in.status() != QDataStream::Ok)
+                    return false;
+                changes.append(change);
+            }
+
+            for (const QPair<QString, RowChange>& change : changes)
+                m_changes[change.first].append(change.second);
+            for (QHash<QString, QByteArray>::const_iterator it = viewSettings.cbegin(); it != viewSettings.cend(); it++)
+                m_viewSettings.insert(it.key(), it.value());
+            return true;
+        });
+
+    if (isComplete)
+        *isComplete = size >= 0 && size == QFileInfo(journalPath(filePath)).size();
+    return size >= 0;
+}
+
+bool SaveJournal::apply(const QStringList& tableNames)
+{
+    // Replacing the rows of each key by the rows of the journal, in the order they were saved.
+    for (const QString& tableName : tableNames)
+    {
+        const QList<RowChange> changes = m_changes.value(tableName);
+        if (changes.isEmpty())
+            continue;
+
+        // The columns are read from the file, they must be columns of the table.
+        QSqlRecord record = m_db.record(tableName);
+        QSqlQuery query(m_db);
+        for (const RowChange& change : changes)
+        {
+            if (change.keyColumns.isEmpty() || change.keyColumns.size() != change.keyValues.size())
+                return false;
+            for (const QString& column : change.keyColumns + change.columns)
+            {
+                if (!record.contains(column))
+                    return false;
+            }
+
+            query.prepare("DELETE FROM " + sqlIdentifier(tableName) + " WHERE " + keyCondition(change.keyColumns) + ';');
+            for (const QVariant& value : change.keyValues)
+                query.addBindValue(value);
+            if (!query.exec())
+                return false;
+
+            if (change.rows.isEmpty())
+                continue;
+
+            QStringList columns;
+            QStringList values;
+            for (const QString& column : change.columns)
+            {
+                columns.append(sqlIdentifier(column));
+                values.append("?");
+            }
+            query.prepare("INSERT INTO " + sqlIdentifier(tableName) + " (" + columns.join(", ") + ") VALUES (" + values.join(", ") + ");");
+            for (const QVariantList& row : change.rows)
+            {
+                if (row.size() != change.columns.size())
+                    return false;
+                for (const QVariant& value : row)
+                    query.addBindValue(value);
+                if (!query.exec())
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SaveJournal::hasChanges(const QStringList& tableNames) const
+{
+    for (const QString& tableName : tableNames)
+    {
+        if (m_changes.contains(tableName) || m_viewSettings.contains(tableName))
+            return true;
+    }
+    return false;
+}
+
+QByteArray SaveJournal::viewSettings(const QString& tableName) const
+{
+    return m_viewSettings.value(tableName);
+}
+
+void SaveJournal::clear()
+{
+    m_changes.clear();
+    m_viewSettings.clear();
+}
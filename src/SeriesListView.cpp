@@ -18,9 +18,13 @@
 
 #include "SeriesListView.h"
 #include "TableModelSeries.h"
+#include "SaveInterface.h"
 #include "FilterDialog.h"
+#include "BulkEditDialog.h"
 #include "ListViewDelegate.h"
+#include "QuickFilter.h"
 #include <QTableView>
+#include <QDataStream>
 #include <QHeaderView>
 #include <QItemSelectionModel>
 #include <QSqlQuery>
@@ -91,6 +95,7 @@ void SeriesListView::setupWidget()
     m_view->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
     m_view->setSortingEnabled(true);
     m_view->verticalHeader()->hide();
+    setupViewMetrics(m_view);
 
     // Setting custom item delegate ListViewDelegate.
     QAbstractItemDelegate* oldDelegate = m_view->itemDelegate();
@@ -224,6 +229,16 @@ void SeriesListView::createMenu(QVBoxLayout* vLayout)
         connect(filterAct, &QAction::triggered, this, &SeriesListView::filter);
         toolBar->addAction(filterAct);
 
+        QIcon bulkEditIcon(":/Images/Utility.svg");
+        QAction* bulkEditAct = new QAction(bulkEditIcon, tr("Bulk edit"), this);
+        bulkEditAct->setToolTip(tr("Editing the rate, the sensitive content or the utilities of the selected items."));
+        connect(bulkEditAct, &QAction::triggered, this, &SeriesListView::bulkEdit);
+        toolBar->addAction(bulkEditAct);
+
+        // Search as you type on the names of the list.
+        toolBar->addSeparator();
+        toolBar->addWidget(new QuickFilter(m_view, m_model, Series::NAME, this));
+
         vLayout->setMenuBar(toolBar);
     }
 }
@@ -238,34 +253,57 @@ void SeriesListView::deletingItems()
     }
 }
 
-QVariant SeriesListView::listData() const
+Series::ColumnsSize SeriesListView::columnsSize() const
 {
-    // Return the data inside the model.
-    if (m_model)
-    {
-        // Retrieve the data of the model.
-        QVariant variant = m_model->retrieveData();
-        // If the list is a series list.
-        if (variant.canConvert<Series::SaveDataTable>() && m_view)
-        {
-            // Retrieve the size of the column.
-            Series::SaveDataTable data = qvariant_cast<Series::SaveDataTable>(variant);
-            data.viewColumnsSize.name = m_view->columnWidth(Series::NAME);
-            data.viewColumnsSize.episode = m_view->columnWidth(Series::EPISODE);
-            data.viewColumnsSize.season = m_view->columnWidth(Series::SEASON);
-            data.viewColumnsSize.categories = m_view->columnWidth(Series::CATEGORIES);
-            data.viewColumnsSize.directors = m_view->columnWidth(Series::DIRECTORS);
-            data.viewColumnsSize.actors = m_view->columnWidth(Series::ACTORS);
-            data.viewColumnsSize.production = m_view->columnWidth(Series::PRODUCTION);
-            data.viewColumnsSize.music = m_view->columnWidth(Series::MUSIC);
-            data.viewColumnsSize.services = m_view->columnWidth(Series::SERVICES);
-            data.viewColumnsSize.sensitiveContent = m_view->columnWidth(Series::SENSITIVE_CONTENT);
-            data.viewColumnsSize.rate = m_view->columnWidth(Series::RATE);
-            return QVariant::fromValue(data);
-        }
-    }
+    // Retrieve the size of the columns of the view.
+    Series::ColumnsSize columnsSize = {};
+    columnsSize.name = m_view->columnWidth(Series::NAME);
+    columnsSize.episode = m_view->columnWidth(Series::EPISODE);
+    columnsSize.season = m_view->columnWidth(Series::SEASON);
+    columnsSize.categories = m_view->columnWidth(Series::CATEGORIES);
+    columnsSize.directors = m_view->columnWidth(Series::DIRECTORS);
+    columnsSize.actors = m_view->columnWidth(Series::ACTORS);
+    columnsSize.production = m_view->columnWidth(Series::PRODUCTION);
+    columnsSize.music = m_view->columnWidth(Series::MUSIC);
+    columnsSize.services = m_view->columnWidth(Series::SERVICES);
+    columnsSize.sensitiveContent = m_view->columnWidth(Series::SENSITIVE_CONTENT);
+    columnsSize.rate = m_view->columnWidth(Series::RATE);
+    return columnsSize;
+}
+
+bool SeriesListView::writeListData(QDataStream& out) const
+{
+    // Streaming the list into the data stream, without building the SaveDataTable.
+    if (!m_model || !m_view)
+        return false;
+
+    if (!m_model->writeData(out))
+        return false;
+    return writeViewSettings(out);
+}
+
+bool SeriesListView::writeViewSettings(QDataStream& out) const
+{
+    if (!m_model || !m_view)
+        return false;
 
-    return QVariant();
+    out << columnsSize();
+    m_model->writeSortingData(out);
+    return true;
+}
+
+bool SeriesListView::readViewSettings(QDataStream& in)
+{
+    // Reading the end of a Series::SaveDataTable and applying it to the view.
+    Series::SaveDataTable data = {};
+    in >> data.viewColumnsSize;
+    in >> data.columnSort;
+    in >> data.sortOrder;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    setColumnsSizeAndSortingOrder(QVariant::fromValue(data));
+    return true;
 }
 
 ListType SeriesListView::listType() const
@@ -300,6 +338,11 @@ void SeriesListView::setColumnsSizeAndSortingOrder(const QVariant& variant)
     }
 }
 
+TableModel* SeriesListView::tableModel() const
+{
+    return m_model;
+}
+
 ViewType SeriesListView::viewType() const
 {
     return ViewType::SERIES;
@@ -428,6 +471,25 @@ void SeriesListView::filter()
     filterDialog.exec();
 }
 
+void SeriesListView::bulkEdit()
+{
+    // Opening the bulk edit dialog on the selected items.
+    QModelIndexList indexList = m_view->selectionModel()->selectedRows(0);
+    if (indexList.isEmpty())
+    {
+        QMessageBox::warning(
+            this,
+            tr("Bulk edit"),
+            tr("No items are selected."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
+
+    BulkEditDialog bulkEditDialog(m_model, indexList, m_utilityTable, m_db, this);
+    bulkEditDialog.exec();
+}
+
 void SeriesListView::enableAction(QAction* action) const
 {
     if (m_model->isSortingEnabled() || m_model->isFilterEnabled())
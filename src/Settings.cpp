@@ -21,7 +21,8 @@
 Settings Settings::m_instance;
 
 Settings::Settings() :
-    m_isLegacyUtilEditor(false)
+    m_isLegacyUtilEditor(false),
+    m_isFixedMetrics(true)
 {}
 
 Settings::~Settings()
@@ -30,4 +31,9 @@ Settings::~Settings()
 void Settings::setLegacyUtilEditor(bool value)
 {
     m_isLegacyUtilEditor = value;
+}
+
+void Settings::setFixedMetrics(bool value)
+{
+    m_isFixedMetrics = value;
 }
\ No newline at end of file
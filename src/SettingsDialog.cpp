@@ -25,7 +25,8 @@
 
 SettingsDialog::SettingsDialog(QWidget* parent) :
     QDialog(parent),
-    m_legUtilEditCheckBox(nullptr)
+    m_legUtilEditCheckBox(nullptr),
+    m_fixedMetricsCheckBox(nullptr)
 {
     /*
     Creating two layout, one vertical and the other horizontal.
@@ -37,6 +38,9 @@ SettingsDialog::SettingsDialog(QWidget* parent) :
     m_legUtilEditCheckBox = new QCheckBox(tr("Legacy utility editor."), this);
     vLayout->addWidget(m_legUtilEditCheckBox);
 
+    m_fixedMetricsCheckBox = new QCheckBox(tr("Fixed rows height, faster with large lists (applied to the next opened lists)."), this);
+    vLayout->addWidget(m_fixedMetricsCheckBox);
+
     QHBoxLayout* hLayout = new QHBoxLayout(this);
     QPushButton* cancelBtn = new QPushButton(tr("Cancel"), this);
     connect(cancelBtn, &QPushButton::clicked, this, &QDialog::reject);
@@ -65,6 +69,8 @@ void SettingsDialog::apply()
 
     settings.setValue("settings/isLegacyUtilityEditor", m_legUtilEditCheckBox->isChecked());
     Settings::instance().setLegacyUtilEditor(m_legUtilEditCheckBox->isChecked());
+    settings.setValue("settings/isFixedMetrics", m_fixedMetricsCheckBox->isChecked());
+    Settings::instance().setFixedMetrics(m_fixedMetricsCheckBox->isChecked());
 
     accept();
 }
@@ -74,4 +80,6 @@ void SettingsDialog::retrieveSettings()
     // Retrieve the settings and apply then to the widgets.
     // legacy Utility Editor.
     m_legUtilEditCheckBox->setChecked(Settings::instance().isLegacyUtilEditor());
+    // Fixed metrics of the list views.
+    m_fixedMetricsCheckBox->setChecked(Settings::instance().isFixedMetrics());
 }
\ No newline at end of file
@@ -17,8 +17,11 @@
 */
 
 #include "SqlUtilityTable.h"
+#include "SaveInterface.h"
+#include "UtilityNameIndex.h"
 #include <iostream>
 #include <QSqlError>
+#include <QDataStream>
 
 SqlUtilityTable::SqlUtilityTable(ListType type, QSqlDatabase& db) :
 	m_type(type),
@@ -39,11 +42,13 @@ SqlUtilityTable::~SqlUtilityTable()
 {
 	destroyTables();
 	m_query.clear();
+	qDeleteAll(m_nameIndexes);
 }
 
 void SqlUtilityTable::newList(ListType type)
 {
 	// Destoying all the existing table and recreating them for the new list.
+	invalidateNameIndexes();
 	destroyTables();
 	m_type = type;
 	if (type != ListType::UNKNOWN)
@@ -84,6 +89,30 @@ QString SqlUtilityTable::tableName(UtilityTableName tableName)
 	}
 }
 
+QList<UtilityTableName> SqlUtilityTable::utilityTables(ListType type)
+{
+	// Return the utility tables used by a list type.
+	switch (type)
+	{
+	case ListType::GAMELIST:
+		return { UtilityTableName::SERIES, UtilityTableName::CATEGORIES, UtilityTableName::DEVELOPPERS,
+			UtilityTableName::PUBLISHERS, UtilityTableName::PLATFORM, UtilityTableName::SERVICES };
+	case ListType::MOVIESLIST:
+		return { UtilityTableName::SERIES, UtilityTableName::CATEGORIES, UtilityTableName::DIRECTOR,
+			UtilityTableName::ACTORS, UtilityTableName::PRODUCTION, UtilityTableName::MUSIC, UtilityTableName::SERVICES };
+	case ListType::COMMONLIST:
+		return { UtilityTableName::SERIES, UtilityTableName::CATEGORIES, UtilityTableName::AUTHORS };
+	case ListType::BOOKSLIST:
+		return { UtilityTableName::SERIES, UtilityTableName::CATEGORIES, UtilityTableName::AUTHORS,
+			UtilityTableName::PUBLISHERS, UtilityTableName::SERVICES };
+	case ListType::SERIESLIST:
+		return { UtilityTableName::CATEGORIES, UtilityTableName::DIRECTOR, UtilityTableName::ACTORS,
+			UtilityTableName::PRODUCTION, UtilityTableName::MUSIC, UtilityTableName::SERVICES };
+	default:
+		return {};
+	}
+}
+
 void SqlUtilityTable::createTables()
 {
 	if (m_type == ListType::GAMELIST)
@@ -212,22 +241,47 @@ QList<ItemUtilityData> SqlUtilityTable::retrieveTableData(UtilityTableName table
 	return {};
 }
 
-QVariant SqlUtilityTable::data() const
+bool SqlUtilityTable::writeData(QDataStream& out) const
 {
-	if (m_isTableReady)
+	// Streaming each utility table into the data stream, the rows are not stored in memory.
+	if (!m_isTableReady)
+		return false;
+
+	return writeTables(out, m_db, m_type);
+}
+
+bool SqlUtilityTable::writeTables(QDataStream& out, QSqlDatabase& db, ListType type)
+{
+	// Streaming the utility tables of the database db, same output than writeData.
+	// It only use its arguments, so it can be called from another thread with another connection.
+	QList<UtilityTableName> tables = utilityTables(type);
+	for (UtilityTableName tName : tables)
 	{
-		if (m_type == ListType::GAMELIST)
-			return queryGameData();
-		else if (m_type == ListType::MOVIESLIST)
-			return queryMoviesData();
-		else if (m_type == ListType::COMMONLIST)
-			return queryCommonsData();
-		else if (m_type == ListType::BOOKSLIST)
-			return queryBooksData();
-		else if (m_type == ListType::SERIESLIST)
-			return querySeriesData();
+		QString statement = QString(
+			"SELECT\n"
+			"	\"%1ID\",\n"
+			"	OrderID,\n"
+			"	\"Name\"\n"
+			"FROM\n"
+			"	\"%1\"\n"
+			"ORDER BY\n"
+			"	OrderID ASC;")
+				.arg(tableName(tName));
+
+		bool result = SaveInterface::writeQuery(out, db, statement,
+			[](QDataStream& out, const QSqlQuery& query)
+			{
+				ItemUtilityData item = {};
+				item.utilityID = query.value(0).toLongLong();
+				item.order = query.value(1).toInt();
+				item.name = query.value(2).toString();
+				out << item;
+			});
+		if (!result)
+			return false;
 	}
-	return QVariant();
+
+	return true;
 }
 
 bool SqlUtilityTable::setData(const QVariant& variant)
@@ -288,6 +342,16 @@ void SqlUtilityTable::standardTableCreation(UtilityTableName tableName)
 	m_query.clear();
 }
 
+bool SqlUtilityTable::appendData(UtilityTableName tName, const QList<ItemUtilityData>& data)
+{
+	// Insert the rows into the utility table tName, only if the table is part of the current list.
+	if (!m_isTableReady || !utilityTables(m_type).contains(tName))
+		return false;
+
+	m_staleNameIndexes.insert((int)tName);
+	return setStandardData(tName, data);
+}
+
 bool SqlUtilityTable::setStandardData(UtilityTableName tName, const QList<ItemUtilityData>& data)
 {
 	// Convenient member function to set the data into the SQL Table.
@@ -446,5 +510,168 @@ long long int SqlUtilityTable::addItem(UtilityTableName tableName, const QString
 #endif
 	
 	m_query.clear();
+	if (itemID != -1)
+		utilityNameAdded(tableName, itemID, name);
 	return itemID;
+}
+
+QHash<QString, long long int> SqlUtilityTable::addItems(UtilityTableName tableName, const QStringList& names, bool* ok)
+{
+	// Reading every names of the table once, instead of one query by name.
+	// The insertions can be rolled back by the caller, the name index is read again.
+	m_staleNameIndexes.insert((int)tableName);
+	if (ok)
+		*ok = false;
+	QHash<QString, long long int> itemIDs;
+	QSqlQuery query(m_db);
+	query.setForwardOnly(true);
+	QString statement = QString(
+		"SELECT\n"
+		"	\"%1ID\",\n"
+		"	Name\n"
+		"FROM\n"
+		"	\"%1\";")
+			.arg(this->tableName(tableName));
+	if (!query.exec(statement))
+	{
+#ifndef NDEBUG
+		std::cerr << QString("Failed to query the items of the table %1.\n\t%2")
+			.arg(this->tableName(tableName), query.lastError().text())
+			.toLocal8Bit().constData() << '\n' << std::endl;
+#endif
+		return itemIDs;
+	}
+	QHash<QString, long long int> existingIDs;
+	while (query.next())
+		existingIDs.insert(query.value(1).toString(), query.value(0).toLongLong());
+
+	// The new names are inserted after the last item of the table.
+	long long int orderID = 0;
+	statement = QString(
+		"SELECT\n"
+		"	MAX(OrderID)\n"
+		"FROM\n"
+		"	\"%1\";")
+			.arg(this->tableName(tableName));
+	if (query.exec(statement) && query.next() && !query.value(0).isNull())
+		orderID = query.value(0).toLongLong()+1;
+
+	QSqlQuery insertQuery(m_db);
+	bool isPrepared = insertQuery.prepare(QString(
+		"INSERT INTO \"%1\" (OrderID, Name)\n"
+		"VALUES\n"
+		"	(?, ?);")
+			.arg(this->tableName(tableName)));
+
+	for (const QString& name : names)
+	{
+		if (itemIDs.contains(name))
+			continue;
+
+		QHash<QString, long long int>::const_iterator it = existingIDs.constFind(name);
+		if (it != existingIDs.constEnd())
+		{
+			itemIDs.insert(name, it.value());
+			continue;
+		}
+
+		if (!isPrepared)
+			return itemIDs;
+		insertQuery.bindValue(0, orderID);
+		insertQuery.bindValue(1, name);
+		if (!insertQuery.exec())
+		{
+#ifndef NDEBUG
+			std::cerr << QString("Failed to insert item %1 into table %2.\n\t%3")
+				.arg(name, this->tableName(tableName), insertQuery.lastError().text())
+				.toLocal8Bit().constData() << '\n' << std::endl;
+#endif
+			return itemIDs;
+		}
+		itemIDs.insert(name, insertQuery.lastInsertId().toLongLong());
+		orderID++;
+	}
+
+	if (ok)
+		*ok = true;
+	return itemIDs;
+}
+
+QList<ItemUtilityData> SqlUtilityTable::searchTableData(UtilityTableName tableName, const QString& pattern, int maxResults)
+{
+	const UtilityNameIndex& index = nameIndex(tableName);
+	QList<long long int> utilityIDs = index.search(pattern, maxResults);
+
+	QList<ItemUtilityData> tableData;
+	tableData.reserve(utilityIDs.size());
+	for (int i = 0; i < utilityIDs.size(); i++)
+		tableData.append({utilityIDs.at(i), i, index.name(utilityIDs.at(i))});
+	return tableData;
+}
+
+const UtilityNameIndex& SqlUtilityTable::nameIndex(UtilityTableName tableName)
+{
+	UtilityNameIndex* index = m_nameIndexes.value((int)tableName, nullptr);
+	if (index && !m_staleNameIndexes.contains((int)tableName))
+		return *index;
+
+	if (!index)
+	{
+		index = new UtilityNameIndex();
+		m_nameIndexes.insert((int)tableName, index);
+	}
+
+	// Reading all the names of the table, then the index is only updated.
+	index->clear();
+	QSqlQuery query(m_db);
+	query.setForwardOnly(true);
+	QString statement = QString(
+		"SELECT\n"
+		"	\"%1ID\",\n"
+		"	Name\n"
+		"FROM\n"
+		"	\"%1\";")
+			.arg(this->tableName(tableName));
+	if (query.exec(statement))
+	{
+		while (query.next())
+			index->insert(query.value(0).toLongLong(), query.value(1).toString());
+	}
+#ifndef NDEBUG
+	else
+		std::cerr << QString("Failed to query the names of the table %1.\n\t%2")
+			.arg(this->tableName(tableName), query.lastError().text())
+			.toLocal8Bit().constData() << '\n' << std::endl;
+#endif
+
+	m_staleNameIndexes.remove((int)tableName);
+	return *index;
+}
+
+void SqlUtilityTable::utilityNameAdded(UtilityTableName tableName, long long int utilityID, const QString& name)
+{
+	// An index not created yet or stale is read entirely the next time it is used.
+	UtilityNameIndex* index = m_nameIndexes.value((int)tableName, nullptr);
+	if (index && !m_staleNameIndexes.contains((int)tableName))
+		index->insert(utilityID, name);
+}
+
+void SqlUtilityTable::utilityNameRemoved(UtilityTableName tableName, long long int utilityID)
+{
+	UtilityNameIndex* index = m_nameIndexes.value((int)tableName, nullptr);
+	if (index && !m_staleNameIndexes.contains((int)tableName))
+		index->remove(utilityID);
+}
+
+void SqlUtilityTable::utilityNameChanged(UtilityTableName tableName, long long int utilityID, const QString& name)
+{
+	UtilityNameIndex* index = m_nameIndexes.value((int)tableName, nullptr);
+	if (index && !m_staleNameIndexes.contains((int)tableName))
+		index->rename(utilityID, name);
+}
+
+void SqlUtilityTable::invalidateNameIndexes()
+{
+	for (QHash<int, UtilityNameIndex*>::const_iterator it = m_nameIndexes.cbegin(); it != m_nameIndexes.cend(); it++)
+		m_staleNameIndexes.insert(it.key());
 }
\ No newline at end of file
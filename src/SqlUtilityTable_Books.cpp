@@ -39,17 +39,6 @@ void SqlUtilityTable::destroyBooksTables()
     destroyTableByName(tableName(UtilityTableName::SERVICES));
 }
 
-QVariant SqlUtilityTable::queryBooksData() const
-{
-    Books::SaveUtilityData data = {};
-    data.series = retrieveTableData(UtilityTableName::SERIES);
-    data.categories = retrieveTableData(UtilityTableName::CATEGORIES);
-    data.authors = retrieveTableData(UtilityTableName::AUTHORS);
-    data.publishers = retrieveTableData(UtilityTableName::PUBLISHERS);
-    data.services = retrieveTableData(UtilityTableName::SERVICES);
-    return QVariant::fromValue(data);
-}
-
 bool SqlUtilityTable::setBooksData(const QVariant& variant)
 {
     Books::SaveUtilityData data = qvariant_cast<Books::SaveUtilityData>(variant);
@@ -40,15 +40,6 @@ void SqlUtilityTable::createAuthorsTables()
     standardTableCreation(UtilityTableName::AUTHORS);
 }
 
-QVariant SqlUtilityTable::queryCommonsData() const
-{
-    Common::SaveUtilityData data = {};
-    data.series = retrieveTableData(UtilityTableName::SERIES);
-    data.categories = retrieveTableData(UtilityTableName::CATEGORIES);
-    data.authors = retrieveTableData(UtilityTableName::AUTHORS);
-    return QVariant::fromValue(data);
-}
-
 bool SqlUtilityTable::setCommonsData(const QVariant& variant)
 {
     Common::SaveUtilityData data = qvariant_cast<Common::SaveUtilityData>(variant);
@@ -73,19 +73,6 @@ void SqlUtilityTable::createServicesTable()
 	standardTableCreation(UtilityTableName::SERVICES);
 }
 
-QVariant SqlUtilityTable::queryGameData() const
-{
-	Game::SaveUtilityData data = {};
-	data.series = retrieveTableData(UtilityTableName::SERIES);
-	data.categories = retrieveTableData(UtilityTableName::CATEGORIES);
-	data.developpers = retrieveTableData(UtilityTableName::DEVELOPPERS);
-	data.publishers = retrieveTableData(UtilityTableName::PUBLISHERS);
-	data.platform = retrieveTableData(UtilityTableName::PLATFORM);
-	data.services = retrieveTableData(UtilityTableName::SERVICES);
-
-	return QVariant::fromValue(data);
-}
-
 bool SqlUtilityTable::setGameData(const QVariant& variant)
 {
 	// Set the data into the SQL tables.
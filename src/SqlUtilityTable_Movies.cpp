@@ -63,20 +63,6 @@ void SqlUtilityTable::createMusicTable()
     standardTableCreation(UtilityTableName::MUSIC);
 }
 
-QVariant SqlUtilityTable::queryMoviesData() const
-{
-    Movie::SaveUtilityData data = {};
-    data.series = retrieveTableData(UtilityTableName::SERIES);
-    data.categories = retrieveTableData(UtilityTableName::CATEGORIES);
-    data.directors = retrieveTableData(UtilityTableName::DIRECTOR);
-    data.actors = retrieveTableData(UtilityTableName::ACTORS);
-    data.productions = retrieveTableData(UtilityTableName::PRODUCTION);
-    data.music = retrieveTableData(UtilityTableName::MUSIC);
-    data.services = retrieveTableData(UtilityTableName::SERVICES);
-
-    return QVariant::fromValue(data);
-}
-
 bool SqlUtilityTable::setMoviesData(const QVariant& variant)
 {
     Movie::SaveUtilityData data = qvariant_cast<Movie::SaveUtilityData>(variant);
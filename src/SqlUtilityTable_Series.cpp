@@ -41,18 +41,6 @@ void SqlUtilityTable::destroySeriesTables()
     destroyTableByName(tableName(UtilityTableName::SERVICES));
 }
 
-QVariant SqlUtilityTable::querySeriesData() const
-{
-    Series::SaveUtilityData data = {};
-    data.categories = retrieveTableData(UtilityTableName::CATEGORIES);
-    data.directors = retrieveTableData(UtilityTableName::DIRECTOR);
-    data.actors = retrieveTableData(UtilityTableName::ACTORS);
-    data.production = retrieveTableData(UtilityTableName::PRODUCTION);
-    data.music = retrieveTableData(UtilityTableName::MUSIC);
-    data.services = retrieveTableData(UtilityTableName::SERVICES);
-    return QVariant::fromValue(data);
-}
-
 bool SqlUtilityTable::setSeriesData(const QVariant& variant)
 {
     Series::SaveUtilityData data = qvariant_cast<Series::SaveUtilityData>(variant);
@@ -23,6 +23,8 @@
 #include <QPaintEvent>
 #include <QPainter>
 #include <QPolygonF>
+#include <QPixmapCache>
+#include <QtMath>
 
 QPolygonF StarEditor::starPolygonData = 
 {
@@ -107,6 +109,37 @@ void StarEditor::paintStars(int starNB, QPainter* painter, QRect rect, QPalette
 	painter->restore();
 }
 
+QPixmap StarEditor::starsPixmap(int starNB, int height, qreal devicePixelRatio, const QColor& color)
+{
+	if (starNB <= 0 || height <= 0)
+		return QPixmap();
+
+	QString key = QString("StarEditor_%1_%2_%3_%4")
+		.arg(starNB)
+		.arg(height)
+		.arg(devicePixelRatio)
+		.arg(color.rgba());
+
+	QPixmap pixmap;
+	if (QPixmapCache::find(key, &pixmap))
+		return pixmap;
+
+	// The last star overflow a little bit of its slot.
+	QSize size(qCeil((starNB + 0.1) * paintFactor()), height);
+	pixmap = QPixmap(QSize(qCeil(size.width() * devicePixelRatio), qCeil(size.height() * devicePixelRatio)));
+	pixmap.setDevicePixelRatio(devicePixelRatio);
+	pixmap.fill(Qt::transparent);
+
+	QPalette palette;
+	palette.setColor(QPalette::WindowText, color);
+	QPainter painter(&pixmap);
+	paintStars(starNB, &painter, QRect(QPoint(0, 0), size), palette);
+	painter.end();
+
+	QPixmapCache::insert(key, pixmap);
+	return pixmap;
+}
+
 int StarEditor::stars() const
 {
 	return m_stars;
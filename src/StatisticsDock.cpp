@@ -0,0 +1,155 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StatisticsDock.h"
+#include "TableModel.h"
+#include "ListStatistics.h"
+#include "SqlUtilityTable.h"
+
+#include <QTreeWidget>
+#include <QTreeWidgetItem>
+#include <QHeaderView>
+#include <QTimer>
+#include <QList>
+#include <QPair>
+#include <algorithm>
+
+StatisticsDock::StatisticsDock(QWidget* parent) :
+    QDockWidget(tr("Statistics"), parent),
+    m_tree(new QTreeWidget(this)),
+    m_timer(new QTimer(this))
+{
+    setObjectName("StatisticsDock");
+
+    m_tree->setColumnCount(2);
+    m_tree->setHeaderLabels({tr("Value"), tr("Items")});
+    m_tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_tree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    m_tree->header()->setStretchLastSection(false);
+    m_tree->setRootIsDecorated(true);
+    m_tree->setUniformRowHeights(true);
+    setWidget(m_tree);
+
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(STATISTICS_DOCK_DELAY);
+    connect(m_timer, &QTimer::timeout, this, &StatisticsDock::refresh);
+    connect(this, &QDockWidget::visibilityChanged, this, &StatisticsDock::statisticsChanged);
+}
+
+StatisticsDock::~StatisticsDock()
+{}
+
+void StatisticsDock::setModel(TableModel* model)
+{
+    // Showing the statistics of another list.
+    if (m_model == model)
+        return;
+
+    if (m_model && m_model->statistics())
+        disconnect(m_model->statistics(), &ListStatistics::statisticsChanged, this, &StatisticsDock::statisticsChanged);
+    m_model = model;
+    if (m_model)
+        connect(m_model->statistics(), &ListStatistics::statisticsChanged, this, &StatisticsDock::statisticsChanged);
+
+    refresh();
+}
+
+void StatisticsDock::statisticsChanged()
+{
+    // Several changes are often made in a row, refreshing once they are done.
+    if (isVisible())
+        m_timer->start();
+}
+
+void StatisticsDock::refresh()
+{
+    // Filling the tree with the aggregates of the model, nothing is computed while the dock is hidden.
+    m_timer->stop();
+    m_tree->clear();
+    if (!m_model || !isVisible())
+        return;
+
+    ListStatistics* statistics = m_model->statistics();
+    addCategory(tr("Items"), statistics->itemCount());
+
+    // Rate histogram.
+    QTreeWidgetItem* rateCategory = addCategory(tr("Rate"), -1);
+    addCounts(rateCategory, statistics->rateCounts());
+
+    // Number of items of each utility, the most used first.
+    QList<UtilityTableName> tables = SqlUtilityTable::utilityTables(m_model->listType());
+    for (UtilityTableName tName : tables)
+    {
+        const QHash<long long int, long long int>& counts = statistics->utilityCounts(tName);
+        QList<QPair<QString, long long int>> utilities;
+        utilities.reserve(counts.size());
+        for (QHash<long long int, long long int>::const_iterator it = counts.constBegin();
+            it != counts.constEnd();
+            it++)
+        {
+            // The links to a removed utility are not shown.
+            QString name = statistics->utilityName(tName, it.key());
+            if (!name.isNull())
+                utilities.append(qMakePair(name, it.value()));
+        }
+        std::sort(utilities.begin(), utilities.end(),
+            [](const QPair<QString, long long int>& utility1, const QPair<QString, long long int>& utility2) -> bool
+            {
+                if (utility1.second != utility2.second)
+                    return utility1.second > utility2.second;
+                return utility1.first.compare(utility2.first, Qt::CaseInsensitive) < 0;
+            });
+
+        QTreeWidgetItem* category = addCategory(SqlUtilityTable::tableName(tName), utilities.size());
+        for (const QPair<QString, long long int>& utility : utilities)
+            addCount(category, utility.first, utility.second);
+    }
+
+    // Sensitive content distribution.
+    QTreeWidgetItem* sensitiveCategory = addCategory(tr("Sensitive content"), -1);
+    QTreeWidgetItem* explicitCategory = new QTreeWidgetItem(sensitiveCategory, {tr("Explicit content")});
+    addCounts(explicitCategory, statistics->sensitiveContentCounts(ListStatistics::EXPLICIT_CONTENT));
+    QTreeWidgetItem* violenceCategory = new QTreeWidgetItem(sensitiveCategory, {tr("Violence")});
+    addCounts(violenceCategory, statistics->sensitiveContentCounts(ListStatistics::VIOLENCE_CONTENT));
+    QTreeWidgetItem* badLanguageCategory = new QTreeWidgetItem(sensitiveCategory, {tr("Bad language")});
+    addCounts(badLanguageCategory, statistics->sensitiveContentCounts(ListStatistics::BAD_LANGUAGE));
+}
+
+QTreeWidgetItem* StatisticsDock::addCategory(const QString& name, long long int count)
+{
+    // A top level row, without a count if count is negative.
+    QTreeWidgetItem* category = new QTreeWidgetItem(m_tree, {name});
+    if (count >= 0)
+        category->setText(1, QString::number(count));
+    return category;
+}
+
+void StatisticsDock::addCount(QTreeWidgetItem* category, const QString& name, long long int count)
+{
+    QTreeWidgetItem* item = new QTreeWidgetItem(category, {name, QString::number(count)});
+    item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+}
+
+void StatisticsDock::addCounts(QTreeWidgetItem* category, const QHash<int, long long int>& counts)
+{
+    // One row for each value, in ascending order.
+    QList<int> values = counts.keys();
+    std::sort(values.begin(), values.end());
+    for (int value : values)
+        addCount(category, QString::number(value), counts.value(value));
+}
@@ -0,0 +1,138 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StringDictionary.h"
+
+#include <QDataStream>
+#include <QByteArray>
+
+StringDictionary::StringDictionary()
+{}
+
+StringDictionary::~StringDictionary()
+{}
+
+void StringDictionary::write(QDataStream& out, const QString& str, StringChannel channel)
+{
+    Channel& c = m_channels[(int)channel];
+
+    // The string is already in the dictionary, writing only the reference.
+    QHash<QString, quint32>::const_iterator it = c.index.constFind(str);
+    if (it != c.index.constEnd())
+    {
+        writeVarint(out, (quint64)it.value() + 1);
+        return;
+    }
+
+    // New string, writing the shared prefix length, then the rest in UTF-8.
+    qsizetype prefix = 0;
+    qsizetype maxPrefix = qMin(str.size(), c.previous.size());
+    while (prefix < maxPrefix && str.at(prefix) == c.previous.at(prefix))
+        prefix++;
+    // Do not cut a surrogate pair.
+    if (prefix > 0 && str.at(prefix-1).isHighSurrogate())
+        prefix--;
+
+    QByteArray suffix = QStringView(str).mid(prefix).toUtf8();
+    writeVarint(out, 0);
+    writeVarint(out, (quint64)prefix);
+    writeVarint(out, (quint64)suffix.size());
+    out.writeRawData(suffix.constData(), suffix.size());
+
+    addString(c, str, true);
+}
+
+bool StringDictionary::read(QDataStream& in, QString& str, StringChannel channel)
+{
+    Channel& c = m_channels[(int)channel];
+
+    quint64 value;
+    if (!readVarint(in, value))
+        return false;
+
+    // A reference to a string of the dictionary.
+    if (value > 0)
+    {
+        if (value > (quint64)c.strings.size())
+            return false;
+        str = c.strings.at(value - 1);
+        return true;
+    }
+
+    // A new string, the sizes are checked before allocating anything.
+    quint64 prefix, suffixSize;
+    if (!readVarint(in, prefix) || !readVarint(in, suffixSize) ||
+        prefix > (quint64)c.previous.size() ||
+        suffixSize > (quint64)STRING_DICTIONARY_MAX_STRING_SIZE)
+        return false;
+
+    QByteArray suffix((qsizetype)suffixSize, Qt::Uninitialized);
+    if (in.readRawData(suffix.data(), (int)suffixSize) != (int)suffixSize)
+        return false;
+
+    if (suffixSize == 0 && prefix == (quint64)c.previous.size())
+        str = c.previous;
+    else
+        str = QStringView(c.previous).left((qsizetype)prefix).toString() + QString::fromUtf8(suffix);
+
+    addString(c, str, false);
+    return true;
+}
+
+void StringDictionary::addString(Channel& channel, const QString& str, bool isWriting)
+{
+    // The writer only need the index, the reader only need the list.
+    channel.previous = str;
+    if (isWriting)
+    {
+        if (channel.index.size() < STRING_DICTIONARY_MAX_SIZE)
+            channel.index.insert(str, (quint32)channel.index.size());
+    }
+    else if (channel.strings.size() < STRING_DICTIONARY_MAX_SIZE)
+        channel.strings.append(str);
+}
+
+void StringDictionary::writeVarint(QDataStream& out, quint64 value)
+{
+    // 7 bits per byte, the high bit is set when another byte follow.
+    do
+    {
+        quint8 byte = value & 0x7F;
+        value >>= 7;
+        if (value)
+            byte |= 0x80;
+        out << byte;
+    } while (value);
+}
+
+bool StringDictionary::readVarint(QDataStream& in, quint64& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        quint8 byte;
+        in >> byte;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        value |= (quint64)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+
+    return false;
+}
@@ -26,6 +26,12 @@
 #include "SaveInterface.h"
 #include "UtilityListView.h"
 #include "TabLineEdit.h"
+#include "TableModel.h"
+#include "TableModel_UtilityInterface.h"
+#include "ListFileDialog.h"
+#include "ListExporter.h"
+#include "ListImporter.h"
+#include "ImportDialog.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -37,6 +43,11 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QCloseEvent>
+#include <QDataStream>
+#include <QTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QProgressDialog>
 
 TabAndList::TabAndList(QSqlDatabase& db, QWidget* parent) :
     QWidget(parent),
@@ -45,9 +56,18 @@ TabAndList::TabAndList(QSqlDatabase& db, QWidget* parent) :
     m_stackedViews(new QStackedLayout()),
     m_listType(ListType::UNKNOWN),
     m_sqlUtilityTable(m_listType, m_db),
-    m_isListModified(false)
+    m_isListModified(false),
+    m_journal(m_db),
+    m_autoSave(m_db),
+    m_autoSaveTimer(new QTimer(this)),
+    m_isAutoSaveNeeded(false)
 {
     setupView();
+
+    // The modified list is autosaved periodically in the background.
+    m_autoSaveTimer->setInterval(AUTOSAVE_INTERVAL);
+    connect(m_autoSaveTimer, &QTimer::timeout, this, &TabAndList::autoSave);
+    m_autoSaveTimer->start();
 }
 
 TabAndList::~TabAndList()
@@ -89,6 +109,16 @@ void TabAndList::tabChanged(int index)
 {
     if (index >= 0 && index < m_stackedViews->count())
     {
+        // The tables of a sectioned file are loaded on the first activation of their tab.
+        AbstractListView* pendingView = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(index));
+        if (m_pendingTables.contains(pendingView) && !loadTable(pendingView))
+            QMessageBox::critical(
+                this,
+                tr("Failed to load table."),
+                tr("Failed to load the table %1 from the file %2.").arg(m_tabBar->tabText(index), m_baseFilePath),
+                QMessageBox::Ok,
+                QMessageBox::Ok);
+
         m_stackedViews->setCurrentIndex(index);
         AbstractListView* v = dynamic_cast<AbstractListView*>(m_stackedViews->currentWidget());
         if (v)
@@ -99,11 +129,13 @@ void TabAndList::tabChanged(int index)
             else
                 emit isCopyPasteEditVisible(true);
         }
+        emit currentListChanged(v ? v->tableModel() : nullptr);
     }
     else
     {
         emit isAddDelEditVisible(false);
         emit isCopyPasteEditVisible(false);
+        emit currentListChanged(nullptr);
     }
 }
 
@@ -198,6 +230,7 @@ void TabAndList::removeTable(int index)
 
         m_stackedViews->removeWidget(widget);
         m_tabBar->removeTab(index);
+        m_pendingTables.remove(widget);
         if (widget->viewType() == ViewType::GAME || 
             widget->viewType() == ViewType::MOVIE ||
             widget->viewType() == ViewType::COMMON ||
@@ -218,6 +251,7 @@ void TabAndList::newGameList()
     if (!maybeSave())
         return;
 
+    closeBaseFile();
     for (int i = m_tabBar->count()-1; i >= 0; i--)
         m_tabBar->removeTab(i);
     for (int i = m_stackedViews->count()-1; i >= 0; i--)
@@ -242,6 +276,7 @@ void TabAndList::newMoviesList()
     if (!maybeSave())
         return;
     
+    closeBaseFile();
     for (int i = m_tabBar->count()-1; i >= 0; i--)
         m_tabBar->removeTab(i);
     for (int i = m_stackedViews->count()-1; i >= 0; i--)
@@ -265,6 +300,7 @@ void TabAndList::newCommonList()
     if (!maybeSave())
         return;
     
+    closeBaseFile();
     for (int i = m_tabBar->count()-1; i >= 0; i--)
         m_tabBar->removeTab(i);
     for (int i = m_stackedViews->count()-1; i >= 0; i--)
@@ -289,6 +325,7 @@ void TabAndList::newBooksList()
     if (!maybeSave())
         return;
     
+    closeBaseFile();
     for (int i = m_tabBar->count()-1; i>=0; i--)
         m_tabBar->removeTab(i);
     for (int i = m_stackedViews->count()-1; i>= 0; i--)
@@ -313,6 +350,7 @@ void TabAndList::newSeriesList()
     if (!maybeSave())
         return;
     
+    closeBaseFile();
     for (int i = m_tabBar->count()-1; i>=0; i--)
         m_tabBar->removeTab(i);
     for (int i = m_stackedViews->count()-1; i>=0; i--)
@@ -337,7 +375,8 @@ void TabAndList::open()
     if (!maybeSave())
         return;
 
-    QString filePath = QFileDialog::getOpenFileName(
+    // The dialog show a preview of the selected file from its metadata.
+    ListFileDialog dialog(
             this,
             tr("Open list"),
             m_currentDirectory,
@@ -346,6 +385,9 @@ void TabAndList::open()
                "Movies List File (*.mld);;"
                "Common List File (*.cld);;"
                "All Files (*)"));
+    QString filePath;
+    if (dialog.exec() == QDialog::Accepted && !dialog.selectedFiles().isEmpty())
+        filePath = dialog.selectedFiles().first();
         
     if (!filePath.isEmpty())
     {
@@ -414,6 +456,7 @@ void TabAndList::save()
         if (saveFile(m_filePath))
         {
             m_isListModified = false;
+            discardAutoSave();
             emit listChanged(false);
         }
         else
@@ -504,6 +547,7 @@ void TabAndList::saveAs()
                 m_filePath = filePath;
                 m_currentDirectory = QFileInfo(filePath).absolutePath();
                 m_isListModified = false;
+                discardAutoSave();
                 emit newListFileName(m_filePath);
             }
             else
@@ -524,291 +568,615 @@ void TabAndList::saveAs()
             QMessageBox::Ok);
 }
 
-bool TabAndList::saveFile(const QString& filePath) const
+void TabAndList::exportList()
 {
-    // Saving the list into a file.
-    if (m_listType == ListType::GAMELIST)
+    // Exporting every tab of the list into a CSV or a JSON Lines file.
+    if (m_listType == ListType::UNKNOWN)
     {
-        // Saving the game list.
-        Game::SaveData data = {};
+        QMessageBox::warning(
+            this,
+            tr("Exporting a list"),
+            tr("No list created."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
+
+    QString csvFilter = tr("CSV File (*.csv)");
+    QString jsonLinesFilter = tr("JSON Lines File (*.jsonl)");
+    QString selectedFilter;
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        tr("Export List"),
+        m_currentDirectory,
+        csvFilter + ";;" + jsonLinesFilter,
+        &selectedFilter);
+    if (filePath.isEmpty())
+        return;
 
-        QVariant variant;
+    ListExporter::Format format = ListExporter::Format::CSV;
+    if (selectedFilter == jsonLinesFilter || filePath.endsWith(".jsonl", Qt::CaseInsensitive))
+        format = ListExporter::Format::JSON_LINES;
 
-        // Getting the game data.
-        for (int i = 0; i < m_tabBar->count(); i++)
+    // The items are read from the SQL tables, the tables not loaded yet are loaded first.
+    bool result = loadPendingTables();
+    QFile file(filePath);
+    if (result)
+        result = file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+    if (result)
+    {
+        QTextStream out(&file);
+        ListExporter exporter(m_db, m_listType, format, out);
+        exporter.begin(m_filePath);
+        for (int i = 0; i < m_tabBar->count() && result; i++)
         {
             AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
-            
-            if (view->viewType() == ViewType::GAME)
-            {
-                GameListView* gameView = reinterpret_cast<GameListView*>(view);
-                variant = gameView->listData();
-                if (!variant.canConvert<Game::SaveDataTable>())
-                    return false;
-                data.gameTables.append(qvariant_cast<Game::SaveDataTable>(variant));
-            }
+            if (view->viewType() == ViewType::UTILITY)
+                continue;
+
+            result = exporter.exportTable(view->tableModel()->tableName(), view->tableModel()->sqlTableNames());
         }
+        exporter.end();
+        file.close();
+        result = result && file.error() == QFileDevice::NoError;
+    }
 
-        // Getting the utility data.
-        variant = m_sqlUtilityTable.data();
-        if (!variant.canConvert<Game::SaveUtilityData>())
-            return false;
-        data.utilityData = qvariant_cast<Game::SaveUtilityData>(variant);
+    if (!result)
+        QMessageBox::critical(
+            this,
+            tr("Export List"),
+            tr("Exporting the list into the file %1 failed.").arg(filePath),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+}
 
-        // Save to a file.
-        return SaveInterface::save(filePath, QVariant::fromValue(data));
-    }
-    else if (m_listType == ListType::MOVIESLIST)
+void TabAndList::importItems()
+{
+    // Importing items from a CSV or a JSON Lines file into the current tab.
+    AbstractListView* view = dynamic_cast<AbstractListView*>(m_stackedViews->currentWidget());
+    if (!view || view->viewType() == ViewType::UTILITY || m_listType == ListType::UNKNOWN)
     {
-        // Saving the movies list into a file.
-        Movie::SaveData data = {};
+        QMessageBox::warning(
+            this,
+            tr("Importing items"),
+            tr("Select the tab where the items are imported."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
 
-        QVariant variant;
+    QString filePath = QFileDialog::getOpenFileName(
+        this,
+        tr("Import items"),
+        m_currentDirectory,
+        tr("Items File (*.csv *.jsonl);;"
+           "CSV File (*.csv);;"
+           "JSON Lines File (*.jsonl);;"
+           "All Files (*)"));
+    if (filePath.isEmpty())
+        return;
 
-        // Retrieving the list data.
-        for (int i = 0; i < m_tabBar->count(); i++)
-        {
-            AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+    ListImporter importer(m_db, m_sqlUtilityTable, m_listType);
+    if (!importer.read(filePath))
+    {
+        QMessageBox::critical(
+            this,
+            tr("Import items"),
+            tr("Failed to read the file %1.").arg(filePath),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        return;
+    }
 
-            if (view->viewType() == ViewType::MOVIE)
-            {
-                MoviesListView* moviesView = reinterpret_cast<MoviesListView*>(view);
-                variant = moviesView->listData();
-                if (!variant.canConvert<Movie::SaveDataTable>())
-                    return false;
-                data.movieTables.append(qvariant_cast<Movie::SaveDataTable>(variant));
-            }
-        }
+    ImportDialog dialog(importer.fileColumns(), importer.listColumns(), importer.defaultMapping(), importer.rowCount(), this);
+    if (dialog.exec() != QDialog::Accepted)
+        return;
 
-        // Retrieving the utility data.
-        variant = m_sqlUtilityTable.data();
-        if (!variant.canConvert<Movie::SaveUtilityData>())
-            return false;
-        data.utilityData = qvariant_cast<Movie::SaveUtilityData>(variant);
+    // The table must be loaded before inserting the items into it.
+    if (m_pendingTables.contains(view) && !loadTable(view))
+        return;
 
-        // Save into a file.
-        return SaveInterface::save(filePath, QVariant::fromValue(data));
+    QProgressDialog progressDialog(tr("Importing items..."), tr("Cancel"), 0, 100, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(500);
+    bool result = importer.import(view->tableModel()->sqlTableNames(), dialog.mapping(),
+        [&progressDialog](long long int done, long long int total) -> bool
+        {
+            progressDialog.setValue(total > 0 ? (int)(done * 100 / total) : 100);
+            return !progressDialog.wasCanceled();
+        });
+    // reset clear the cancellation of the dialog, a canceled import is rolled back without error.
+    bool isCanceled = progressDialog.wasCanceled();
+    progressDialog.reset();
+
+    if (result)
+    {
+        view->tableModel()->updateQuery();
+        view->tableModel()->invalidateStatistics();
+        emit m_sqlUtilityTable.utilityEdited();
     }
+    else if (!isCanceled)
+        QMessageBox::critical(
+            this,
+            tr("Import items"),
+            tr("Importing the items of the file %1 failed.").arg(filePath),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+}
+
+bool TabAndList::saveFile(const QString& filePath)
+{
+    // Saving the list into a file.
+    // The tables are streamed from the SQL database directly into the file,
+    // tab by tab, so the list is never copied into memory.
+    ViewType viewType;
+    if (m_listType == ListType::GAMELIST)
+        viewType = ViewType::GAME;
+    else if (m_listType == ListType::MOVIESLIST)
+        viewType = ViewType::MOVIE;
     else if (m_listType == ListType::COMMONLIST)
-    {
-        // Saving the common list into a file.
-        Common::SaveData data = {};
+        viewType = ViewType::COMMON;
+    else if (m_listType == ListType::BOOKSLIST)
+        viewType = ViewType::BOOKS;
+    else if (m_listType == ListType::SERIESLIST)
+        viewType = ViewType::SERIES;
+    else
+        return false;
 
-        QVariant variant;
+    // A list saved into the file it was opened from only append its changes to the journal of the file.
+    if (appendJournal(filePath))
+        return true;
 
-        // Retrieve the list data.
-        for (int i = 0; i < m_tabBar->count(); i++)
-        {
-            AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+    // The tables not loaded yet are loaded before being saved.
+    if (!loadPendingTables())
+        return false;
 
-            if (view->viewType() == ViewType::COMMON)
+    // Each view is written into its own section of the file.
+    QList<SaveInterface::SaveTableSection> tables;
+    for (int i = 0; i < m_tabBar->count(); i++)
+    {
+        const AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+        if (view->viewType() != viewType)
+            continue;
+
+        tables.append({view->tableModel()->rawTableName(), view->tableModel()->itemCount(),
+            [view](QDataStream& out) -> bool
             {
-                CommonListView* commonView = reinterpret_cast<CommonListView*>(view);
-                variant = commonView->listData();
-                if (!variant.canConvert<Common::SaveDataTable>())
-                    return false;
-                data.commonTables.append(qvariant_cast<Common::SaveDataTable>(variant));
-            }
-        }
+                return view->writeListData(out);
+            },
+            view->tableModel()->topItems(FILE_METADATA_TOP_ITEMS)});
+    }
 
-        // Retrieving the utility data.
-        variant = m_sqlUtilityTable.data();
-        if (!variant.canConvert<Common::SaveUtilityData>())
-            return false;
-        data.utilityData = qvariant_cast<Common::SaveUtilityData>(variant);
+    bool result = SaveInterface::save(filePath, m_listType, tables,
+        [this](QDataStream& out) -> bool
+        {
+            return m_sqlUtilityTable.writeData(out);
+        });
+    if (!result)
+        return false;
 
-        // Save into a file.
-        return SaveInterface::save(filePath, QVariant::fromValue(data));
-    }
-    else if (m_listType == ListType::BOOKSLIST)
+    // The whole list is in the file, the journal is replaced by a new one based on this file.
+    closeBaseFile();
+    SaveJournal::remove(filePath);
+    if (SaveInterface::readTableOfContents(filePath, m_tableOfContents))
     {
-        // Saving the books list.
-        Books::SaveData data = {};
+        m_baseFilePath = filePath;
+        m_journal.track();
+    }
 
-        QVariant variant;
+    return true;
+}
 
-        // Getting the books data.
-        for (int i = 0; i < m_tabBar->count(); i++)
-        {
-            AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+bool TabAndList::appendJournal(const QString& filePath)
+{
+    // The changes are appended to the journal only if the tables are the tables of the file, in the same order.
+    // Adding, removing, renaming or moving a table, or a journal too big, need a full save.
+    if (m_baseFilePath.isEmpty() ||
+        filePath != m_baseFilePath ||
+        m_tableOfContents.type != m_listType ||
+        !m_journal.isTracking() ||
+        SaveJournal::needCompaction(filePath))
+        return false;
 
-            if (view->viewType() == ViewType::BOOKS)
-            {
-                BooksListView* booksView = reinterpret_cast<BooksListView*>(view);
-                variant = booksView->listData();
-                if (!variant.canConvert<Books::SaveDataTable>())
-                    return false;
-                data.booksTables.append(qvariant_cast<Books::SaveDataTable>(variant));
-            }
-        }
+    QHash<QString, QByteArray> viewsSettings;
+    int tableIndex = 0;
+    for (int i = 0; i < m_stackedViews->count(); i++)
+    {
+        AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+        if (view->viewType() == ViewType::UTILITY)
+            continue;
 
-        // Getting the utility data.
-        variant = m_sqlUtilityTable.data();
-        if (!variant.canConvert<Books::SaveUtilityData>())
+        const QString tableName = view->tableModel()->rawTableName();
+        if (tableIndex >= m_tableOfContents.tables.size() ||
+            m_tableOfContents.tables.at(tableIndex).tableName != tableName)
             return false;
-        data.utilityData = qvariant_cast<Books::SaveUtilityData>(variant);
+        tableIndex++;
 
-        // Save to a file.
-        return SaveInterface::save(filePath, QVariant::fromValue(data));
+        // The settings of a table not loaded yet did not change.
+        if (m_pendingTables.contains(view))
+            continue;
+
+        QByteArray viewSettings;
+        QDataStream out(&viewSettings, QIODevice::WriteOnly);
+        if (!view->writeViewSettings(out))
+            return false;
+        viewsSettings.insert(tableName, viewSettings);
     }
-    else if (m_listType == ListType::SERIESLIST)
-    {
-        // Saving the series list.
-        Series::SaveData data = {};
 
-        QVariant variant;
+    if (tableIndex != m_tableOfContents.tables.size())
+        return false;
+
+    if (!m_journal.append(filePath, m_tableOfContents, viewsSettings))
+        return false;
+
+    // The metadata block of the file is refreshed so the previews show the list with its journal.
+    // The journal is written, a failure only leaves the previous preview.
+    updateMetadata(filePath);
+    return true;
+}
+
+bool TabAndList::updateMetadata(const QString& filePath) const
+{
+    // The tables not loaded yet did not change, their previous metadata are kept.
+    SaveInterface::FileMetadata previousMetadata = {};
+    SaveInterface::readMetadata(filePath, previousMetadata);
+
+    QList<SaveInterface::SaveTableSection> tables;
+    for (int i = 0; i < m_stackedViews->count(); i++)
+    {
+        AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+        if (view->viewType() == ViewType::UTILITY)
+            continue;
 
-        // Getting the books data.
-        for (int i = 0; i < m_tabBar->count(); i++)
+        SaveInterface::SaveTableSection table = {};
+        if (m_pendingTables.contains(view))
         {
-            AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
-            if (view->viewType() == ViewType::SERIES)
-            {
-                SeriesListView* seriesView = reinterpret_cast<SeriesListView*>(view);
-                variant = seriesView->listData();
-                if (!variant.canConvert<Series::SaveDataTable>())
-                    return false;
-                data.serieTables.append(qvariant_cast<Series::SaveDataTable>(variant));
-            }
+            SaveInterface::FileMetadataTable pendingTable = pendingTableMetadata(previousMetadata, m_pendingTables.value(view));
+            table.tableName = pendingTable.tableName;
+            table.rowCount = pendingTable.rowCount;
+            table.topItems = pendingTable.topItems;
         }
+        else
+        {
+            table.tableName = view->tableModel()->rawTableName();
+            table.rowCount = view->tableModel()->itemCount();
+            table.topItems = view->tableModel()->topItems(FILE_METADATA_TOP_ITEMS);
+        }
+        tables.append(table);
+    }
 
-        // Getting the utility data.
-        variant = m_sqlUtilityTable.data();
-        if (!variant.canConvert<Series::SaveUtilityData>())
-            return false;
-        data.utilityData = qvariant_cast<Series::SaveUtilityData>(variant);
+    return SaveInterface::updateMetadata(filePath, tables);
+}
 
-        // Save to a file
-        return SaveInterface::save(filePath, QVariant::fromValue(data));
+SaveInterface::FileMetadataTable TabAndList::pendingTableMetadata(const SaveInterface::FileMetadata& metadata, int tableIndex) const
+{
+    // The metadata of the file already count the changes of the journal, the table of contents does not.
+    // The table of contents is used if the metadata do not list the table.
+    const SaveInterface::FileSection& section = m_tableOfContents.tables.at(tableIndex);
+    SaveInterface::FileMetadataTable table = {};
+    table.tableName = section.tableName;
+    table.rowCount = section.rowCount;
+    if (tableIndex < metadata.tables.size() &&
+        metadata.tables.at(tableIndex).tableName == section.tableName.left(FILE_METADATA_NAME_SIZE))
+    {
+        table.rowCount = metadata.tables.at(tableIndex).rowCount;
+        table.topItems = metadata.tables.at(tableIndex).topItems;
     }
+    return table;
+}
 
-    return false;
+bool TabAndList::createList(ListType type)
+{
+    // Creating a new empty list of the type of the file.
+    newEmptyList();
+    if (type == ListType::GAMELIST)
+        newGameList();
+    else if (type == ListType::MOVIESLIST)
+        newMoviesList();
+    else if (type == ListType::COMMONLIST)
+        newCommonList();
+    else if (type == ListType::BOOKSLIST)
+        newBooksList();
+    else if (type == ListType::SERIESLIST)
+        newSeriesList();
+    return m_listType == type;
 }
 
 bool TabAndList::openFile(const QString& filePath)
 {
+    // A sectioned file is opened tab by tab.
+    SaveInterface::TableOfContents toc = {};
+    if (SaveInterface::readTableOfContents(filePath, toc))
+        return openSectionedFile(filePath, toc);
+
     // Opening file and apply everything into the view.
-    QVariant variant;
-    // Opening the file.
-    bool result = SaveInterface::open(filePath, variant);
-    if (!result)
-        return false;
-    
-    // Check if it's a game list data.
-    if (variant.canConvert<Game::SaveData>())
+    // The file is streamed chunk by chunk directly into the SQL tables,
+    // the views are queried once everything is inserted.
+    AbstractListView* currentView = nullptr;
+    QList<AbstractListView*> views;
+    QList<QVariant> viewsSettings;
+
+    SaveInterface::OpenStreamHandler handler;
+    handler.beginList = [this](ListType type) -> bool
     {
-        // Creating a new empty game list data.
-        newEmptyList();
-        newGameList();
-        Game::SaveData data = qvariant_cast<Game::SaveData>(variant);
-        result = m_sqlUtilityTable.setData(QVariant::fromValue(data.utilityData));
-        if (!result)
-            return false;
-        
-        for (int i = 0; i < data.gameTables.size(); i++)
-        {
-            GameListView* view = new GameListView(QVariant::fromValue(data.gameTables.at(i)), m_db, m_sqlUtilityTable, this);
-            if (view->listType() == ListType::UNKNOWN)
-                return false;
-            m_stackedViews->addWidget(view);
-            m_tabBar->addTab(view->tableName());
-            connect(view, &GameListView::listEdited, this, &TabAndList::listUpdated);
-        }
-
+        return createList(type);
+    };
+    handler.beginTable = [this, &currentView](const QString& tableName) -> bool
+    {
+        currentView = addListView(tableName);
+        return currentView != nullptr;
+    };
+    handler.itemsChunk = [&currentView](const QVariant& items) -> bool
+    {
+        return currentView->tableModel()->appendItemData(items);
+    };
+    handler.interfaceChunk = [&currentView](UtilityTableName tableName, const QList<Game::SaveUtilityInterfaceItem>& items) -> bool
+    {
+        return currentView->tableModel()->utilityInterface()->appendData(tableName, items);
+    };
+    handler.sensitiveContentChunk = [&currentView](const QList<Game::SaveUtilitySensitiveContentItem>& items) -> bool
+    {
+        return currentView->tableModel()->utilityInterface()->appendSensitiveContent(items);
+    };
+    handler.endTable = [&currentView, &views, &viewsSettings](const QVariant& table) -> bool
+    {
+        // The columns size and the sorting are applied once the utility tables are loaded.
+        views.append(currentView);
+        viewsSettings.append(table);
+        currentView = nullptr;
         return true;
-    }
-    else if (variant.canConvert<Movie::SaveData>())
+    };
+    handler.utilityChunk = [this](UtilityTableName tableName, const QList<ItemUtilityData>& items) -> bool
     {
-        // Creating a new empty movies list data.
-        newEmptyList();
-        newMoviesList();
-        Movie::SaveData data = qvariant_cast<Movie::SaveData>(variant);
-        result = m_sqlUtilityTable.setData(QVariant::fromValue(data.utilityData));
-        if (!result)
-            return false;
-        
-        for (int i = 0; i < data.movieTables.size(); i++)
-        {
-            MoviesListView* view = new MoviesListView(QVariant::fromValue(data.movieTables.at(i)), m_db, m_sqlUtilityTable, this);
-            if (view->listType() == ListType::UNKNOWN)
-                return false;
-            m_stackedViews->addWidget(view);
-            m_tabBar->addTab(view->tableName());
-            connect(view, &MoviesListView::listEdited, this, &TabAndList::listUpdated);
-        }
+        return m_sqlUtilityTable.appendData(tableName, items);
+    };
 
-        return true;
+    if (!SaveInterface::open(filePath, handler))
+        return false;
+
+    // Everything is inserted, querying the tables.
+    for (int i = 0; i < views.size(); i++)
+    {
+        views.at(i)->tableModel()->updateQuery();
+        views.at(i)->setColumnsSizeAndSortingOrder(viewsSettings.at(i));
     }
-    else if (variant.canConvert<Common::SaveData>())
+
+    return true;
+}
+
+bool TabAndList::openSectionedFile(const QString& filePath, const SaveInterface::TableOfContents& toc)
+{
+    // Only the utility data and the current tab are loaded,
+    // the other tabs are loaded on their first activation.
+    if (!createList(toc.type))
+        return false;
+
+    // The utility data is used by every tables, it's loaded first.
+    SaveInterface::OpenStreamHandler handler;
+    handler.utilityChunk = [this](UtilityTableName tableName, const QList<ItemUtilityData>& items) -> bool
     {
-        // Creating a new empty common list data.
-        newEmptyList();
-        newCommonList();
-        Common::SaveData data = qvariant_cast<Common::SaveData>(variant);
-        result = m_sqlUtilityTable.setData(QVariant::fromValue(data.utilityData));
-        if (!result)
-            return false;
-        
-        for (int i = 0; i < data.commonTables.size(); i++)
-        {
-            CommonListView* view = new CommonListView(QVariant::fromValue(data.commonTables.at(i)), m_db, m_sqlUtilityTable, this);
-            if (view->listType() == ListType::UNKNOWN)
-                return false;
-            m_stackedViews->addWidget(view);
-            m_tabBar->addTab(view->tableName());
-            connect(view, &CommonListView::listEdited, this, &TabAndList::listUpdated);
-        }
+        return m_sqlUtilityTable.appendData(tableName, items);
+    };
+    if (!SaveInterface::openUtility(filePath, toc, handler))
+        return false;
 
-        return true;
+    // The changes saved into the journal of the file are applied over the data of the file.
+    if (m_journal.read(filePath, toc))
+    {
+        QStringList utilityTableNames;
+        for (UtilityTableName tableName : SqlUtilityTable::utilityTables(m_listType))
+            utilityTableNames.append(SqlUtilityTable::tableName(tableName));
+        if (!m_journal.apply(utilityTableNames))
+            return false;
     }
-    else if (variant.canConvert<Books::SaveData>())
+
+    // Creating an empty view for each table, only the tabs are shown.
+    m_tableOfContents = toc;
+    m_baseFilePath = filePath;
+    for (int i = 0; i < toc.tables.size(); i++)
     {
-        // Creating the new empty books list data.
-        newEmptyList();
-        // Then creating an empty books list.
-        newBooksList();
-        Books::SaveData data = qvariant_cast<Books::SaveData>(variant);
-        result = m_sqlUtilityTable.setData(QVariant::fromValue(data.utilityData));
-        if (!result)
+        AbstractListView* view = addListView(toc.tables.at(i).tableName);
+        if (!view)
             return false;
-        
-        for (int i = 0; i < data.booksTables.size(); i++)
+        m_pendingTables.insert(view, i);
+        m_tabBar->setTabToolTip(
+            m_stackedViews->indexOf(view),
+            tr("%n item(s), loaded when the tab is opened.", "", (int)toc.tables.at(i).rowCount));
+    }
+
+    // The current tab is loaded now, then every changes are recorded for the journal.
+    AbstractListView* currentView = reinterpret_cast<AbstractListView*>(m_stackedViews->currentWidget());
+    if (currentView && !loadTable(currentView))
+        return false;
+    m_journal.track();
+    return true;
+}
+
+bool TabAndList::loadTable(AbstractListView* view)
+{
+    // Loading the rows of a table of a sectioned file into its empty view.
+    return loadTables({view});
+}
+
+bool TabAndList::loadTables(const QList<AbstractListView*>& views)
+{
+    // Loading the rows of several tables of a sectioned file into their empty views.
+    // The sections are decoded in parallel, the rows are inserted table by table in the order of views.
+    QList<int> indexes;
+    QHash<int, AbstractListView*> indexViews;
+    for (AbstractListView* view : views)
+    {
+        int index = m_pendingTables.value(view, -1);
+        if (index < 0 || indexViews.contains(index))
+            continue;
+        indexes.append(index);
+        indexViews.insert(index, view);
+    }
+    if (indexes.isEmpty())
+        return true;
+
+    return SaveInterface::openTables(m_baseFilePath, m_tableOfContents, indexes,
+        [this, &indexViews](int index, const SaveInterface::DecodedTable& table) -> bool
         {
-            BooksListView* view = new BooksListView(QVariant::fromValue(data.booksTables.at(i)), m_db, m_sqlUtilityTable, this);
-            if (view->listType() == ListType::UNKNOWN)
-                return false;
-            m_stackedViews->addWidget(view);
-            m_tabBar->addTab(view->tableName());
-            connect(view, &BooksListView::listEdited, this, &TabAndList::listUpdated);
-        }
+            return insertTable(indexViews.value(index), table);
+        });
+}
 
+bool TabAndList::insertTable(AbstractListView* view, const SaveInterface::DecodedTable& table)
+{
+    // Inserting the rows of a decoded table into its empty view.
+    QVariant viewSettings;
+    SaveInterface::OpenStreamHandler handler;
+    handler.beginTable = [](const QString& tableName) -> bool
+    {
+        // The view already exist.
+        return true;
+    };
+    handler.itemsChunk = [view](const QVariant& items) -> bool
+    {
+        return view->tableModel()->appendItemData(items);
+    };
+    handler.interfaceChunk = [view](UtilityTableName tableName, const QList<Game::SaveUtilityInterfaceItem>& items) -> bool
+    {
+        return view->tableModel()->utilityInterface()->appendData(tableName, items);
+    };
+    handler.sensitiveContentChunk = [view](const QList<Game::SaveUtilitySensitiveContentItem>& items) -> bool
+    {
+        return view->tableModel()->utilityInterface()->appendSensitiveContent(items);
+    };
+    handler.endTable = [&viewSettings](const QVariant& table) -> bool
+    {
+        viewSettings = table;
         return true;
+    };
+
+    // The rows are inserted in a transaction, if the reading fail
+    // (the file changed since it was opened), the table stay empty and pending.
+    // The changes of the journal are applied in the same transaction.
+    const QStringList sqlTableNames = view->tableModel()->sqlTableNames();
+    m_db.transaction();
+    if (!SaveInterface::replayTable(table, handler) ||
+        !m_journal.apply(sqlTableNames))
+    {
+        m_db.rollback();
+        return false;
     }
-    else if (variant.canConvert<Series::SaveData>())
+    m_db.commit();
+
+    // Loading the table is not a change of the list.
+    m_journal.clearChanges(sqlTableNames);
+
+    m_pendingTables.remove(view);
+    m_tabBar->setTabToolTip(m_stackedViews->indexOf(view), QString());
+    view->tableModel()->updateQuery();
+    view->setColumnsSizeAndSortingOrder(viewSettings);
+
+    // The last settings of the view saved into the journal.
+    QByteArray journalSettings = m_journal.viewSettings(view->tableModel()->rawTableName());
+    if (!journalSettings.isEmpty())
     {
-        // Creating the new empty series list data.
-        newEmptyList();
-        // Then creating an empty series list.
-        newSeriesList();
-        Series::SaveData data = qvariant_cast<Series::SaveData>(variant);
-        result = m_sqlUtilityTable.setData(QVariant::fromValue(data.utilityData));
-        if (!result)
-            return false;
-        
-        for (int i = 0; i < data.serieTables.size(); i++)
-        {
-            SeriesListView* view = new SeriesListView(QVariant::fromValue(data.serieTables.at(i)), m_db, m_sqlUtilityTable, this);
-            if (view->listType() == ListType::UNKNOWN)
-                return false;
-            m_stackedViews->addWidget(view);
-            m_tabBar->addTab(view->tableName());
-            connect(view, &SeriesListView::listEdited, this, &TabAndList::listUpdated);
-        }
+        QDataStream in(journalSettings);
+        view->readViewSettings(in);
+    }
+    return true;
+}
 
-        return true;
+void TabAndList::closeBaseFile()
+{
+    // Forgetting the file the list was opened from or saved into, and its journal.
+    m_pendingTables.clear();
+    m_tableOfContents = {};
+    m_baseFilePath.clear();
+    m_journal.untrack();
+    m_journal.clear();
+}
+
+bool TabAndList::loadPendingTables()
+{
+    // Loading every tables not loaded yet, in the order of the tabs.
+    QList<AbstractListView*> views;
+    for (int i = 0; i < m_stackedViews->count(); i++)
+    {
+        AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+        if (m_pendingTables.contains(view))
+            views.append(view);
+    }
+
+    return loadTables(views);
+}
+
+AbstractListView* TabAndList::addListView(const QString& tableName)
+{
+    // Creating an empty view of the current list type, with the SQL tables named tableName,
+    // the items are inserted afterward by the streaming open.
+    AbstractListView* view = nullptr;
+    if (m_listType == ListType::GAMELIST)
+    {
+        Game::SaveDataTable data = {};
+        data.tableName = tableName;
+        data.columnSort = -1;
+        GameListView* gameView = new GameListView(QVariant::fromValue(data), m_db, m_sqlUtilityTable, this);
+        connect(gameView, &GameListView::listEdited, this, &TabAndList::listUpdated);
+        if (gameView->listType() != ListType::UNKNOWN)
+            view = gameView;
+        else
+            delete gameView;
+    }
+    else if (m_listType == ListType::MOVIESLIST)
+    {
+        Movie::SaveDataTable data = {};
+        data.tableName = tableName;
+        data.columnSort = -1;
+        MoviesListView* movieView = new MoviesListView(QVariant::fromValue(data), m_db, m_sqlUtilityTable, this);
+        connect(movieView, &MoviesListView::listEdited, this, &TabAndList::listUpdated);
+        if (movieView->listType() != ListType::UNKNOWN)
+            view = movieView;
+        else
+            delete movieView;
+    }
+    else if (m_listType == ListType::COMMONLIST)
+    {
+        Common::SaveDataTable data = {};
+        data.tableName = tableName;
+        data.columnSort = -1;
+        CommonListView* commonView = new CommonListView(QVariant::fromValue(data), m_db, m_sqlUtilityTable, this);
+        connect(commonView, &CommonListView::listEdited, this, &TabAndList::listUpdated);
+        if (commonView->listType() != ListType::UNKNOWN)
+            view = commonView;
+        else
+            delete commonView;
+    }
+    else if (m_listType == ListType::BOOKSLIST)
+    {
+        Books::SaveDataTable data = {};
+        data.tableName = tableName;
+        data.columnSort = -1;
+        BooksListView* booksView = new BooksListView(QVariant::fromValue(data), m_db, m_sqlUtilityTable, this);
+        connect(booksView, &BooksListView::listEdited, this, &TabAndList::listUpdated);
+        if (booksView->listType() != ListType::UNKNOWN)
+            view = booksView;
+        else
+            delete booksView;
+    }
+    else if (m_listType == ListType::SERIESLIST)
+    {
+        Series::SaveDataTable data = {};
+        data.tableName = tableName;
+        data.columnSort = -1;
+        SeriesListView* seriesView = new SeriesListView(QVariant::fromValue(data), m_db, m_sqlUtilityTable, this);
+        connect(seriesView, &SeriesListView::listEdited, this, &TabAndList::listUpdated);
+        if (seriesView->listType() != ListType::UNKNOWN)
+            view = seriesView;
+        else
+            delete seriesView;
     }
 
-    return false;
+    if (view)
+    {
+        m_stackedViews->addWidget(view);
+        m_tabBar->addTab(view->tableModel()->tableName());
+    }
+    return view;
 }
 
 void TabAndList::openUtility(UtilityTableName tableName)
@@ -830,8 +1198,20 @@ void TabAndList::openUtility(UtilityTableName tableName)
     }
 
     // If not, let's opening the editor.
+    // The editor can change the items of every tables, so they must be loaded.
     if (!isUtilityOpen)
     {
+        if (!loadPendingTables())
+        {
+            QMessageBox::critical(
+                this,
+                tr("Failed to load table."),
+                tr("Failed to load the tables from the file %1.").arg(m_baseFilePath),
+                QMessageBox::Ok,
+                QMessageBox::Ok);
+            return;
+        }
+
         UtilityListView* view = new UtilityListView(&m_sqlUtilityTable, tableName, m_db, this);
         m_stackedViews->addWidget(view);
         m_tabBar->addTab(SqlUtilityTable::tableName(tableName));
@@ -914,7 +1294,124 @@ void TabAndList::listUpdated()
     // leave without exiting when he is going to exit the application.
 
     m_isListModified = true;
+    m_isAutoSaveNeeded = true;
+    emit listChanged(true);
+}
+
+void TabAndList::autoSave()
+{
+    // Autosaving the list if it changed since the last autosave.
+    if (!m_isAutoSaveNeeded || !m_isListModified || m_autoSave.isRunning() || m_listType == ListType::UNKNOWN)
+        return;
+
+    // The snapshot of the database only contain the loaded tables, the sections of the tables not loaded
+    // yet are copied from the list file by the worker thread. A table is loaded only if its section is not
+    // up to date: the journal has changes for it, or the file is not of the current version.
+    // A restored list is opened from the recovery file, which is replaced by the autosave.
+    ListType baseType = ListType::UNKNOWN;
+    int baseVersion = -1;
+    bool canCopySections = !m_pendingTables.isEmpty() &&
+        m_baseFilePath != AutoSave::recoveryFilePath() &&
+        SaveInterface::readFileVersion(m_baseFilePath, baseType, baseVersion) &&
+        baseType == m_listType &&
+        baseVersion == SaveInterface::currentVersion(m_listType);
+    QList<AbstractListView*> outdatedViews;
+    for (int i = 0; i < m_stackedViews->count(); i++)
+    {
+        AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+        if (m_pendingTables.contains(view) &&
+            (!canCopySections || m_journal.hasChanges(view->tableModel()->sqlTableNames())))
+            outdatedViews.append(view);
+    }
+    if (!loadTables(outdatedViews))
+        return;
+
+    SaveInterface::FileMetadata baseMetadata = {};
+    if (!m_pendingTables.isEmpty())
+        SaveInterface::readMetadata(m_baseFilePath, baseMetadata);
+
+    // The names of the SQL tables and the settings of the views are read here,
+    // the tables are written from the snapshot on the worker thread.
+    QList<AutoSave::TableSnapshot> tables;
+    for (int i = 0; i < m_stackedViews->count(); i++)
+    {
+        AbstractListView* view = reinterpret_cast<AbstractListView*>(m_stackedViews->widget(i));
+        if (view->viewType() == ViewType::UTILITY)
+            continue;
+
+        AutoSave::TableSnapshot table = {};
+        if (m_pendingTables.contains(view))
+        {
+            int tableIndex = m_pendingTables.value(view);
+            SaveInterface::FileMetadataTable pendingTable = pendingTableMetadata(baseMetadata, tableIndex);
+            table.rowCount = pendingTable.rowCount;
+            table.topItems = pendingTable.topItems;
+            table.sourceFilePath = m_baseFilePath;
+            table.sourceSection = m_tableOfContents.tables.at(tableIndex);
+            tables.append(table);
+            continue;
+        }
+
+        table.sqlTableNames = view->tableModel()->sqlTableNames();
+        table.rowCount = view->tableModel()->itemCount();
+        table.topItems = view->tableModel()->topItems(FILE_METADATA_TOP_ITEMS);
+        QDataStream out(&table.viewSettings, QIODevice::WriteOnly);
+        if (!view->writeViewSettings(out))
+            return;
+        tables.append(table);
+    }
+
+    if (m_autoSave.save(m_listType, m_filePath, tables))
+        m_isAutoSaveNeeded = false;
+}
+
+void TabAndList::discardAutoSave()
+{
+    // The list is saved or closed, its autosave is not needed anymore.
+    m_isAutoSaveNeeded = false;
+    m_autoSave.discard();
+}
+
+bool TabAndList::restoreAutoSave()
+{
+    // The recovery file still exist if the program was not closed properly.
+    if (!AutoSave::hasRecovery())
+        return false;
+
+    QString listFilePath = AutoSave::recoveryListFilePath();
+    QMessageBox::StandardButton button = QMessageBox::question(
+        this,
+        tr("Restore the list"),
+        listFilePath.isEmpty() ?
+            tr("The program was not closed properly, an unsaved list has been autosaved.\nDo you want to restore it?") :
+            tr("The program was not closed properly, the list %1 has been autosaved.\nDo you want to restore it?").arg(listFilePath),
+        QMessageBox::Yes | QMessageBox::No,
+        QMessageBox::Yes);
+
+    if (button != QMessageBox::Yes)
+    {
+        discardAutoSave();
+        return false;
+    }
+
+    // The recovery file is kept until the list is saved.
+    if (!openFile(AutoSave::recoveryFilePath()))
+    {
+        QMessageBox::critical(
+            this,
+            tr("Failed to restore the list."),
+            tr("Failed to open the autosaved list."),
+            QMessageBox::Ok,
+            QMessageBox::Ok);
+        newEmptyList();
+        return false;
+    }
+
+    m_filePath = listFilePath;
+    m_isListModified = true;
+    emit newListFileName(m_filePath);
     emit listChanged(true);
+    return true;
 }
 
 bool TabAndList::maybeSave()
@@ -940,6 +1437,10 @@ bool TabAndList::maybeSave()
             return false;
     }
 
+    // There is no change or they are discarded, the autosave of the list is removed.
+    // Without list, it may be the recovery file being restored, it's kept.
+    if (m_listType != ListType::UNKNOWN)
+        discardAutoSave();
     return true;
 }
 
@@ -962,6 +1463,7 @@ void TabAndList::newEmptyList()
 {
     // Creating a new empty list, this member
     // function is used by the open member function.
+    closeBaseFile();
     for (int i = 0; i < m_tabBar->count(); i++)
         m_tabBar->removeTab(i);
     for (int i = 0; i < m_stackedViews->count(); i++)
@@ -18,10 +18,12 @@
 
 #include "TableModel.h"
 #include "TableModel_UtilityInterface.h"
+#include "ListStatistics.h"
 #include "UtilityInterfaceEditor.h"
 #include "UtilitySensitiveContentEditor.h"
 #include "Common.h"
 #include <QSqlError>
+#include <QDataStream>
 #include <iostream>
 #include <algorithm>
 
@@ -33,7 +35,8 @@ TableModel::TableModel(const QString& tableName, QSqlDatabase& db, SqlUtilityTab
     m_isTableCreated(false),
     m_isTableChanged(false),
     m_sortingColumnID(-1),
-    m_sortingOrder(Qt::AscendingOrder)
+    m_sortingOrder(Qt::AscendingOrder),
+    m_statistics(nullptr)
 {
     m_tableName = checkingIfNameFree(replaceSpaceByUnderscore(replaceMultipleSpaceByOne(removeFirtAndLastSpaces(tableName))));
 }
@@ -46,7 +49,8 @@ TableModel::TableModel(QSqlDatabase& db, SqlUtilityTable& utilityTable, QObject*
     m_isTableCreated(false),
     m_isTableChanged(false),
     m_sortingColumnID(-1),
-    m_sortingOrder(Qt::AscendingOrder)
+    m_sortingOrder(Qt::AscendingOrder),
+    m_statistics(nullptr)
 {}
 
 TableModel::~TableModel()
@@ -175,4 +179,285 @@ bool TableModel::isFilterEnabled() const
         return true;
     else
         return false;
-}
\ No newline at end of file
+}
+
+void TableModel::writeSortingData(QDataStream& out) const
+{
+    // Same values than the columnSort and sortOrder of the SaveDataTable.
+    out << (signed char)m_sortingColumnID;
+    out << (unsigned char)(m_sortingOrder == Qt::AscendingOrder ? 0 : 1);
+}
+
+long long int TableModel::itemCount() const
+{
+    if (!m_isTableCreated)
+        return 0;
+
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("SELECT COUNT(*) FROM \"%1\";").arg(m_tableName)) || !query.next())
+        return 0;
+    return query.value(0).toLongLong();
+}
+
+QStringList TableModel::topItems(int count) const
+{
+    QStringList names;
+    if (!m_isTableCreated)
+        return names;
+
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("SELECT Name FROM \"%1\" WHERE Rate > 0 ORDER BY Rate DESC, rowid LIMIT %2;").arg(m_tableName).arg(count)))
+        return names;
+    while (query.next())
+        names.append(query.value(0).toString());
+    return names;
+}
+
+ListStatistics* TableModel::statistics()
+{
+    // The statistics are only maintained once something read them.
+    if (!m_statistics)
+        m_statistics = new ListStatistics(this, m_utilityTable, m_db);
+    return m_statistics;
+}
+
+void TableModel::invalidateStatistics()
+{
+    if (m_statistics)
+        m_statistics->invalidate();
+}
+
+bool TableModel::bulkSetRate(const QModelIndexList& indexList, int rate)
+{
+    // Set the rate of all the selected items with one UPDATE.
+    QList<int> rows = selectedRows(indexList);
+    if (!m_isTableCreated || rows.isEmpty())
+        return false;
+
+    QString statement = QString(
+        "UPDATE \"%1\"\n"
+        "SET\n"
+        "   Rate = %2\n"
+        "WHERE\n"
+        "   rowid IN (%3);")
+            .arg(m_tableName)
+            .arg(rate)
+            .arg(itemIDList(rows));
+
+    if (!execBulkStatements({statement}))
+        return false;
+
+    if (m_statistics)
+    {
+        for (int row : rows)
+            m_statistics->rateChanged(itemID(index(row, 0)), rate);
+    }
+    setRowsRate(rows, rate);
+    emit listEdited();
+    return true;
+}
+
+bool TableModel::bulkEditUtilities(const QModelIndexList& indexList, UtilityTableName tableName, const QList<long long int>& utilitiesID, BulkEditMode mode)
+{
+    // Add, remove or replace the utilities of all the selected items,
+    // the links are inserted with one INSERT SELECT instead of one statement by item.
+    QList<int> rows = selectedRows(indexList);
+    TableModel_UtilityInterface* dataInterface = utilityInterface();
+    if (!m_isTableCreated || !dataInterface || rows.isEmpty() || tableName == UtilityTableName::SENSITIVE_CONTENT)
+        return false;
+    if (utilitiesID.isEmpty() && mode != BulkEditMode::REPLACE)
+        return true;
+
+    QString itemsID = itemIDList(rows);
+    QString utilityList;
+    for (int i = 0; i < utilitiesID.size(); i++)
+    {
+        if (i > 0)
+            utilityList += ", ";
+        utilityList += QString::number(utilitiesID.at(i));
+    }
+    QString interfaceTableName = dataInterface->tableName(tableName);
+    QString utilityTableName = m_utilityTable.tableName(tableName);
+
+    QStringList statements;
+    if (mode == BulkEditMode::REPLACE)
+        statements.append(QString(
+            "DELETE FROM \"%1\"\n"
+            "WHERE\n"
+            "   ItemID IN (%2);")
+                .arg(interfaceTableName, itemsID));
+    else if (mode == BulkEditMode::REMOVE)
+        statements.append(QString(
+            "DELETE FROM \"%1\"\n"
+            "WHERE\n"
+            "   ItemID IN (%2)\n"
+            "   AND UtilityID IN (%3);")
+                .arg(interfaceTableName, itemsID, utilityList));
+
+    if (mode != BulkEditMode::REMOVE && !utilitiesID.isEmpty())
+        statements.append(QString(
+            "INSERT INTO \"%1\" (ItemID, UtilityID)\n"
+            "SELECT\n"
+            "   \"%2\".rowid,\n"
+            "   \"%3\".\"%3ID\"\n"
+            "FROM\n"
+            "   \"%2\", \"%3\"\n"
+            "WHERE\n"
+            "   \"%2\".rowid IN (%4)\n"
+            "   AND \"%3\".\"%3ID\" IN (%5)\n"
+            "   AND NOT EXISTS (\n"
+            "       SELECT 1 FROM \"%1\"\n"
+            "       WHERE \"%1\".ItemID = \"%2\".rowid AND \"%1\".UtilityID = \"%3\".\"%3ID\");")
+                .arg(interfaceTableName, m_tableName, utilityTableName, itemsID, utilityList));
+
+    if (!execBulkStatements(statements))
+        return false;
+
+    // Query the new utilities of the edited items at once.
+    QHash<long long int, QString> utilityNames;
+    QString statement = QString(
+        "SELECT\n"
+        "   \"%1\".ItemID,\n"
+        "   GROUP_CONCAT(\"%2\".Name, \", \")\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "INNER JOIN \"%2\" ON \"%2\".\"%2ID\" = \"%1\".UtilityID\n"
+        "WHERE\n"
+        "   \"%1\".ItemID IN (%3)\n"
+        "GROUP BY\n"
+        "   \"%1\".ItemID;")
+            .arg(interfaceTableName, utilityTableName, itemsID);
+
+#ifndef NDEBUG
+    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+    if (m_query.exec(statement))
+    {
+        while (m_query.next())
+            utilityNames.insert(m_query.value(0).toLongLong(), m_query.value(1).toString());
+        m_query.clear();
+    }
+    else
+    {
+        std::cerr << QString("Failed to query the utilities of the table %1.\n\t%2")
+            .arg(interfaceTableName, m_query.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+        m_query.clear();
+    }
+
+    invalidateStatistics();
+    setRowsUtility(rows, tableName, utilityNames);
+    emit listEdited();
+    return true;
+}
+
+bool TableModel::bulkSetSensitiveContent(const QModelIndexList& indexList, const SensitiveContent& sensitiveContent)
+{
+    // Replace the sensitive content of all the selected items.
+    QList<int> rows = selectedRows(indexList);
+    TableModel_UtilityInterface* dataInterface = utilityInterface();
+    if (!m_isTableCreated || !dataInterface || rows.isEmpty())
+        return false;
+
+    QString itemsID = itemIDList(rows);
+    QString sensitiveTableName = dataInterface->tableName(UtilityTableName::SENSITIVE_CONTENT);
+
+    QStringList statements;
+    statements.append(QString(
+        "DELETE FROM \"%1\"\n"
+        "WHERE\n"
+        "   ItemID IN (%2);")
+            .arg(sensitiveTableName, itemsID));
+    statements.append(QString(
+        "INSERT INTO \"%1\" (ItemID, ExplicitContent, ViolenceContent, BadLanguage)\n"
+        "SELECT\n"
+        "   rowid, %3, %4, %5\n"
+        "FROM\n"
+        "   \"%2\"\n"
+        "WHERE\n"
+        "   rowid IN (%6);")
+            .arg(sensitiveTableName, m_tableName)
+            .arg(sensitiveContent.explicitContent)
+            .arg(sensitiveContent.violenceContent)
+            .arg(sensitiveContent.badLanguageContent)
+            .arg(itemsID));
+
+    if (!execBulkStatements(statements))
+        return false;
+
+    invalidateStatistics();
+    setRowsSensitiveContent(rows, sensitiveContent);
+    emit listEdited();
+    return true;
+}
+
+QList<int> TableModel::selectedRows(const QModelIndexList& indexList) const
+{
+    // The rows of the selection, each row once and in ascending order.
+    QList<int> rows;
+    rows.reserve(indexList.size());
+    for (const QModelIndex& index : indexList)
+    {
+        if (index.isValid() && index.row() < rowCount())
+            rows.append(index.row());
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return rows;
+}
+
+QString TableModel::itemIDList(const QList<int>& rows) const
+{
+    QString itemsID;
+    for (int i = 0; i < rows.size(); i++)
+    {
+        if (i > 0)
+            itemsID += ", ";
+        itemsID += QString::number(itemID(index(rows.at(i), 0)));
+    }
+    return itemsID;
+}
+
+bool TableModel::execBulkStatements(const QStringList& statements)
+{
+    // All the statements of a bulk edit are applied, or none of them.
+    if (!m_db.transaction())
+    {
+        std::cerr << QString("Failed to begin the transaction of the bulk edit of the table %1.\n\t%2")
+            .arg(m_tableName, m_db.lastError().text())
+            .toLocal8Bit().constData()
+            << std::endl;
+        return false;
+    }
+
+    for (const QString& statement : statements)
+    {
+#ifndef NDEBUG
+        std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+        if (!m_query.exec(statement))
+        {
+            std::cerr << QString("Failed to apply the bulk edit of the table %1.\n\t%2")
+                .arg(m_tableName, m_query.lastError().text())
+                .toLocal8Bit().constData()
+                << std::endl;
+            m_query.clear();
+            m_db.rollback();
+            return false;
+        }
+        m_query.clear();
+    }
+
+    return m_db.commit();
+}
+
+QStringList TableModel::sqlTableNames()
+{
+    QStringList tableNames;
+    tableNames.append(m_tableName);
+    tableNames.append(utilityInterface()->tableNames());
+    return tableNames;
+}
@@ -17,8 +17,11 @@
 */
 
 #include "TableModelBooks.h"
+#include "ListStatistics.h"
+#include "SaveInterface.h"
 #include "TableModelBooks_UtilityInterface.h"
 #include <QSqlError>
+#include <QDataStream>
 #include <QApplication>
 #include <QClipboard>
 #include <iostream>
@@ -212,6 +215,8 @@ bool TableModelBooks::setData(const QModelIndex& index, const QVariant& data, in
                 bool result = updateField<int>("Rate", index.row(), rate);
                 if (result)
                 {
+                    if (m_statistics)
+                        m_statistics->rateChanged(itemID(index), rate);
                     emit dataChanged(index, index, {Qt::EditRole});
                     emit listEdited();
                 }
@@ -332,6 +337,8 @@ bool TableModelBooks::removeRows(int row, int count, const QModelIndex& parent)
             
             m_data.remove(row, count);
             m_interface->rowRemoved(itemsID);
+            if (m_statistics)
+                m_statistics->itemsRemoved(itemsID);
 
             endRemoveRows();
 
@@ -655,66 +662,56 @@ void TableModelBooks::updateQuery()
 #endif
 }
 
-QVariant TableModelBooks::retrieveData() const
+bool TableModelBooks::setItemData(const QVariant& variant)
 {
-    // Return the data of the table and the utility interface data.
-    Books::SaveDataTable data = {};
-    data.tableName = m_tableName;
+    // Set the data into the TableModel SQL Tables.
+    const Books::SaveDataTable* table = variantValue<Books::SaveDataTable>(variant);
+    if (!table)
+        return false;
+    const Books::SaveDataTable& data = *table;
 
-    // Retrieve books data.
-    QSqlQuery query(m_db);
+    // Set the table name and create the SQL tables.
+    m_tableName = data.tableName;
+    if (m_tableName.isEmpty())
+        return false;
+    createTable();
 
-    QString statement = QString(
-        "SELECT\n"
-        "   BooksID,\n"
-        "   BooksPos,\n"
-        "   Name,\n"
-        "   Url,\n"
-        "   Rate\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   BooksID ASC;")
-            .arg(m_tableName);
-    
-    if (!query.exec(statement))
-        return QVariant();
-    
-    while (query.next())
+    // Set the books list.
+    if (!appendItemData(variant))
+        return false;
+
+    // Set the utility interface.
+    if (m_interface)
+    {
+        delete m_interface;
+        m_interface = nullptr;
+    }
+    m_interface = new TableModelBooks_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
+    if (!m_interface->isTableReady())
     {
-        Books::SaveItem book = {};
-        book.bookID = query.value(0).toLongLong();
-        book.bookPos = query.value(1).toLongLong();
-        book.name = query.value(2).toString();
-        book.url = query.value(3).toString();
-        book.rate = query.value(4).toInt();
-        data.booksList.append(book);
+        m_isTableCreated = false;
+        return false;
     }
 
-    QVariant utilityInterface = m_interface->data();
-    if (!utilityInterface.canConvert<Books::SaveUtilityInterfaceData>())
-        return QVariant();
-    
-    data.interface = qvariant_cast<Books::SaveUtilityInterfaceData>(utilityInterface);
-
-    data.columnSort = (signed char)m_sortingColumnID;
-    data.sortOrder = (unsigned char)(m_sortingOrder == Qt::AscendingOrder ? 0 : 1);
+    // Then, query the whole table.
+    updateQuery();
 
-    return QVariant::fromValue(data);
+    return true;
 }
 
-bool TableModelBooks::setItemData(const QVariant& variant)
+bool TableModelBooks::appendItemData(const QVariant& variant)
 {
-    // Set the data into the TableModel SQL Tables.
-    Books::SaveDataTable data = qvariant_cast<Books::SaveDataTable>(variant);
-
-    // Set the table name and create the SQL tables.
-    m_tableName = data.tableName;
-    if (m_tableName.isEmpty())
+    // Insert the items of a SaveDataTable into the SQL table.
+    // The table is not queried, updateQuery must be called once all the items are inserted.
+    // The chunk is read in place inside the variant, without copying the items.
+    const Books::SaveDataTable* table = variantValue<Books::SaveDataTable>(variant);
+    if (!m_isTableCreated || !table)
         return false;
-    createTable();
+    const Books::SaveDataTable& data = *table;
+
+    // Too many items are inserted to update the statistics item by item.
+    invalidateStatistics();
 
-    // Set the books list.
     QString statement = QString(
         "INSERT INTO \"%1\" (BooksID, BooksPos, Name, Url, Rate)\n"
         "VALUES")
@@ -756,23 +753,52 @@ bool TableModelBooks::setItemData(const QVariant& variant)
             m_query.clear();
         }
     }
-    // Set the utility interface.
-    if (m_interface)
-    {
-        delete m_interface;
-        m_interface = nullptr;
-    }
-    m_interface = new TableModelBooks_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
-    if (!m_interface->isTableReady())
-    {
-        m_isTableCreated = false;
+
+    return true;
+}
+
+bool TableModelBooks::writeData(QDataStream& out) const
+{
+    // Streaming the table into the data stream, row by row from the SQL cursor.
+    if (!m_isTableCreated || !m_interface->isTableReady())
         return false;
-    }
+    return writeTable(out, m_db, m_tableName, m_interface->tableNames());
+}
 
-    // Then, query the whole table.
-    updateQuery();
+bool TableModelBooks::writeTable(QDataStream& out, QSqlDatabase& db, const QString& tableName, const QStringList& interfaceTableNames)
+{
+    // Streaming the table from the database db, row by row from the SQL cursor.
+    // It only use its arguments, so it can be called from another thread with another connection.
+    out << tableName;
 
-    return true;
+    QString statement = QString(
+        "SELECT\n"
+        "   BooksID,\n"
+        "   BooksPos,\n"
+        "   Name,\n"
+        "   Url,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "ORDER BY\n"
+        "   BooksID ASC;")
+            .arg(tableName);
+
+    bool result = SaveInterface::writeQuery(out, db, statement,
+        [](QDataStream& out, const QSqlQuery& query)
+        {
+            Books::SaveItem item = {};
+            item.bookID = query.value(0).toLongLong();
+            item.bookPos = query.value(1).toLongLong();
+            item.name = query.value(2).toString();
+            item.url = query.value(3).toString();
+            item.rate = query.value(4).toInt();
+            out << item;
+        });
+    if (!result)
+        return false;
+
+    return TableModel_UtilityInterface::writeTables(out, db, interfaceTableNames);
 }
 
 void TableModelBooks::createTable()
@@ -833,6 +859,9 @@ void TableModelBooks::deleteTable()
 
 void TableModelBooks::utilityChanged(long long int bookID, UtilityTableName tableName)
 {
+    if (m_statistics)
+        m_statistics->utilityChanged(bookID, tableName);
+
     // This member function is called when the utility interface if changed.
     if (bookID >= 0 && size() > 0 && m_isTableCreated)
     {
@@ -851,6 +880,69 @@ void TableModelBooks::utilityChanged(long long int bookID, UtilityTableName tabl
     }
 }
 
+void TableModelBooks::setRowsRate(const QList<int>& rows, int rate)
+{
+    // Apply the rate of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].rate = rate;
+    emit dataChanged(index(rows.first(), Books::RATE), index(rows.last(), Books::RATE), {Qt::EditRole});
+}
+
+void TableModelBooks::setRowsUtility(const QList<int>& rows, UtilityTableName tableName, const QHash<long long int, QString>& utilityNames)
+{
+    // Apply the utilities of a bulk edit to the rows, the field and the column of the utility table are selected first.
+    if (rows.isEmpty())
+        return;
+
+    QString BooksItem::* field = nullptr;
+    int column = -1;
+    if (tableName == UtilityTableName::SERIES)
+    {
+        field = &BooksItem::series;
+        column = Books::SERIES;
+    }
+    else if (tableName == UtilityTableName::CATEGORIES)
+    {
+        field = &BooksItem::categories;
+        column = Books::CATEGORIES;
+    }
+    else if (tableName == UtilityTableName::AUTHORS)
+    {
+        field = &BooksItem::authors;
+        column = Books::AUTHORS;
+    }
+    else if (tableName == UtilityTableName::PUBLISHERS)
+    {
+        field = &BooksItem::publishers;
+        column = Books::PUBLISHERS;
+    }
+    else if (tableName == UtilityTableName::SERVICES)
+    {
+        field = &BooksItem::services;
+        column = Books::SERVICES;
+    }
+    else
+        return;
+
+    for (int row : rows)
+        m_data[row].*field = utilityNames.value(m_data.at(row).bookID);
+    emit dataChanged(index(rows.first(), column), index(rows.last(), column), {Qt::EditRole});
+}
+
+void TableModelBooks::setRowsSensitiveContent(const QList<int>& rows, const SensitiveContent& sensitiveContent)
+{
+    // Apply the sensitive content of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].sensitiveContent = sensitiveContent;
+    emit dataChanged(index(rows.first(), Books::SENSITIVE_CONTENT), index(rows.last(), Books::SENSITIVE_CONTENT), {Qt::EditRole});
+}
+
 void TableModelBooks::queryUtilityField(UtilityTableName tableName)
 {
     // Standard interface to query the utility data except the sensitive data.
@@ -1698,6 +1790,8 @@ void TableModelBooks::retrieveInsertedRows(int row, int count)
             book.url = m_query.value(3).toString();
             book.rate = m_query.value(4).toInt();
             booksList.prepend(book);
+            if (m_statistics)
+                m_statistics->itemInserted(book.bookID, book.rate);
         }
         if (m_sortingColumnID >= 0)
             m_data.append(booksList.cbegin(), booksList.cend());
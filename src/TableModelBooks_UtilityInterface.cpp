@@ -242,96 +242,14 @@ ListType TableModelBooks_UtilityInterface::listType() const
     return ListType::BOOKSLIST;
 }
 
-QVariant TableModelBooks_UtilityInterface::data() const
-{
-    // Retrieve the data of the utility interface to be save into a file.
-    if (!m_isTableReady)
-        return QVariant();
-    
-    Books::SaveUtilityInterfaceData data = {};
-
-    QSqlQuery query(m_db);
-    QString statement = QString(
-        "SELECT\n"
-        "   ItemID,\n"
-        "   UtilityID\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   ItemID;");
-    
-    UtilityTableName tablesName[5] =
-    {
-        UtilityTableName::SERIES,
-        UtilityTableName::CATEGORIES,
-        UtilityTableName::AUTHORS,
-        UtilityTableName::PUBLISHERS,
-        UtilityTableName::SERVICES
-    };
-
-    // Utility interface (Categories, Authors, Publishers, Services).
-    for (int i = 0; i < 5; i++)
-    {
-        if (!query.exec(statement.arg(tableName(tablesName[i]))))
-            return QVariant();
-        
-        while (query.next())
-        {
-            Game::SaveUtilityInterfaceItem item = {};
-            item.gameID = query.value(0).toLongLong();
-            item.utilityID = query.value(1).toLongLong();
-            if (tablesName[i] == UtilityTableName::SERIES)
-                data.series.append(item);
-            else if (tablesName[i] == UtilityTableName::CATEGORIES)
-                data.categories.append(item);
-            else if (tablesName[i] == UtilityTableName::AUTHORS)
-                data.authors.append(item);
-            else if (tablesName[i] == UtilityTableName::PUBLISHERS)
-                data.publishers.append(item);
-            else if (tablesName[i] == UtilityTableName::SERVICES)
-                data.services.append(item);
-        }
-        query.clear();
-    }
-
-    // Sensitive content
-	statement = QString(
-		"SELECT\n"
-		"	SensitiveContentID,\n"
-		"	ItemID,\n"
-		"	ExplicitContent,\n"
-		"	ViolenceContent,\n"
-		"	BadLanguage\n"
-		"FROM\n"
-		"	\"%1\"\n"
-		"ORDER BY\n"
-		"	SensitiveContentID;")
-			.arg(tableName(UtilityTableName::SENSITIVE_CONTENT));
-	
-	if (!query.exec(statement))
-		return QVariant();
-	
-	while (query.next())
-	{
-		Game::SaveUtilitySensitiveContentItem item = {};
-		item.SensitiveContentID = query.value(0).toLongLong();
-		item.gameID = query.value(1).toLongLong();
-		item.explicitContent = query.value(2).toInt();
-		item.violenceContent = query.value(3).toInt();
-		item.badLanguageContent = query.value(4).toInt();
-		data.sensitiveContent.append(item);
-	}
-
-    return QVariant::fromValue(data);
-}
-
 bool TableModelBooks_UtilityInterface::setData(const QVariant& variant)
 {
     // Apply the data into the SQL table.
-    if (!variant.isValid())
+    // The data is read in place inside the variant, without copying it.
+    const Books::SaveUtilityInterfaceData* interfaceData = variantValue<Books::SaveUtilityInterfaceData>(variant);
+    if (!interfaceData)
         return false;
-    
-    Books::SaveUtilityInterfaceData data = qvariant_cast<Books::SaveUtilityInterfaceData>(variant);
+    const Books::SaveUtilityInterfaceData& data = *interfaceData;
 
     UtilityTableName tablesName[5] =
     {
@@ -349,7 +267,7 @@ bool TableModelBooks_UtilityInterface::setData(const QVariant& variant)
     
     for (int i = 0; i < 5; i++)
 	{
-		QList<Game::SaveUtilityInterfaceItem>* pItem;
+		const QList<Game::SaveUtilityInterfaceItem>* pItem;
         if (tablesName[i] == UtilityTableName::SERIES)
             pItem = &data.series;
 		else if (tablesName[i] == UtilityTableName::CATEGORIES)
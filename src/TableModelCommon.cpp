@@ -17,8 +17,11 @@
 */
 
 #include "TableModelCommon.h"
+#include "ListStatistics.h"
+#include "SaveInterface.h"
 #include "TableModelCommon_UtilityInterface.h"
 #include <QSqlError>
+#include <QDataStream>
 #include <QApplication>
 #include <QClipboard>
 #include <iostream>
@@ -208,6 +211,8 @@ bool TableModelCommon::setData(const QModelIndex& index, const QVariant& data, i
                 bool result = updateField<int>("Rate", index.row(), rate);
                 if (result)
                 {
+                    if (m_statistics)
+                        m_statistics->rateChanged(itemID(index), rate);
                     emit dataChanged(index, index, {Qt::EditRole});
                     emit listEdited();
                 }
@@ -328,6 +333,8 @@ bool TableModelCommon::removeRows(int row, int count, const QModelIndex& parent)
             
             m_data.remove(row, count);
             m_interface->rowRemoved(itemsID);
+            if (m_statistics)
+                m_statistics->itemsRemoved(itemsID);
 
             endRemoveRows();
 
@@ -640,66 +647,56 @@ void TableModelCommon::updateQuery()
 #endif
 }
 
-QVariant TableModelCommon::retrieveData() const
+bool TableModelCommon::setItemData(const QVariant& variant)
 {
-    // Return the data of the table and the utility interface data.
-    Common::SaveDataTable data = {};
-    data.tableName = m_tableName;
+    // Set the data into the TableModel SQL Tables.
+    const Common::SaveDataTable* table = variantValue<Common::SaveDataTable>(variant);
+    if (!table)
+        return false;
+    const Common::SaveDataTable& data = *table;
 
-    // Retrieve common data.
-    QSqlQuery query(m_db);
+    // Set the table name and create the SQL tables.
+    m_tableName = data.tableName;
+    if (m_tableName.isEmpty())
+        return false;
+    createTable();
 
-    QString statement = QString(
-        "SELECT\n"
-        "   CommonID,\n"
-        "   CommonPos,\n"
-        "   Name,\n"
-        "   Url,\n"
-        "   Rate\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   CommonID ASC;")
-            .arg(m_tableName);
-    
-    if (!query.exec(statement))
-        return QVariant();
-    
-    while (query.next())
+    // Set the common list.
+    if (!appendItemData(variant))
+        return false;
+
+    // Set the utility interface.
+    if (m_interface)
+    {
+        delete m_interface;
+        m_interface = nullptr;
+    }
+    m_interface = new TableModelCommon_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
+    if (!m_interface->isTableReady())
     {
-        Common::SaveItem common = {};
-        common.commonID = query.value(0).toLongLong();
-        common.commonPos = query.value(1).toLongLong();
-        common.name = query.value(2).toString();
-        common.url = query.value(3).toString();
-        common.rate = query.value(4).toInt();
-        data.commonList.append(common);
+        m_isTableCreated = false;
+        return false;
     }
 
-    QVariant utilityInterface = m_interface->data();
-    if (!utilityInterface.canConvert<Common::SaveUtilityInterfaceData>())
-        return QVariant();
-    
-    data.interface = qvariant_cast<Common::SaveUtilityInterfaceData>(utilityInterface);
-
-    data.columnSort = (signed char)m_sortingColumnID;
-    data.sortOrder = (unsigned char)(m_sortingOrder == Qt::AscendingOrder ? 0 : 1);
+    // Then, query the whole table.
+    updateQuery();
 
-    return QVariant::fromValue(data);
+    return true;
 }
 
-bool TableModelCommon::setItemData(const QVariant& variant)
+bool TableModelCommon::appendItemData(const QVariant& variant)
 {
-    // Set the data into the TableModel SQL Tables.
-    Common::SaveDataTable data = qvariant_cast<Common::SaveDataTable>(variant);
-
-    // Set the table name and create the SQL tables.
-    m_tableName = data.tableName;
-    if (m_tableName.isEmpty())
+    // Insert the items of a SaveDataTable into the SQL table.
+    // The table is not queried, updateQuery must be called once all the items are inserted.
+    // The chunk is read in place inside the variant, without copying the items.
+    const Common::SaveDataTable* table = variantValue<Common::SaveDataTable>(variant);
+    if (!m_isTableCreated || !table)
         return false;
-    createTable();
+    const Common::SaveDataTable& data = *table;
+
+    // Too many items are inserted to update the statistics item by item.
+    invalidateStatistics();
 
-    // Set the common list.
     QString statement = QString(
         "INSERT INTO \"%1\" (CommonID, CommonPos, Name, Url, Rate)\n"
         "VALUES")
@@ -741,23 +738,52 @@ bool TableModelCommon::setItemData(const QVariant& variant)
             m_query.clear();
         }
     }
-    // Set the utility interface.
-    if (m_interface)
-    {
-        delete m_interface;
-        m_interface = nullptr;
-    }
-    m_interface = new TableModelCommon_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
-    if (!m_interface->isTableReady())
-    {
-        m_isTableCreated = false;
+
+    return true;
+}
+
+bool TableModelCommon::writeData(QDataStream& out) const
+{
+    // Streaming the table into the data stream, row by row from the SQL cursor.
+    if (!m_isTableCreated || !m_interface->isTableReady())
         return false;
-    }
+    return writeTable(out, m_db, m_tableName, m_interface->tableNames());
+}
 
-    // Then, query the whole table.
-    updateQuery();
+bool TableModelCommon::writeTable(QDataStream& out, QSqlDatabase& db, const QString& tableName, const QStringList& interfaceTableNames)
+{
+    // Streaming the table from the database db, row by row from the SQL cursor.
+    // It only use its arguments, so it can be called from another thread with another connection.
+    out << tableName;
 
-    return true;
+    QString statement = QString(
+        "SELECT\n"
+        "   CommonID,\n"
+        "   CommonPos,\n"
+        "   Name,\n"
+        "   Url,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "ORDER BY\n"
+        "   CommonID ASC;")
+            .arg(tableName);
+
+    bool result = SaveInterface::writeQuery(out, db, statement,
+        [](QDataStream& out, const QSqlQuery& query)
+        {
+            Common::SaveItem item = {};
+            item.commonID = query.value(0).toLongLong();
+            item.commonPos = query.value(1).toLongLong();
+            item.name = query.value(2).toString();
+            item.url = query.value(3).toString();
+            item.rate = query.value(4).toInt();
+            out << item;
+        });
+    if (!result)
+        return false;
+
+    return TableModel_UtilityInterface::writeTables(out, db, interfaceTableNames);
 }
 
 void TableModelCommon::createTable()
@@ -818,6 +844,9 @@ void TableModelCommon::deleteTable()
 
 void TableModelCommon::utilityChanged(long long int commonID, UtilityTableName tableName)
 {
+    if (m_statistics)
+        m_statistics->utilityChanged(commonID, tableName);
+
     // This member function is called when the utility interface if changed.
     if (commonID >= 0 && size() > 0 && m_isTableCreated)
     {
@@ -832,6 +861,59 @@ void TableModelCommon::utilityChanged(long long int commonID, UtilityTableName t
     }
 }
 
+void TableModelCommon::setRowsRate(const QList<int>& rows, int rate)
+{
+    // Apply the rate of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].rate = rate;
+    emit dataChanged(index(rows.first(), Common::RATE), index(rows.last(), Common::RATE), {Qt::EditRole});
+}
+
+void TableModelCommon::setRowsUtility(const QList<int>& rows, UtilityTableName tableName, const QHash<long long int, QString>& utilityNames)
+{
+    // Apply the utilities of a bulk edit to the rows, the field and the column of the utility table are selected first.
+    if (rows.isEmpty())
+        return;
+
+    QString CommonItem::* field = nullptr;
+    int column = -1;
+    if (tableName == UtilityTableName::SERIES)
+    {
+        field = &CommonItem::series;
+        column = Common::SERIES;
+    }
+    else if (tableName == UtilityTableName::CATEGORIES)
+    {
+        field = &CommonItem::categories;
+        column = Common::CATEGORIES;
+    }
+    else if (tableName == UtilityTableName::AUTHORS)
+    {
+        field = &CommonItem::authors;
+        column = Common::AUTHORS;
+    }
+    else
+        return;
+
+    for (int row : rows)
+        m_data[row].*field = utilityNames.value(m_data.at(row).commonID);
+    emit dataChanged(index(rows.first(), column), index(rows.last(), column), {Qt::EditRole});
+}
+
+void TableModelCommon::setRowsSensitiveContent(const QList<int>& rows, const SensitiveContent& sensitiveContent)
+{
+    // Apply the sensitive content of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].sensitiveContent = sensitiveContent;
+    emit dataChanged(index(rows.first(), Common::SENSITIVE_CONTENT), index(rows.last(), Common::SENSITIVE_CONTENT), {Qt::EditRole});
+}
+
 void TableModelCommon::queryUtilityField(UtilityTableName tableName)
 {
     // Standard interface to query the utility data except the sensitive data.
@@ -1634,6 +1716,8 @@ void TableModelCommon::retrieveInsertedRows(int row, int count)
             common.url = m_query.value(3).toString();
             common.rate = m_query.value(4).toInt();
             commonList.prepend(common);
+            if (m_statistics)
+                m_statistics->itemInserted(common.commonID, common.rate);
         }
         if (m_sortingColumnID >= 0)
             m_data.append(commonList.cbegin(), commonList.cend());
@@ -230,90 +230,14 @@ ListType TableModelCommon_UtilityInterface::listType() const
     return ListType::COMMONLIST;
 }
 
-QVariant TableModelCommon_UtilityInterface::data() const
-{
-    // Retrieve the data of the utility interface to be save into a file.
-	if (!m_isTableReady)
-		return QVariant();
-
-	Common::SaveUtilityInterfaceData data = {};
-
-	QSqlQuery query(m_db);
-	QString statement = QString(
-		"SELECT\n"
-		"	ItemID,\n"
-		"	UtilityID\n"
-		"FROM\n"
-		"	\"%1\"\n"
-		"ORDER BY\n"
-		"	ItemID;");
-	
-	UtilityTableName tablesName[3] =
-	{
-		UtilityTableName::SERIES,
-		UtilityTableName::CATEGORIES,
-		UtilityTableName::AUTHORS
-	};
-
-	// Utility interface (Categories, Authors).
-	for (int i = 0; i < 3; i++)
-	{
-		if (!query.exec(statement.arg(tableName(tablesName[i]))))
-			return QVariant();
-		
-		while (query.next())
-		{
-			Game::SaveUtilityInterfaceItem item = {};
-			item.gameID = query.value(0).toLongLong();
-			item.utilityID = query.value(1).toLongLong();
-			if (tablesName[i] == UtilityTableName::SERIES)
-				data.series.append(item);
-			if (tablesName[i] == UtilityTableName::CATEGORIES)
-				data.categories.append(item);
-			else if (tablesName[i] == UtilityTableName::AUTHORS)
-				data.authors.append(item);
-		}
-		query.clear();
-	}
-
-	// Sensitive content
-	statement = QString(
-		"SELECT\n"
-		"	SensitiveContentID,\n"
-		"	ItemID,\n"
-		"	ExplicitContent,\n"
-		"	ViolenceContent,\n"
-		"	BadLanguage\n"
-		"FROM\n"
-		"	\"%1\"\n"
-		"ORDER BY\n"
-		"	SensitiveContentID;")
-			.arg(tableName(UtilityTableName::SENSITIVE_CONTENT));
-	
-	if (!query.exec(statement))
-		return QVariant();
-	
-	while (query.next())
-	{
-		Game::SaveUtilitySensitiveContentItem item = {};
-		item.SensitiveContentID = query.value(0).toLongLong();
-		item.gameID = query.value(1).toLongLong();
-		item.explicitContent = query.value(2).toInt();
-		item.violenceContent = query.value(3).toInt();
-		item.badLanguageContent = query.value(4).toInt();
-		data.sensitiveContent.append(item);
-	}
-
-	return QVariant::fromValue(data);
-}
-
 bool TableModelCommon_UtilityInterface::setData(const QVariant& variant)
 {
 	// Apply the data into the SQL table.
-	if (!variant.isValid())
+	// The data is read in place inside the variant, without copying it.
+	const Common::SaveUtilityInterfaceData* interfaceData = variantValue<Common::SaveUtilityInterfaceData>(variant);
+	if (!interfaceData)
 		return false;
-	
-	Common::SaveUtilityInterfaceData data = qvariant_cast<Common::SaveUtilityInterfaceData>(variant);
+	const Common::SaveUtilityInterfaceData& data = *interfaceData;
 
 	UtilityTableName tablesName[3] = 
 	{
@@ -329,7 +253,7 @@ bool TableModelCommon_UtilityInterface::setData(const QVariant& variant)
 
 	for (int i = 0; i < 3; i++)
 	{
-		QList<Game::SaveUtilityInterfaceItem>* pItem;
+		const QList<Game::SaveUtilityInterfaceItem>* pItem;
 		if (tablesName[i] == UtilityTableName::SERIES)
 			pItem = &data.series;
 		else if (tablesName[i] == UtilityTableName::CATEGORIES)
@@ -17,8 +17,11 @@
 */
 
 #include "TableModelGame.h"
+#include "ListStatistics.h"
+#include "SaveInterface.h"
 #include "TableModelGame_UtilityInterface.h"
 #include <QSqlError>
+#include <QDataStream>
 #include <QClipboard>
 #include <QApplication>
 #include <iostream>
@@ -214,6 +217,8 @@ bool TableModelGame::setData(const QModelIndex& index, const QVariant& data, int
                 bool result = updateField<int>("Rate", index.row(), rate);
                 if (result)
                 {
+                    if (m_statistics)
+                        m_statistics->rateChanged(itemID(index), rate);
                     emit dataChanged(index, index, {Qt::EditRole});
                     emit listEdited();
                 }
@@ -334,6 +339,8 @@ bool TableModelGame::removeRows(int row, int count, const QModelIndex& parent)
             
             m_data.remove(row, count);
             m_interface->rowRemoved(itemsID);
+            if (m_statistics)
+                m_statistics->itemsRemoved(itemsID);
 
             endRemoveRows();
 
@@ -664,66 +671,56 @@ void TableModelGame::updateQuery()
 #endif
 }
 
-QVariant TableModelGame::retrieveData() const
+bool TableModelGame::setItemData(const QVariant& variant)
 {
-    // Return the data of the table and the utility interface data.
-    Game::SaveDataTable data = {};
-    data.tableName = m_tableName;
+    // Set the data into the TableModel SQL Tables.
+    const Game::SaveDataTable* table = variantValue<Game::SaveDataTable>(variant);
+    if (!table)
+        return false;
+    const Game::SaveDataTable& data = *table;
 
-    // Retrieve game data.
-    QSqlQuery query(m_db);
+    // Set the table name and create the SQL tables.
+    m_tableName = data.tableName;
+    if (m_tableName.isEmpty())
+        return false;
+    createTable();
 
-    QString statement = QString(
-        "SELECT\n"
-        "   GameID,\n"
-        "   GamePos,\n"
-        "   Name,\n"
-        "   Url,\n"
-        "   Rate\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   GameID ASC;")
-            .arg(m_tableName);
-    
-    if (!query.exec(statement))
-        return QVariant();
-    
-    while (query.next())
+    // Set the game list.
+    if (!appendItemData(variant))
+        return false;
+
+    // Set the utility interface.
+    if (m_interface)
+    {
+        delete m_interface;
+        m_interface = nullptr;
+    }
+    m_interface = new TableModelGame_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
+    if (!m_interface->isTableReady())
     {
-        Game::SaveItem game = {};
-        game.gameID = query.value(0).toLongLong();
-        game.gamePos = query.value(1).toLongLong();
-        game.name = query.value(2).toString();
-        game.url = query.value(3).toString();
-        game.rate = query.value(4).toInt();
-        data.gameList.append(game);
+        m_isTableCreated = false;
+        return false;
     }
 
-    QVariant utilityInterface = m_interface->data();
-    if (!utilityInterface.canConvert<Game::SaveUtilityInterfaceData>())
-        return QVariant();
-    
-    data.interface = qvariant_cast<Game::SaveUtilityInterfaceData>(utilityInterface);
-
-    data.columnSort = (signed char)m_sortingColumnID;
-    data.sortOrder = (unsigned char)(m_sortingOrder == Qt::AscendingOrder ? 0 : 1);
+    // Then, query the whole table.
+    updateQuery();
 
-    return QVariant::fromValue(data);
+    return true;
 }
 
-bool TableModelGame::setItemData(const QVariant& variant)
+bool TableModelGame::appendItemData(const QVariant& variant)
 {
-    // Set the data into the TableModel SQL Tables.
-    Game::SaveDataTable data = qvariant_cast<Game::SaveDataTable>(variant);
-
-    // Set the table name and create the SQL tables.
-    m_tableName = data.tableName;
-    if (m_tableName.isEmpty())
+    // Insert the items of a SaveDataTable into the SQL table.
+    // The table is not queried, updateQuery must be called once all the items are inserted.
+    // The chunk is read in place inside the variant, without copying the items.
+    const Game::SaveDataTable* table = variantValue<Game::SaveDataTable>(variant);
+    if (!m_isTableCreated || !table)
         return false;
-    createTable();
+    const Game::SaveDataTable& data = *table;
+
+    // Too many items are inserted to update the statistics item by item.
+    invalidateStatistics();
 
-    // Set the game list.
     QString statement = QString(
         "INSERT INTO \"%1\" (GameID, GamePos, Name, Url, Rate)\n"
         "VALUES")
@@ -765,23 +762,52 @@ bool TableModelGame::setItemData(const QVariant& variant)
             m_query.clear();
         }
     }
-    // Set the utility interface.
-    if (m_interface)
-    {
-        delete m_interface;
-        m_interface = nullptr;
-    }
-    m_interface = new TableModelGame_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
-    if (!m_interface->isTableReady())
-    {
-        m_isTableCreated = false;
+
+    return true;
+}
+
+bool TableModelGame::writeData(QDataStream& out) const
+{
+    // Streaming the table into the data stream, row by row from the SQL cursor.
+    if (!m_isTableCreated || !m_interface->isTableReady())
         return false;
-    }
+    return writeTable(out, m_db, m_tableName, m_interface->tableNames());
+}
 
-    // Then, query the whole table.
-    updateQuery();
+bool TableModelGame::writeTable(QDataStream& out, QSqlDatabase& db, const QString& tableName, const QStringList& interfaceTableNames)
+{
+    // Streaming the table from the database db, row by row from the SQL cursor.
+    // It only use its arguments, so it can be called from another thread with another connection.
+    out << tableName;
 
-    return true;
+    QString statement = QString(
+        "SELECT\n"
+        "   GameID,\n"
+        "   GamePos,\n"
+        "   Name,\n"
+        "   Url,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "ORDER BY\n"
+        "   GameID ASC;")
+            .arg(tableName);
+
+    bool result = SaveInterface::writeQuery(out, db, statement,
+        [](QDataStream& out, const QSqlQuery& query)
+        {
+            Game::SaveItem item = {};
+            item.gameID = query.value(0).toLongLong();
+            item.gamePos = query.value(1).toLongLong();
+            item.name = query.value(2).toString();
+            item.url = query.value(3).toString();
+            item.rate = query.value(4).toInt();
+            out << item;
+        });
+    if (!result)
+        return false;
+
+    return TableModel_UtilityInterface::writeTables(out, db, interfaceTableNames);
 }
 
 void TableModelGame::createTable()
@@ -843,6 +869,9 @@ void TableModelGame::deleteTable()
 
 void TableModelGame::utilityChanged(long long int gameID, UtilityTableName tableName)
 {
+    if (m_statistics)
+        m_statistics->utilityChanged(gameID, tableName);
+
     // This member function is called when the utility interface if changed.
     if (gameID >= 0 && size() > 0 && m_isTableCreated)
     {
@@ -863,6 +892,74 @@ void TableModelGame::utilityChanged(long long int gameID, UtilityTableName table
     }
 }
 
+void TableModelGame::setRowsRate(const QList<int>& rows, int rate)
+{
+    // Apply the rate of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].rate = rate;
+    emit dataChanged(index(rows.first(), Game::RATE), index(rows.last(), Game::RATE), {Qt::EditRole});
+}
+
+void TableModelGame::setRowsUtility(const QList<int>& rows, UtilityTableName tableName, const QHash<long long int, QString>& utilityNames)
+{
+    // Apply the utilities of a bulk edit to the rows, the field and the column of the utility table are selected first.
+    if (rows.isEmpty())
+        return;
+
+    QString GameItem::* field = nullptr;
+    int column = -1;
+    if (tableName == UtilityTableName::SERIES)
+    {
+        field = &GameItem::series;
+        column = Game::SERIES;
+    }
+    else if (tableName == UtilityTableName::CATEGORIES)
+    {
+        field = &GameItem::categories;
+        column = Game::CATEGORIES;
+    }
+    else if (tableName == UtilityTableName::DEVELOPPERS)
+    {
+        field = &GameItem::developpers;
+        column = Game::DEVELOPPERS;
+    }
+    else if (tableName == UtilityTableName::PUBLISHERS)
+    {
+        field = &GameItem::publishers;
+        column = Game::PUBLISHERS;
+    }
+    else if (tableName == UtilityTableName::PLATFORM)
+    {
+        field = &GameItem::platform;
+        column = Game::PLATFORMS;
+    }
+    else if (tableName == UtilityTableName::SERVICES)
+    {
+        field = &GameItem::services;
+        column = Game::SERVICES;
+    }
+    else
+        return;
+
+    for (int row : rows)
+        m_data[row].*field = utilityNames.value(m_data.at(row).gameID);
+    emit dataChanged(index(rows.first(), column), index(rows.last(), column), {Qt::EditRole});
+}
+
+void TableModelGame::setRowsSensitiveContent(const QList<int>& rows, const SensitiveContent& sensitiveContent)
+{
+    // Apply the sensitive content of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].sensitiveContent = sensitiveContent;
+    emit dataChanged(index(rows.first(), Game::SENSITIVE_CONTENT), index(rows.last(), Game::SENSITIVE_CONTENT), {Qt::EditRole});
+}
+
 void TableModelGame::queryUtilityField(UtilityTableName tableName)
 {
     // Standard interface to query the utility data except the sensitive data.
@@ -1739,6 +1836,8 @@ void TableModelGame::retrieveInsertedRows(int row, int count)
             game.url = m_query.value(3).toString();
             game.rate = m_query.value(4).toInt();
             gameList.prepend(game);
+            if (m_statistics)
+                m_statistics->itemInserted(game.gameID, game.rate);
         }
         if (m_sortingColumnID >= 0)
             m_data.append(gameList.cbegin(), gameList.cend());
@@ -250,99 +250,14 @@ ListType TableModelGame_UtilityInterface::listType() const
 	return ListType::GAMELIST;
 }
 
-QVariant TableModelGame_UtilityInterface::data() const
-{
-	// Retrieve the data of the utility interface to be save into a file.
-	if (!m_isTableReady)
-		return QVariant();
-
-	Game::SaveUtilityInterfaceData data = {};
-
-	QSqlQuery query(m_db);
-	QString statement = QString(
-		"SELECT\n"
-		"	ItemID,\n"
-		"	UtilityID\n"
-		"FROM\n"
-		"	\"%1\"\n"
-		"ORDER BY\n"
-		"	ItemID;");
-	
-	UtilityTableName tablesName[6] =
-	{
-		UtilityTableName::SERIES,
-		UtilityTableName::CATEGORIES,
-		UtilityTableName::DEVELOPPERS,
-		UtilityTableName::PUBLISHERS,
-		UtilityTableName::PLATFORM,
-		UtilityTableName::SERVICES
-	};
-
-	// Utility interface (Categories, Developpers, Publishers, Platform and Services).
-	for (int i = 0; i < 6; i++)
-	{
-		if (!query.exec(statement.arg(tableName(tablesName[i]))))
-			return QVariant();
-		
-		while (query.next())
-		{
-			Game::SaveUtilityInterfaceItem item = {};
-			item.gameID = query.value(0).toLongLong();
-			item.utilityID = query.value(1).toLongLong();
-			if (tablesName[i] == UtilityTableName::SERIES)
-				data.series.append(item);
-			if (tablesName[i] == UtilityTableName::CATEGORIES)
-				data.categories.append(item);
-			else if (tablesName[i] == UtilityTableName::DEVELOPPERS)
-				data.developpers.append(item);
-			else if (tablesName[i] == UtilityTableName::PUBLISHERS)
-				data.pubishers.append(item);
-			else if (tablesName[i] == UtilityTableName::PLATFORM)
-				data.platform.append(item);
-			else if (tablesName[i] == UtilityTableName::SERVICES)
-				data.services.append(item);
-		}
-		query.clear();
-	}
-
-	// Sensitive content
-	statement = QString(
-		"SELECT\n"
-		"	SensitiveContentID,\n"
-		"	ItemID,\n"
-		"	ExplicitContent,\n"
-		"	ViolenceContent,\n"
-		"	BadLanguage\n"
-		"FROM\n"
-		"	\"%1\"\n"
-		"ORDER BY\n"
-		"	SensitiveContentID;")
-			.arg(tableName(UtilityTableName::SENSITIVE_CONTENT));
-	
-	if (!query.exec(statement))
-		return QVariant();
-	
-	while (query.next())
-	{
-		Game::SaveUtilitySensitiveContentItem item = {};
-		item.SensitiveContentID = query.value(0).toLongLong();
-		item.gameID = query.value(1).toLongLong();
-		item.explicitContent = query.value(2).toInt();
-		item.violenceContent = query.value(3).toInt();
-		item.badLanguageContent = query.value(4).toInt();
-		data.sensitiveContent.append(item);
-	}
-
-	return QVariant::fromValue(data);
-}
-
 bool TableModelGame_UtilityInterface::setData(const QVariant& variant)
 {
 	// Apply the data into the SQL table.
-	if (!variant.isValid())
+	// The data is read in place inside the variant, without copying it.
+	const Game::SaveUtilityInterfaceData* interfaceData = variantValue<Game::SaveUtilityInterfaceData>(variant);
+	if (!interfaceData)
 		return false;
-	
-	Game::SaveUtilityInterfaceData data = qvariant_cast<Game::SaveUtilityInterfaceData>(variant);
+	const Game::SaveUtilityInterfaceData& data = *interfaceData;
 
 	UtilityTableName tablesName[6] = 
 	{
@@ -361,7 +276,7 @@ bool TableModelGame_UtilityInterface::setData(const QVariant& variant)
 
 	for (int i = 0; i < 6; i++)
 	{
-		QList<Game::SaveUtilityInterfaceItem>* pItem;
+		const QList<Game::SaveUtilityInterfaceItem>* pItem;
 		if (tablesName[i] == UtilityTableName::SERIES)
 			pItem = &data.series;
 		if (tablesName[i] == UtilityTableName::CATEGORIES)
@@ -17,8 +17,11 @@
 */
 
 #include "TableModelMovies.h"
+#include "ListStatistics.h"
+#include "SaveInterface.h"
 #include "TableModelMovies_UtilityInterface.h"
 #include <QSqlError>
+#include <QDataStream>
 #include <QApplication>
 #include <QClipboard>
 #include <iostream>
@@ -209,6 +212,8 @@ bool TableModelMovies::setData(const QModelIndex& index, const QVariant& data, i
                 bool result = updateField<int>("Rate", index.row(), rate);
                 if (result)
                 {
+                    if (m_statistics)
+                        m_statistics->rateChanged(itemID(index), rate);
                     emit dataChanged(index, index, {Qt::EditRole});
                     emit listEdited();
                 }
@@ -330,6 +335,8 @@ bool TableModelMovies::removeRows(int row, int count, const QModelIndex& parent)
             
             m_data.remove(row, count);
             m_interface->rowRemoved(itemsID);
+            if (m_statistics)
+                m_statistics->itemsRemoved(itemsID);
             endRemoveRows();
 
             emit listEdited();
@@ -655,81 +662,52 @@ void TableModelMovies::updateQuery()
             << m_query.lastError().text().toLocal8Bit().constData() << std::endl;
 }
 
-QVariant TableModelMovies::retrieveData() const
+bool TableModelMovies::setItemData(const QVariant& variant)
 {
-    // Return the data of the table and the utility interface data.
-    Movie::SaveDataTable data = {};
-    data.tableName = m_tableName;
-
-    // Retrieve movie data
-    QSqlQuery query(m_db);
-
-    QString statement = QString(
-        "SELECT\n"
-        "   MovieID,\n"
-        "   MoviePos,\n"
-        "   Name,\n"
-        "   Url,\n"
-        "   Rate\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   MovieID ASC;")
-            .arg(m_tableName);
+    // Set the data into the TableModel SQL Tables.
+    const Movie::SaveDataTable* table = variantValue<Movie::SaveDataTable>(variant);
+    if (!table)
+        return false;
+    const Movie::SaveDataTable& data = *table;
 
-#ifndef NDEBUG
-    std::cout << statement.toLocal8Bit().constData() << std::endl << std::endl;
-#endif
-    
-    if (!query.exec(statement))
-    {
-        std::cerr << QString("Failed to query table %1\n\t%2")
-            .arg(m_tableName, query.lastError().text())
-            .toLocal8Bit().constData()
-            << std::endl;
-        return QVariant();
-    }
+    m_tableName = data.tableName;
+    if (m_tableName.isEmpty())
+        return false;
+    createTable();
 
-    while (query.next())
-    {
-        Movie::SaveItem movie = {};
-        movie.movieID = query.value(0).toLongLong();
-        movie.moviePos = query.value(1).toLongLong();
-        movie.name = query.value(2).toString();
-        movie.url = query.value(3).toString();
-        movie.rate = query.value(4).toInt();
-        data.movieList.append(movie);
-    }
+    // Set the game list
+    if (!appendItemData(variant))
+        return false;
 
-    QVariant utilityInterface = m_interface->data();
-    if (!utilityInterface.canConvert<Movie::SaveUtilityInterfaceData>())
+    // Set the utility interface.
+    if (m_interface)
     {
-        std::cerr << "Cannot convert utility QVariant to Movie::SaveUtilityInterfaceData." << std::endl;
-        return QVariant();
+        delete m_interface;
+        m_interface = nullptr;
     }
+    m_interface = new TableModelMovies_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
+    if (!m_interface->isTableReady())
+        return false;
 
-    data.interface = qvariant_cast<Movie::SaveUtilityInterfaceData>(utilityInterface);
-
-    data.columnSort = (signed char)m_sortingColumnID;
-    data.sortOrder = (signed char)(m_sortingOrder == Qt::AscendingOrder ? 0 : 1);
+    // Then, query the whole table.
+    updateQuery();
 
-    return QVariant::fromValue(data);
+    return true;
 }
 
-bool TableModelMovies::setItemData(const QVariant& variant)
+bool TableModelMovies::appendItemData(const QVariant& variant)
 {
-    // Set the data into the TableModel SQL Tables.
-    if (!variant.isValid() || !variant.canConvert<Movie::SaveDataTable>())
+    // Insert the items of a SaveDataTable into the SQL table.
+    // The table is not queried, updateQuery must be called once all the items are inserted.
+    // The chunk is read in place inside the variant, without copying the items.
+    const Movie::SaveDataTable* table = variantValue<Movie::SaveDataTable>(variant);
+    if (!m_isTableCreated || !table)
         return false;
-    
-    Movie::SaveDataTable data = qvariant_cast<Movie::SaveDataTable>(variant);
+    const Movie::SaveDataTable& data = *table;
+
+    // Too many items are inserted to update the statistics item by item.
+    invalidateStatistics();
 
-    m_tableName = data.tableName;
-    if (m_tableName.isEmpty())
-        return false;
-    createTable();
-    
-    // Set the game list
     QString statement = QString(
         "INSERT INTO \"%1\" (MovieID, MoviePos, Name, Url, Rate)\n"
         "VALUES")
@@ -771,20 +749,52 @@ bool TableModelMovies::setItemData(const QVariant& variant)
             m_query.clear();
         }
     }
-    // Set the utility interface.
-    if (m_interface)
-    {
-        delete m_interface;
-        m_interface = nullptr;
-    }
-    m_interface = new TableModelMovies_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
-    if (!m_interface->isTableReady())
+
+    return true;
+}
+
+bool TableModelMovies::writeData(QDataStream& out) const
+{
+    // Streaming the table into the data stream, row by row from the SQL cursor.
+    if (!m_isTableCreated || !m_interface->isTableReady())
         return false;
+    return writeTable(out, m_db, m_tableName, m_interface->tableNames());
+}
 
-    // Then, query the whole table.
-    updateQuery();
+bool TableModelMovies::writeTable(QDataStream& out, QSqlDatabase& db, const QString& tableName, const QStringList& interfaceTableNames)
+{
+    // Streaming the table from the database db, row by row from the SQL cursor.
+    // It only use its arguments, so it can be called from another thread with another connection.
+    out << tableName;
 
-    return true;
+    QString statement = QString(
+        "SELECT\n"
+        "   MovieID,\n"
+        "   MoviePos,\n"
+        "   Name,\n"
+        "   Url,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "ORDER BY\n"
+        "   MovieID ASC;")
+            .arg(tableName);
+
+    bool result = SaveInterface::writeQuery(out, db, statement,
+        [](QDataStream& out, const QSqlQuery& query)
+        {
+            Movie::SaveItem item = {};
+            item.movieID = query.value(0).toLongLong();
+            item.moviePos = query.value(1).toLongLong();
+            item.name = query.value(2).toString();
+            item.url = query.value(3).toString();
+            item.rate = query.value(4).toInt();
+            out << item;
+        });
+    if (!result)
+        return false;
+
+    return TableModel_UtilityInterface::writeTables(out, db, interfaceTableNames);
 }
 
 void TableModelMovies::createTable()
@@ -843,6 +853,9 @@ void TableModelMovies::deleteTable()
 
 void TableModelMovies::utilityChanged(long long int movieID, UtilityTableName tableName)
 {
+    if (m_statistics)
+        m_statistics->utilityChanged(movieID, tableName);
+
     // This member function is called when the utility interface is changed.
     if (movieID >= 0 && size() > 0 && m_isTableCreated)
     {
@@ -865,6 +878,79 @@ void TableModelMovies::utilityChanged(long long int movieID, UtilityTableName ta
     }
 }
 
+void TableModelMovies::setRowsRate(const QList<int>& rows, int rate)
+{
+    // Apply the rate of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].rate = rate;
+    emit dataChanged(index(rows.first(), Movie::RATE), index(rows.last(), Movie::RATE), {Qt::EditRole});
+}
+
+void TableModelMovies::setRowsUtility(const QList<int>& rows, UtilityTableName tableName, const QHash<long long int, QString>& utilityNames)
+{
+    // Apply the utilities of a bulk edit to the rows, the field and the column of the utility table are selected first.
+    if (rows.isEmpty())
+        return;
+
+    QString MovieItem::* field = nullptr;
+    int column = -1;
+    if (tableName == UtilityTableName::SERIES)
+    {
+        field = &MovieItem::series;
+        column = Movie::SERIES;
+    }
+    else if (tableName == UtilityTableName::CATEGORIES)
+    {
+        field = &MovieItem::categories;
+        column = Movie::CATEGORIES;
+    }
+    else if (tableName == UtilityTableName::DIRECTOR)
+    {
+        field = &MovieItem::directors;
+        column = Movie::DIRECTORS;
+    }
+    else if (tableName == UtilityTableName::ACTORS)
+    {
+        field = &MovieItem::actors;
+        column = Movie::ACTORS;
+    }
+    else if (tableName == UtilityTableName::PRODUCTION)
+    {
+        field = &MovieItem::productions;
+        column = Movie::PRODUCTIONS;
+    }
+    else if (tableName == UtilityTableName::MUSIC)
+    {
+        field = &MovieItem::music;
+        column = Movie::MUSIC;
+    }
+    else if (tableName == UtilityTableName::SERVICES)
+    {
+        field = &MovieItem::services;
+        column = Movie::SERVICES;
+    }
+    else
+        return;
+
+    for (int row : rows)
+        m_data[row].*field = utilityNames.value(m_data.at(row).movieID);
+    emit dataChanged(index(rows.first(), column), index(rows.last(), column), {Qt::EditRole});
+}
+
+void TableModelMovies::setRowsSensitiveContent(const QList<int>& rows, const SensitiveContent& sensitiveContent)
+{
+    // Apply the sensitive content of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].sensitiveContent = sensitiveContent;
+    emit dataChanged(index(rows.first(), Movie::SENSITIVE_CONTENT), index(rows.last(), Movie::SENSITIVE_CONTENT), {Qt::EditRole});
+}
+
 void TableModelMovies::queryUtilityField(UtilityTableName tableName)
 {
     // Standard interface to query the utility data except the sensitive data.
@@ -1747,6 +1833,8 @@ void TableModelMovies::retrieveInsertedRows(int row, int count)
             movie.url = m_query.value(3).toString();
             movie.rate = m_query.value(4).toInt();
             movieList.prepend(movie);
+            if (m_statistics)
+                m_statistics->itemInserted(movie.movieID, movie.rate);
         }
         if (m_sortingColumnID >= 0)
             m_data.append(movieList.cbegin(), movieList.cend());
@@ -254,122 +254,14 @@ ListType TableModelMovies_UtilityInterface::listType() const
     return ListType::MOVIESLIST;
 }
 
-QVariant TableModelMovies_UtilityInterface::data() const
-{
-    // Retrieve the data of the utility interface to be save into a file.
-    if (!m_isTableReady)
-        return QVariant();
-    
-    Movie::SaveUtilityInterfaceData data = {};
-
-    QSqlQuery query(m_db);
-    QString statement = QString(
-        "SELECT\n"
-        "   ItemID,\n"
-        "   UtilityID\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   ItemID;");
-    
-    UtilityTableName tablesName[7] =
-    {
-        UtilityTableName::SERIES,
-        UtilityTableName::CATEGORIES,
-        UtilityTableName::DIRECTOR,
-        UtilityTableName::ACTORS,
-        UtilityTableName::PRODUCTION,
-        UtilityTableName::MUSIC,
-        UtilityTableName::SERVICES
-    };
-
-    // Utility interface (Categories, Director, Actors, Production, Music, Services).
-    for (int i = 0; i < 7; i++)
-    {
-#ifndef NDEBUG
-        std::cout << statement.arg(tableName(tablesName[i])).toLocal8Bit().constData() << std::endl << std::endl;
-#endif
-
-        if (!query.exec(statement.arg(tableName(tablesName[i]))))
-        {
-            std::cerr << QString("Failed to retrieve data from table %1.\n\t%2")
-                .arg(tableName(tablesName[i]), query.lastError().text())
-                .toLocal8Bit().constData()
-                << std::endl;
-            return QVariant();
-        }
-
-        while (query.next())
-        {
-            Game::SaveUtilityInterfaceItem item = {};
-            item.gameID = query.value(0).toLongLong();
-            item.utilityID = query.value(1).toLongLong();
-            if (tablesName[i] == UtilityTableName::SERIES)
-                data.series.append(item);
-            else if (tablesName[i] == UtilityTableName::CATEGORIES)
-                data.categories.append(item);
-            else if (tablesName[i] == UtilityTableName::DIRECTOR)
-                data.directors.append(item);
-            else if (tablesName[i] == UtilityTableName::ACTORS)
-                data.actors.append(item);
-            else if (tablesName[i] == UtilityTableName::PRODUCTION)
-                data.productions.append(item);
-            else if (tablesName[i] == UtilityTableName::MUSIC)
-                data.music.append(item);
-            else if (tablesName[i] == UtilityTableName::SERVICES)
-                data.services.append(item);
-        }
-        query.clear();
-    }
-
-    // Sensitive content
-    statement = QString(
-		"SELECT\n"
-		"	SensitiveContentID,\n"
-		"	ItemID,\n"
-		"	ExplicitContent,\n"
-		"	ViolenceContent,\n"
-		"	BadLanguage\n"
-		"FROM\n"
-		"	\"%1\"\n"
-		"ORDER BY\n"
-		"	SensitiveContentID;")
-			.arg(tableName(UtilityTableName::SENSITIVE_CONTENT));
-
-#ifndef NDEBUG
-    std::cout << statement.arg(tableName(UtilityTableName::SENSITIVE_CONTENT)).toLocal8Bit().constData() << std::endl << std::endl;
-#endif
-
-    if (!query.exec(statement))
-    {
-        std::cerr << QString("Failed to retrieve data from table %1.\n\t%2")
-            .arg(tableName(UtilityTableName::SENSITIVE_CONTENT), query.lastError().text())
-            .toLocal8Bit().constData()
-            << std::endl;
-        return QVariant();
-    }
-
-    while (query.next())
-    {
-        Game::SaveUtilitySensitiveContentItem item = {};
-        item.SensitiveContentID = query.value(0).toLongLong();
-        item.gameID = query.value(1).toLongLong();
-        item.explicitContent = query.value(2).toInt();
-        item.violenceContent = query.value(3).toInt();
-        item.badLanguageContent = query.value(4).toInt();
-        data.sensitiveContent.append(item);
-    }
-
-    return QVariant::fromValue(data);
-}
-
 bool TableModelMovies_UtilityInterface::setData(const QVariant& variant)
 {
     // Apply the data into the SQL table.
-    if (!variant.isValid())
+    // The data is read in place inside the variant, without copying it.
+    const Movie::SaveUtilityInterfaceData* interfaceData = variantValue<Movie::SaveUtilityInterfaceData>(variant);
+    if (!interfaceData)
         return false;
-    
-    Movie::SaveUtilityInterfaceData data = qvariant_cast<Movie::SaveUtilityInterfaceData>(variant);
+    const Movie::SaveUtilityInterfaceData& data = *interfaceData;
 
     UtilityTableName tablesName[7] =
     {
@@ -389,7 +281,7 @@ bool TableModelMovies_UtilityInterface::setData(const QVariant& variant)
     
     for (int i = 0; i < 7; i++)
     {
-        QList<Game::SaveUtilityInterfaceItem>* pItem;
+        const QList<Game::SaveUtilityInterfaceItem>* pItem;
         if (tablesName[i] == UtilityTableName::SERIES)
             pItem = &data.series;
         else if (tablesName[i] == UtilityTableName::CATEGORIES)
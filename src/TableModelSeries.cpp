@@ -17,8 +17,11 @@
 */
 
 #include "TableModelSeries.h"
+#include "ListStatistics.h"
+#include "SaveInterface.h"
 #include "TableModelSeries_UtilityInterface.h"
 #include <QSqlError>
+#include <QDataStream>
 #include <QApplication>
 #include <QClipboard>
 #include <iostream>
@@ -253,6 +256,8 @@ bool TableModelSeries::setData(const QModelIndex& index, const QVariant& data, i
                 bool result = updateField<int>("Rate", index.row(), rate);
                 if (result)
                 {
+                    if (m_statistics)
+                        m_statistics->rateChanged(itemID(index), rate);
                     emit dataChanged(index, index, {Qt::EditRole});
                     emit listEdited();
                 }
@@ -375,6 +380,8 @@ bool TableModelSeries::removeRows(int row, int count, const QModelIndex& parent)
             
             m_data.remove(row, count);
             m_interface->rowRemoved(itemsID);
+            if (m_statistics)
+                m_statistics->itemsRemoved(itemsID);
 
             endRemoveRows();
 
@@ -723,70 +730,56 @@ void TableModelSeries::updateQuery()
 #endif
 }
 
-QVariant TableModelSeries::retrieveData() const
+bool TableModelSeries::setItemData(const QVariant& variant)
 {
-    // Return the data of the table and the utility interface data.
-    Series::SaveDataTable data = {};
-    data.tableName = m_tableName;
+    // Set the data into the TableModel SQL Tables.
+    const Series::SaveDataTable* table = variantValue<Series::SaveDataTable>(variant);
+    if (!table)
+        return false;
+    const Series::SaveDataTable& data = *table;
 
-    // Retrieve series data.
-    QSqlQuery query(m_db);
+    // Set the table name and create the SQL tables.
+    m_tableName = data.tableName;
+    if (m_tableName.isEmpty())
+        return false;
+    createTable();
 
-    QString statement = QString(
-        "SELECT\n"
-        "   SeriesID,\n"
-        "   SeriesPos,\n"
-        "   Name,\n"
-        "   Episode,\n"
-        "   Season,\n"
-        "   Url,\n"
-        "   Rate\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   SeriesID ASC;")
-            .arg(m_tableName);
-    
-    if (!query.exec(statement))
-        return QVariant();
-    
-    while (query.next())
+    // Set the series list.
+    if (!appendItemData(variant))
+        return false;
+
+    // Set the utility interface.
+    if (m_interface)
     {
-        Series::SaveItem serie = {};
-        serie.serieID = query.value(0).toLongLong();
-        serie.seriePos = query.value(1).toLongLong();
-        serie.name = query.value(2).toString();
-        serie.episodePos = query.value(3).toInt();
-        serie.seasonPos = query.value(4).toInt();
-        serie.url = query.value(5).toString();
-        serie.rate = query.value(6).toInt();
-        data.serieList.append(serie);
+        delete m_interface;
+        m_interface = nullptr;
+    }
+    m_interface = new TableModelSeries_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
+    if (!m_interface->isTableReady())
+    {
+        m_isTableCreated = false;
+        return false;
     }
 
-    QVariant utilityInterface = m_interface->data();
-    if (!utilityInterface.canConvert<Series::SaveUtilityInterfaceData>())
-        return QVariant();
-    
-    data.interface = qvariant_cast<Series::SaveUtilityInterfaceData>(utilityInterface);
-
-    data.columnSort = (signed char)m_sortingColumnID;
-    data.sortOrder = (unsigned char)(m_sortingOrder == Qt::AscendingOrder ? 0 : 1);
+    // Then, query the whole table.
+    updateQuery();
 
-    return QVariant::fromValue(data);
+    return true;
 }
 
-bool TableModelSeries::setItemData(const QVariant& variant)
+bool TableModelSeries::appendItemData(const QVariant& variant)
 {
-    // Set the data into the TableModel SQL Tables.
-    Series::SaveDataTable data = qvariant_cast<Series::SaveDataTable>(variant);
-
-    // Set the table name and create the SQL tables.
-    m_tableName = data.tableName;
-    if (m_tableName.isEmpty())
+    // Insert the items of a SaveDataTable into the SQL table.
+    // The table is not queried, updateQuery must be called once all the items are inserted.
+    // The chunk is read in place inside the variant, without copying the items.
+    const Series::SaveDataTable* table = variantValue<Series::SaveDataTable>(variant);
+    if (!m_isTableCreated || !table)
         return false;
-    createTable();
+    const Series::SaveDataTable& data = *table;
+
+    // Too many items are inserted to update the statistics item by item.
+    invalidateStatistics();
 
-    // Set the series list.
     QString statement = QString(
         "INSERT INTO \"%1\" (SeriesID, SeriesPos, Name, Episode, Season, Url, Rate)\n"
         "VALUES")
@@ -830,23 +823,56 @@ bool TableModelSeries::setItemData(const QVariant& variant)
             m_query.clear();
         }
     }
-    // Set the utility interface.
-    if (m_interface)
-    {
-        delete m_interface;
-        m_interface = nullptr;
-    }
-    m_interface = new TableModelSeries_UtilityInterface(m_tableName, m_db, QVariant::fromValue(data.interface));
-    if (!m_interface->isTableReady())
-    {
-        m_isTableCreated = false;
+
+    return true;
+}
+
+bool TableModelSeries::writeData(QDataStream& out) const
+{
+    // Streaming the table into the data stream, row by row from the SQL cursor.
+    if (!m_isTableCreated || !m_interface->isTableReady())
         return false;
-    }
+    return writeTable(out, m_db, m_tableName, m_interface->tableNames());
+}
 
-    // Then, query the whole table.
-    updateQuery();
+bool TableModelSeries::writeTable(QDataStream& out, QSqlDatabase& db, const QString& tableName, const QStringList& interfaceTableNames)
+{
+    // Streaming the table from the database db, row by row from the SQL cursor.
+    // It only use its arguments, so it can be called from another thread with another connection.
+    out << tableName;
 
-    return true;
+    QString statement = QString(
+        "SELECT\n"
+        "   SeriesID,\n"
+        "   SeriesPos,\n"
+        "   Name,\n"
+        "   Episode,\n"
+        "   Season,\n"
+        "   Url,\n"
+        "   Rate\n"
+        "FROM\n"
+        "   \"%1\"\n"
+        "ORDER BY\n"
+        "   SeriesID ASC;")
+            .arg(tableName);
+
+    bool result = SaveInterface::writeQuery(out, db, statement,
+        [](QDataStream& out, const QSqlQuery& query)
+        {
+            Series::SaveItem item = {};
+            item.serieID = query.value(0).toLongLong();
+            item.seriePos = query.value(1).toLongLong();
+            item.name = query.value(2).toString();
+            item.episodePos = query.value(3).toInt();
+            item.seasonPos = query.value(4).toInt();
+            item.url = query.value(5).toString();
+            item.rate = query.value(6).toInt();
+            out << item;
+        });
+    if (!result)
+        return false;
+
+    return TableModel_UtilityInterface::writeTables(out, db, interfaceTableNames);
 }
 
 void TableModelSeries::createTable()
@@ -909,6 +935,9 @@ void TableModelSeries::deleteTable()
 
 void TableModelSeries::utilityChanged(long long int serieID, UtilityTableName tableName)
 {
+    if (m_statistics)
+        m_statistics->utilityChanged(serieID, tableName);
+
     // This member function is called when the utility interface is changed.
     if (serieID >= 0 && size() > 0  && m_isTableCreated)
     {
@@ -929,6 +958,74 @@ void TableModelSeries::utilityChanged(long long int serieID, UtilityTableName ta
     }
 }
 
+void TableModelSeries::setRowsRate(const QList<int>& rows, int rate)
+{
+    // Apply the rate of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].rate = rate;
+    emit dataChanged(index(rows.first(), Series::RATE), index(rows.last(), Series::RATE), {Qt::EditRole});
+}
+
+void TableModelSeries::setRowsUtility(const QList<int>& rows, UtilityTableName tableName, const QHash<long long int, QString>& utilityNames)
+{
+    // Apply the utilities of a bulk edit to the rows, the field and the column of the utility table are selected first.
+    if (rows.isEmpty())
+        return;
+
+    QString SeriesItem::* field = nullptr;
+    int column = -1;
+    if (tableName == UtilityTableName::CATEGORIES)
+    {
+        field = &SeriesItem::categories;
+        column = Series::CATEGORIES;
+    }
+    else if (tableName == UtilityTableName::DIRECTOR)
+    {
+        field = &SeriesItem::directors;
+        column = Series::DIRECTORS;
+    }
+    else if (tableName == UtilityTableName::ACTORS)
+    {
+        field = &SeriesItem::actors;
+        column = Series::ACTORS;
+    }
+    else if (tableName == UtilityTableName::PRODUCTION)
+    {
+        field = &SeriesItem::production;
+        column = Series::PRODUCTION;
+    }
+    else if (tableName == UtilityTableName::MUSIC)
+    {
+        field = &SeriesItem::music;
+        column = Series::MUSIC;
+    }
+    else if (tableName == UtilityTableName::SERVICES)
+    {
+        field = &SeriesItem::services;
+        column = Series::SERVICES;
+    }
+    else
+        return;
+
+    for (int row : rows)
+        m_data[row].*field = utilityNames.value(m_data.at(row).serieID);
+    emit dataChanged(index(rows.first(), column), index(rows.last(), column), {Qt::EditRole});
+}
+
+void TableModelSeries::setRowsSensitiveContent(const QList<int>& rows, const SensitiveContent& sensitiveContent)
+{
+    // Apply the sensitive content of a bulk edit to the rows.
+    if (rows.isEmpty())
+        return;
+
+    for (int row : rows)
+        m_data[row].sensitiveContent = sensitiveContent;
+    emit dataChanged(index(rows.first(), Series::SENSITIVE_CONTENT), index(rows.last(), Series::SENSITIVE_CONTENT), {Qt::EditRole});
+}
+
 void TableModelSeries::queryUtilityField(UtilityTableName tableName)
 {
     // Standard interface to query the utility data except the sensitive data.
@@ -1821,6 +1918,8 @@ void TableModelSeries::retrieveInsertedRows(int row, int count)
             serie.url = m_query.value(5).toString();
             serie.rate = m_query.value(6).toInt();
             seriesList.prepend(serie);
+            if (m_statistics)
+                m_statistics->itemInserted(serie.serieID, serie.rate);
         }
         if (m_sortingColumnID >= 0)
             m_data.append(seriesList.cbegin(), seriesList.cend());
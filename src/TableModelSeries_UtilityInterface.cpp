@@ -248,99 +248,14 @@ ListType TableModelSeries_UtilityInterface::listType() const
     return ListType::SERIESLIST;
 }
 
-QVariant TableModelSeries_UtilityInterface::data() const
-{
-    // Retrieve the data of the utility interface to be save into a file.
-    if (!m_isTableReady)
-        return QVariant();
-    
-    Series::SaveUtilityInterfaceData data = {};
-
-    QSqlQuery query(m_db);
-    QString statement = QString(
-        "SELECT\n"
-        "   ItemID,\n"
-        "   UtilityID\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   ItemID;");
-    
-    UtilityTableName tablesName[6] =
-    {
-        UtilityTableName::CATEGORIES,
-        UtilityTableName::DIRECTOR,
-        UtilityTableName::ACTORS,
-        UtilityTableName::PRODUCTION,
-        UtilityTableName::MUSIC,
-        UtilityTableName::SERVICES
-    };
-
-    // Utility interface (Categories, Director, Actors, Production, Music, Services).
-    for (int i = 0; i < 6; i++)
-    {
-        if (!query.exec(statement.arg(tableName(tablesName[i]))))
-            return QVariant();
-        
-        while (query.next())
-        {
-            Game::SaveUtilityInterfaceItem item = {};
-            item.gameID = query.value(0).toLongLong();
-            item.utilityID = query.value(1).toLongLong();
-            if (tablesName[i] == UtilityTableName::CATEGORIES)
-                data.categories.append(item);
-            else if (tablesName[i] == UtilityTableName::DIRECTOR)
-                data.directors.append(item);
-            else if (tablesName[i] == UtilityTableName::ACTORS)
-                data.actors.append(item);
-            else if (tablesName[i] == UtilityTableName::PRODUCTION)
-                data.production.append(item);
-            else if (tablesName[i] == UtilityTableName::MUSIC)
-                data.music.append(item);
-            else if (tablesName[i] == UtilityTableName::SERVICES)
-                data.services.append(item);
-        }
-        query.clear();
-    }
-
-    // Sensitive content
-	statement = QString(
-		"SELECT\n"
-		"	SensitiveContentID,\n"
-		"	ItemID,\n"
-		"	ExplicitContent,\n"
-		"	ViolenceContent,\n"
-		"	BadLanguage\n"
-		"FROM\n"
-		"	\"%1\"\n"
-		"ORDER BY\n"
-		"	SensitiveContentID;")
-			.arg(tableName(UtilityTableName::SENSITIVE_CONTENT));
-	
-	if (!query.exec(statement))
-		return QVariant();
-	
-	while (query.next())
-	{
-		Game::SaveUtilitySensitiveContentItem item = {};
-		item.SensitiveContentID = query.value(0).toLongLong();
-		item.gameID = query.value(1).toLongLong();
-		item.explicitContent = query.value(2).toInt();
-		item.violenceContent = query.value(3).toInt();
-		item.badLanguageContent = query.value(4).toInt();
-		data.sensitiveContent.append(item);
-	}
-
-    return QVariant::fromValue(data);
-}
-
 bool TableModelSeries_UtilityInterface::setData(const QVariant& variant)
 {
     // Apply the data into the SQL table.
-    if (!variant.isValid())
+    // The data is read in place inside the variant, without copying it.
+    const Series::SaveUtilityInterfaceData* interfaceData = variantValue<Series::SaveUtilityInterfaceData>(variant);
+    if (!interfaceData)
         return false;
-    
-    Series::SaveUtilityInterfaceData data = qvariant_cast<Series::SaveUtilityInterfaceData>(variant);
+    const Series::SaveUtilityInterfaceData& data = *interfaceData;
 
     UtilityTableName tablesName[6] =
     {
@@ -359,7 +274,7 @@ bool TableModelSeries_UtilityInterface::setData(const QVariant& variant)
     
     for (int i = 0; i < 6; i++)
 	{
-		QList<Game::SaveUtilityInterfaceItem>* pItem;
+		const QList<Game::SaveUtilityInterfaceItem>* pItem;
         if (tablesName[i] == UtilityTableName::CATEGORIES)
             pItem = &data.categories;
         else if (tablesName[i] == UtilityTableName::DIRECTOR)
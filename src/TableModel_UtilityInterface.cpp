@@ -17,10 +17,13 @@
 */
 
 #include "TableModel_UtilityInterface.h"
+#include "SqlUtilityTable.h"
+#include "SaveInterface.h"
 
 #include <iostream>
 
 #include <QSqlError>
+#include <QDataStream>
 
 TableModel_UtilityInterface::TableModel_UtilityInterface(const QString& parentTableName, QSqlDatabase& db) :
 	m_parentTableName(parentTableName),
@@ -39,6 +42,174 @@ bool TableModel_UtilityInterface::isTableReady() const
 	return m_isTableReady;
 }
 
+QStringList TableModel_UtilityInterface::tableNames() const
+{
+	// The utility interface tables, then the sensitive content table, in the order of the file.
+	QStringList tableNames;
+	QList<UtilityTableName> tables = SqlUtilityTable::utilityTables(listType());
+	for (UtilityTableName tName : tables)
+		tableNames.append(tableName(tName));
+	tableNames.append(tableName(UtilityTableName::SENSITIVE_CONTENT));
+	return tableNames;
+}
+
+bool TableModel_UtilityInterface::writeData(QDataStream& out) const
+{
+	// Streaming the utility interface tables into the data stream.
+	if (!m_isTableReady)
+		return false;
+
+	return writeTables(out, m_db, tableNames());
+}
+
+bool TableModel_UtilityInterface::writeTables(QDataStream& out, QSqlDatabase& db, const QStringList& tableNames)
+{
+	// Streaming the utility interface tables of the database db, the last table is the sensitive content.
+	// It only use its arguments, so it can be called from another thread with another connection.
+	if (tableNames.isEmpty())
+		return false;
+
+	QString statement = QString(
+		"SELECT\n"
+		"	ItemID,\n"
+		"	UtilityID\n"
+		"FROM\n"
+		"	\"%1\"\n"
+		"ORDER BY\n"
+		"	ItemID;");
+
+	for (int i = 0; i < tableNames.size()-1; i++)
+	{
+		bool result = SaveInterface::writeQuery(out, db, statement.arg(tableNames.at(i)),
+			[](QDataStream& out, const QSqlQuery& query)
+			{
+				Game::SaveUtilityInterfaceItem item = {};
+				item.gameID = query.value(0).toLongLong();
+				item.utilityID = query.value(1).toLongLong();
+				out << item;
+			});
+		if (!result)
+			return false;
+	}
+
+	// Sensitive content
+	statement = QString(
+		"SELECT\n"
+		"	SensitiveContentID,\n"
+		"	ItemID,\n"
+		"	ExplicitContent,\n"
+		"	ViolenceContent,\n"
+		"	BadLanguage\n"
+		"FROM\n"
+		"	\"%1\"\n"
+		"ORDER BY\n"
+		"	SensitiveContentID;")
+			.arg(tableNames.last());
+
+	return SaveInterface::writeQuery(out, db, statement,
+		[](QDataStream& out, const QSqlQuery& query)
+		{
+			Game::SaveUtilitySensitiveContentItem item = {};
+			item.SensitiveContentID = query.value(0).toLongLong();
+			item.gameID = query.value(1).toLongLong();
+			item.explicitContent = query.value(2).toInt();
+			item.violenceContent = query.value(3).toInt();
+			item.badLanguageContent = query.value(4).toInt();
+			out << item;
+		});
+}
+
+bool TableModel_UtilityInterface::appendData(UtilityTableName tName, const QList<Game::SaveUtilityInterfaceItem>& items)
+{
+	// Insert the rows into the utility interface table tName.
+	if (!m_isTableReady || !SqlUtilityTable::utilityTables(listType()).contains(tName))
+		return false;
+
+	QString statement = QString(
+		"INSERT INTO \"%1\" (ItemID, UtilityID)\n"
+		"VALUES")
+			.arg(tableName(tName));
+
+	for (long long int i = 0; i < items.size(); i+=10)
+	{
+		QString strData;
+		for (long long int j = i; j < i+10 && j < items.size(); j++)
+		{
+			if (j > i)
+				strData += ',';
+
+			strData += QString("\n\t(%1, %2)")
+				.arg(items.at(j).gameID)
+				.arg(items.at(j).utilityID);
+		}
+		strData += ';';
+
+#ifndef NDEBUG
+		std::cout << (statement + strData).toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+		if (!m_query.exec(statement + strData))
+		{
+			std::cerr << QString("Failed to insert data into %1.\n\t%2")
+				.arg(tableName(tName), m_query.lastError().text())
+				.toLocal8Bit().constData()
+				<< std::endl;
+			m_query.clear();
+			return false;
+		}
+		m_query.clear();
+	}
+
+	return true;
+}
+
+bool TableModel_UtilityInterface::appendSensitiveContent(const QList<Game::SaveUtilitySensitiveContentItem>& items)
+{
+	// Insert the rows into the sensitive content table.
+	if (!m_isTableReady)
+		return false;
+
+	QString statement = QString(
+		"INSERT INTO \"%1\" (SensitiveContentID, ItemID, ExplicitContent, ViolenceContent, BadLanguage)\n"
+		"VALUES")
+			.arg(tableName(UtilityTableName::SENSITIVE_CONTENT));
+
+	for (long long int i = 0; i < items.size(); i+=10)
+	{
+		QString strData;
+		for (long long int j = i; j < i+10 && j < items.size(); j++)
+		{
+			if (j > i)
+				strData += ',';
+
+			strData += QString("\n\t(%1, %2, %3, %4, %5)")
+				.arg(items.at(j).SensitiveContentID)
+				.arg(items.at(j).gameID)
+				.arg(items.at(j).explicitContent)
+				.arg(items.at(j).violenceContent)
+				.arg(items.at(j).badLanguageContent);
+		}
+		strData += ';';
+
+#ifndef NDEBUG
+		std::cout << (statement + strData).toLocal8Bit().constData() << std::endl << std::endl;
+#endif
+
+		if (!m_query.exec(statement + strData))
+		{
+			std::cerr << QString("Failed to insert data into %1.\n\t%2")
+				.arg(tableName(UtilityTableName::SENSITIVE_CONTENT), m_query.lastError().text())
+				.toLocal8Bit().constData()
+				<< std::endl;
+			m_query.clear();
+			return false;
+		}
+		m_query.clear();
+	}
+
+	return true;
+}
+
 void TableModel_UtilityInterface::destroyTableByName(const QString& tableName)
 {
 	// Destroy a table using it's name.
@@ -74,6 +74,8 @@ void UtilityInterfaceEditor::createWidgets()
         {
             this->m_model->setFilter(searchLine->text());
         });
+    // Search as you type, the search is done in memory by the name index of the utility table.
+    connect(searchLine, &QLineEdit::textChanged, m_model, &UtilityInterfaceEditorModel::setFilter);
     
     // Selected utilities label, it show the selected utilities.
     QLabel* selectedLabel = new QLabel(this);
@@ -24,6 +24,7 @@
 #include <QSqlError>
 #include <QList>
 #include <QStringList>
+#include <algorithm>
 
 UtilityInterfaceEditorModel::UtilityInterfaceEditorModel(
     UtilityTableName utilityTableName,
@@ -40,7 +41,9 @@ UtilityInterfaceEditorModel::UtilityInterfaceEditorModel(
         m_itemID(itemID),
         m_tableModel(tableModel),
         m_dataInterface(dataInterface),
-        m_utilityData(utilityData)
+        m_utilityData(utilityData),
+        m_isSortingEnabled(false),
+        m_sortOrder(Qt::AscendingOrder)
 {
     retrieveUtilityData();
     retrieveSelectedUtilitiesOnItem();
@@ -60,7 +63,9 @@ UtilityInterfaceEditorModel::UtilityInterfaceEditorModel(
     m_itemID(-1),
     m_tableModel(tableModel),
     m_dataInterface(dataInterface),
-    m_utilityData(utilityData)
+    m_utilityData(utilityData),
+    m_isSortingEnabled(false),
+    m_sortOrder(Qt::AscendingOrder)
 {
     retrieveUtilityData();
 }
@@ -79,7 +84,11 @@ QVariant UtilityInterfaceEditorModel::data(const QModelIndex& index, int role) c
     // Return 
     if ((index.isValid() && index.row() < rowCount()))
     {
-        if (role == Qt::DisplayRole || role == Qt::EditRole) 
+        if (role == Qt::DisplayRole && !m_itemCounts.isEmpty())
+            return QString("%1 (%2)")
+                .arg(m_utilityListData.at(index.row()).name)
+                .arg(m_itemCounts.value(m_utilityListData.at(index.row()).utilityID));
+        else if (role == Qt::DisplayRole || role == Qt::EditRole) 
             return m_utilityListData.at(index.row()).name;
         else if (role == Qt::CheckStateRole)
             return isUtilityIDChecked(m_utilityListData.at(index.row()).utilityID);
@@ -103,6 +112,7 @@ bool UtilityInterfaceEditorModel::setData(const QModelIndex& index, const QVaria
         else
         {
             m_checkedIDList.append(m_utilityListData.at(index.row()).utilityID);
+            m_checkedIDs.insert(m_utilityListData.at(index.row()).utilityID);
             emit dataChanged(index, index, {role});
             updateUtilitiesStr();
             return true;
@@ -126,17 +136,65 @@ Qt::ItemFlags UtilityInterfaceEditorModel::flags(const QModelIndex& index) const
 
 void UtilityInterfaceEditorModel::retrieveUtilityData()
 {
-    // Retrieving all the data of the utility data for the editing.
-    QList<ItemUtilityData> utilityData = m_utilityData.retrieveTableData(m_utilityTableName, m_isSortingEnabled, m_sortOrder, m_strFilter);
-    if (utilityData.size() > 0)
+    // Retrieving all the data of the utility table once, the filter and the sorting are applied in memory.
+    m_allUtilityData = m_utilityData.retrieveTableData(m_utilityTableName);
+    m_utilityNames.clear();
+    m_utilityNames.reserve(m_allUtilityData.size());
+    for (const ItemUtilityData& data : m_allUtilityData)
+        m_utilityNames.insert(data.utilityID, data.name);
+
+    filterAndSortData();
+    updateUtilitiesStr();
+}
+
+void UtilityInterfaceEditorModel::filterAndSortData()
+{
+    // Without a pattern, all the utilities in the order of the table,
+    // otherwise the fuzzy matches of the name index, the best match first.
+    if (m_strFilter.trimmed().isEmpty())
+        m_utilityListData = m_allUtilityData;
+    else
     {
-        m_utilityListData.resize(utilityData.size());
-        for (int i = 0; i < m_utilityListData.size(); i++)
+        m_utilityListData.clear();
+        QList<ItemUtilityData> matches = m_utilityData.searchTableData(m_utilityTableName, m_strFilter);
+        for (const ItemUtilityData& match : matches)
         {
-            m_utilityListData[i] = utilityData.at(i);
+            if (m_utilityNames.contains(match.utilityID))
+                m_utilityListData.append(match);
         }
     }
-    updateUtilitiesStr();
+
+    if (m_isSortingEnabled)
+    {
+        std::stable_sort(m_utilityListData.begin(), m_utilityListData.end(),
+            [this](const ItemUtilityData& data1, const ItemUtilityData& data2) -> bool
+            {
+                int result = data1.name.compare(data2.name, Qt::CaseInsensitive);
+                return m_sortOrder == Qt::AscendingOrder ? result < 0 : result > 0;
+            });
+    }
+}
+
+void UtilityInterfaceEditorModel::updateRows()
+{
+    // Applying again the filter and the sorting to the rows of the model.
+    if (m_utilityListData.size() > 0)
+    {
+        beginRemoveRows(QModelIndex(), 0, m_utilityListData.size()-1);
+        m_utilityListData.clear();
+        endRemoveRows();
+    }
+
+    QList<ItemUtilityData> utilityListData;
+    filterAndSortData();
+    utilityListData.swap(m_utilityListData);
+
+    if (utilityListData.size() > 0)
+    {
+        beginInsertRows(QModelIndex(), 0, utilityListData.size()-1);
+        m_utilityListData.swap(utilityListData);
+        endInsertRows();
+    }
 }
 
 void UtilityInterfaceEditorModel::applyChange()
@@ -156,19 +214,14 @@ void UtilityInterfaceEditorModel::applyChange()
 
 bool UtilityInterfaceEditorModel::isUtilityIDChecked(long long int utilityID) const
 {
-    // Check if utilityID is in the m_checkedIDList list.
-    for (int i = 0; i < m_checkedIDList.size(); i++)
-        if (m_checkedIDList.at(i) == utilityID)
-            return true;
-    return false;
+    return m_checkedIDs.contains(utilityID);
 }
 
 void UtilityInterfaceEditorModel::removeCheckedUtilityID(long long int utilityID)
 {
     // Remove from the m_checkedIDList list all the element with utilityID.
-    for (int i = m_checkedIDList.size()-1; i >= 0; i--)
-        if (m_checkedIDList.at(i) == utilityID)
-            m_checkedIDList.remove(i, 1);
+    m_checkedIDList.removeAll(utilityID);
+    m_checkedIDs.remove(utilityID);
 }
 
 QList<long long int> UtilityInterfaceEditorModel::getSelectedUtilities() const
@@ -176,6 +229,13 @@ QList<long long int> UtilityInterfaceEditorModel::getSelectedUtilities() const
     return m_checkedIDList;
 }
 
+void UtilityInterfaceEditorModel::setItemCounts(const QHash<long long int, int>& itemCounts)
+{
+    m_itemCounts = itemCounts;
+    if (m_utilityListData.size() > 0)
+        emit dataChanged(index(0), index(m_utilityListData.size()-1), {Qt::DisplayRole});
+}
+
 void UtilityInterfaceEditorModel::sort(int column, Qt::SortOrder order)
 {
     // Sorting the utilies list.
@@ -183,21 +243,7 @@ void UtilityInterfaceEditorModel::sort(int column, Qt::SortOrder order)
     {
         m_isSortingEnabled = column == -1 ? false : true;
         m_sortOrder = order;
-
-        if (m_utilityListData.size() > 0)
-        {
-            beginRemoveRows(QModelIndex(), 0, m_utilityListData.size()-1);
-            m_utilityListData.clear();
-            endRemoveRows();
-        }
-
-        retrieveUtilityData();
-
-        if (m_utilityListData.size() > 0)
-        {
-            beginInsertRows(QModelIndex(), 0, m_utilityListData.size()-1);
-            endInsertRows();
-        }
+        updateRows();
     }
 }
 
@@ -206,21 +252,7 @@ void UtilityInterfaceEditorModel::setFilter(const QString& pattern)
     if (m_strFilter.compare(pattern) != 0)
     {
         m_strFilter = pattern;
-
-        if (m_utilityListData.size() > 0)
-        {
-            beginRemoveRows(QModelIndex(), 0, m_utilityListData.size()-1);
-            m_utilityListData.clear();
-            endRemoveRows();
-        }
-
-        retrieveUtilityData();
-
-        if (m_utilityListData.size() > 0)
-        {
-            beginInsertRows(QModelIndex(), 0, m_utilityListData.size()-1);
-            endInsertRows();
-        }
+        updateRows();
     }
 }
 
@@ -246,14 +278,11 @@ void UtilityInterfaceEditorModel::retrieveSelectedUtilitiesOnItem()
         while (m_query.next())
         {
             long long int utilityID = m_query.value(0).toLongLong();
-            // Check if the utility is in the utility list, if not, it means it has been removed.
-            foreach (const ItemUtilityData& data, m_utilityListData)
+            // Check if the utility is in the utility table, if not, it means it has been removed.
+            if (m_utilityNames.contains(utilityID) && !m_checkedIDs.contains(utilityID))
             {
-                if (data.utilityID == utilityID)
-                {
-                    m_checkedIDList.append(utilityID);
-                    break;
-                }
+                m_checkedIDList.append(utilityID);
+                m_checkedIDs.insert(utilityID);
             }
         }
         m_query.clear();
@@ -271,53 +300,17 @@ void UtilityInterfaceEditorModel::retrieveSelectedUtilitiesOnItem()
 
 void UtilityInterfaceEditorModel::updateUtilitiesStr()
 {
-    // Retrieve a string of the selected utilities.
-    QStringList selectedUtilitiesID;
-
-    for (int i = 0; i < m_checkedIDList.size(); i++)
-    {
-        selectedUtilitiesID += QString::number(m_checkedIDList.at(i));
-    }
-
-    if (selectedUtilitiesID.isEmpty())
-    {
-        emit utilitiesUpdated(QString());
-        return;
-    }
-
-    QString statement = QString(
-        "SELECT\n"
-        "   Name\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "WHERE\n"
-        "   \"%1ID\" = %2;")
-            .arg(m_utilityData.tableName(m_utilityTableName));
-
+    // Retrieve a string of the selected utilities, the names are already in memory.
     QString strSelectedUtilities;
-    bool result = true;
-    foreach (const QString& id, selectedUtilitiesID)
+    for (long long int utilityID : m_checkedIDList)
     {
-#ifndef NDEBUG
-    std::cout << statement.arg(id).toLocal8Bit().constData() << std::endl << std::endl;
-#endif
-
-        if (m_query.exec(statement.arg(id)))
-        {
-            if (m_query.next())
-            {
-                if (!strSelectedUtilities.isEmpty())
-                    strSelectedUtilities += ", ";
-                strSelectedUtilities += m_query.value(0).toString();
-            }
-        }
-        else
-        {
-            std::cerr << "failed to retrieve selected utilies in UtilityInterfaceEditorModel::updateUtilitiesStr() member function." << std::endl;
-            result = false;
-        }
+        QHash<long long int, QString>::const_iterator it = m_utilityNames.constFind(utilityID);
+        if (it == m_utilityNames.constEnd())
+            continue;
+        if (!strSelectedUtilities.isEmpty())
+            strSelectedUtilities += ", ";
+        strSelectedUtilities += it.value();
     }
 
-    if (result)
-        emit utilitiesUpdated(strSelectedUtilities);
+    emit utilitiesUpdated(strSelectedUtilities);
 }
\ No newline at end of file
@@ -21,15 +21,15 @@
 #include <QAbstractItemView>
 #include <QKeyEvent>
 #include <QScrollBar>
-#include <QSqlError>
-#include <iostream>
+#include <QStringListModel>
 
 UtilityLineEdit::UtilityLineEdit(UtilityTableName tableName, SqlUtilityTable& utilityTable, QSqlDatabase& db, QWidget* parent) :
     QLineEdit(parent),
     m_tableName(tableName),
     m_utilityTable(utilityTable),
     m_db(db),
-    m_completer(nullptr)
+    m_completer(nullptr),
+    m_matches(new QStringListModel(this))
 {
     createCompleter();
 }
@@ -134,12 +134,18 @@ void UtilityLineEdit::keyPressEvent(QKeyEvent* e)
         return;
     }
 
-    // Set completion prefix.
+    // Set completion prefix, the popup show the fuzzy matches of the prefix.
     if (strPrefix != m_completer->completionPrefix())
     {
+        updateMatches(strPrefix);
         m_completer->setCompletionPrefix(strPrefix);
         m_completer->popup()->setCurrentIndex(m_completer->completionModel()->index(0,0));
     }
+    if (m_matches->rowCount() == 0)
+    {
+        m_completer->popup()->hide();
+        return;
+    }
     
     // Show completion popup.
     int widthSizeHint = m_completer->popup()->sizeHintForColumn(0) +
@@ -152,37 +158,18 @@ void UtilityLineEdit::keyPressEvent(QKeyEvent* e)
 
 void UtilityLineEdit::createCompleter()
 {
-    // Retrieve utility list.
-    QString statement = QString(
-        "SELECT\n"
-        "   Name\n"
-        "FROM\n"
-        "   \"%1\"\n"
-        "ORDER BY\n"
-        "   OrderID ASC;")
-            .arg(m_utilityTable.tableName(m_tableName));
-
-#ifndef NDEBUG
-    std::cout << statement.toLocal8Bit().constData() << '\n' << std::endl;
-#endif
-
-    QSqlQuery query(m_db);
-    QStringList utilityList;
-    if (query.exec(statement))
-    {
-        while(query.next())
-            utilityList.append(query.value(0).toString());
-    }
-    else
-    {
-#ifndef NDEBUG
-        std::cerr << QString("Failed to query utility value from table %1.\n\t%2")
-            .arg(m_utilityTable.tableName(m_tableName), query.lastError().text())
-            .toLocal8Bit().constData() << '\n' << std::endl;
-#endif
-        return;
-    }
-
-    QCompleter* completer = new QCompleter(utilityList, this);
+    // The completer show the matches as they are, the matching and the ranking is done by the
+    // name index of the utility table, shared by all the editors and kept up to date by the SqlUtilityTable.
+    QCompleter* completer = new QCompleter(m_matches, this);
     setCompleter(completer);
+    completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+}
+
+void UtilityLineEdit::updateMatches(const QString& pattern)
+{
+    QStringList names;
+    QList<ItemUtilityData> matches = m_utilityTable.searchTableData(m_tableName, pattern, UTILITY_COMPLETION_MAX_MATCHES);
+    for (const ItemUtilityData& match : matches)
+        names.append(match.name);
+    m_matches->setStringList(names);
 }
\ No newline at end of file
@@ -78,6 +78,7 @@ bool UtilityListModel::setData(const QModelIndex& index, const QVariant& value,
             m_query.clear();
             if (m_query.exec(statement))
             {
+                m_utility->utilityNameChanged(m_tableName, m_data.at(index.row()).utilityID, value.toString());
                 m_data[index.row()].name = value.toString();
                 dataChanged(index, index, {Qt::EditRole});
                 emit m_utility->utilityEdited();
@@ -160,6 +161,8 @@ bool UtilityListModel::insertRows(int row, int count, const QModelIndex& parent)
 
                 if (newData.size() > 0)
                 {
+                    for (const ItemUtilityData& data : newData)
+                        m_utility->utilityNameAdded(m_tableName, data.utilityID, data.name);
                     beginInsertRows(QModelIndex(), row, row+count-1);
                     if (row >= rowCount())
                         m_data.append(newData);
@@ -234,6 +237,8 @@ bool UtilityListModel::removeRows(int row, int count, const QModelIndex& parent)
         m_query.clear();
         if (m_query.exec(statement))
         {
+            for (int i = row; i < row+count; i++)
+                m_utility->utilityNameRemoved(m_tableName, m_data.at(i).utilityID);
             beginRemoveRows(QModelIndex(), row, row+count-1);
             m_data.remove(row, count);
             endRemoveRows();
@@ -0,0 +1,233 @@
+/*
+* MIT Licence
+*
+* This file is part of the GameSorting
+*
+* Copyright © 2022 Erwan Saclier de la Bâtie (BlueDragon28)
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "UtilityNameIndex.h"
+#include <QSet>
+#include <QPair>
+#include <algorithm>
+
+UtilityNameIndex::UtilityNameIndex()
+{}
+
+UtilityNameIndex::~UtilityNameIndex()
+{}
+
+void UtilityNameIndex::clear()
+{
+    m_entries.clear();
+    m_freeSlots.clear();
+    m_slots.clear();
+    m_postings.clear();
+}
+
+void UtilityNameIndex::insert(long long int utilityID, const QString& name)
+{
+    if (m_slots.contains(utilityID))
+    {
+        rename(utilityID, name);
+        return;
+    }
+
+    Entry entry = {};
+    entry.utilityID = utilityID;
+    entry.name = name;
+    entry.normalized = normalize(name);
+    QList<quint64> entryTrigrams = trigrams(entry.normalized);
+    entry.trigramCount = entryTrigrams.size();
+
+    int slot;
+    if (!m_freeSlots.isEmpty())
+    {
+        slot = m_freeSlots.takeLast();
+        m_entries[slot] = entry;
+    }
+    else
+    {
+        slot = m_entries.size();
+        m_entries.append(entry);
+    }
+    m_slots.insert(utilityID, slot);
+
+    for (quint64 trigram : entryTrigrams)
+        m_postings[trigram].append(slot);
+}
+
+void UtilityNameIndex::remove(long long int utilityID)
+{
+    QHash<long long int, int>::iterator it = m_slots.find(utilityID);
+    if (it == m_slots.end())
+        return;
+    int slot = it.value();
+    m_slots.erase(it);
+
+    for (quint64 trigram : trigrams(m_entries.at(slot).normalized))
+    {
+        QHash<quint64, QList<int>>::iterator posting = m_postings.find(trigram);
+        if (posting == m_postings.end())
+            continue;
+        posting.value().removeOne(slot);
+        if (posting.value().isEmpty())
+            m_postings.erase(posting);
+    }
+
+    m_entries[slot] = Entry{-1, QString(), QString(), 0};
+    m_freeSlots.append(slot);
+}
+
+void UtilityNameIndex::rename(long long int utilityID, const QString& name)
+{
+    remove(utilityID);
+    insert(utilityID, name);
+}
+
+bool UtilityNameIndex::contains(long long int utilityID) const
+{
+    return m_slots.contains(utilityID);
+}
+
+QString UtilityNameIndex::name(long long int utilityID) const
+{
+    QHash<long long int, int>::const_iterator it = m_slots.constFind(utilityID);
+    if (it == m_slots.constEnd())
+        return QString();
+    return m_entries.at(it.value()).name;
+}
+
+int UtilityNameIndex::size() const
+{
+    return m_slots.size();
+}
+
+QList<long long int> UtilityNameIndex::search(const QString& pattern, int maxResults) const
+{
+    const QString normalizedPattern = normalize(pattern);
+    if (normalizedPattern.isEmpty())
+        return {};
+
+    QList<QPair<double, int>> matches;
+    if (normalizedPattern.size() < 3)
+    {
+        // A pattern too short to have inner trigrams, only the names containing it are matching.
+        for (int slot = 0; slot < m_entries.size(); slot++)
+        {
+            const Entry& entry = m_entries.at(slot);
+            if (entry.utilityID >= 0 && entry.normalized.contains(normalizedPattern))
+                matches.append({score(entry, normalizedPattern, 0, 0), slot});
+        }
+    }
+    else
+    {
+        // Counting the trigrams of the pattern shared by each name, only the names sharing at least one are read.
+        QList<quint64> patternTrigrams = trigrams(normalizedPattern);
+        QHash<int, int> sharedTrigrams;
+        for (quint64 trigram : patternTrigrams)
+        {
+            QHash<quint64, QList<int>>::const_iterator posting = m_postings.constFind(trigram);
+            if (posting == m_postings.constEnd())
+                continue;
+            for (int slot : posting.value())
+                sharedTrigrams[slot]++;
+        }
+
+        for (QHash<int, int>::const_iterator it = sharedTrigrams.cbegin(); it != sharedTrigrams.cend(); it++)
+        {
+            double entryScore = score(m_entries.at(it.key()), normalizedPattern, it.value(), patternTrigrams.size());
+            if (entryScore >= UTILITY_NAME_MIN_SIMILARITY)
+                matches.append({entryScore, it.key()});
+        }
+    }
+
+    // The best score first, then the shortest name, then in alphabetical order.
+    std::sort(matches.begin(), matches.end(),
+        [this](const QPair<double, int>& match1, const QPair<double, int>& match2) -> bool
+        {
+            if (match1.first != match2.first)
+                return match1.first > match2.first;
+            const Entry& entry1 = m_entries.at(match1.second);
+            const Entry& entry2 = m_entries.at(match2.second);
+            if (entry1.normalized.size() != entry2.normalized.size())
+                return entry1.normalized.size() < entry2.normalized.size();
+            return entry1.normalized < entry2.normalized;
+        });
+
+    if (maxResults > 0 && matches.size() > maxResults)
+        matches.resize(maxResults);
+
+    QList<long long int> utilityIDs;
+    utilityIDs.reserve(matches.size());
+    for (const QPair<double, int>& match : matches)
+        utilityIDs.append(m_entries.at(match.second).utilityID);
+    return utilityIDs;
+}
+
+double UtilityNameIndex::score(const Entry& entry, const QString& pattern, int sharedTrigrams, int patternTrigrams)
+{
+    // The similarity of the trigrams (from 0 to 1), with a bonus when the name contain the pattern,
+    // a bigger one when a word of the name start with it, and the biggest when the name start with it.
+    double similarity = 0.;
+    if (sharedTrigrams > 0)
+        similarity = (double)sharedTrigrams / (double)(patternTrigrams + entry.trigramCount - sharedTrigrams);
+
+    int position = entry.normalized.indexOf(pattern);
+    if (position == 0)
+        similarity += 3.;
+    else if (position > 0 && entry.normalized.at(position - 1) == ' ')
+        similarity += 2.;
+    else if (position > 0)
+        similarity += 1.;
+    return similarity;
+}
+
+QString UtilityNameIndex::normalize(const QString& name)
+{
+    // Decomposing the characters to remove the diacritics (é -> e).
+    QString decomposed = name.normalized(QString::NormalizationForm_KD);
+    QString normalized;
+    normalized.reserve(decomposed.size());
+    for (QChar c : decomposed)
+    {
+        if (c.category() != QChar::Mark_NonSpacing)
+            normalized.append(c);
+    }
+    return normalized.toCaseFolded().simplified();
+}
+
+QList<quint64> UtilityNameIndex::trigrams(const QString& normalized)
+{
+    // The trigrams of the name with a space before and after, so the beginning and the end of the name count.
+    // Each trigram is given once.
+    if (normalized.isEmpty())
+        return {};
+
+    QString padded = QString(" %1 ").arg(normalized);
+    QList<quint64> result;
+    QSet<quint64> seen;
+    for (int i = 0; i + 2 < padded.size(); i++)
+    {
+        quint64 trigram =
+            ((quint64)padded.at(i).unicode() << 32) |
+            ((quint64)padded.at(i + 1).unicode() << 16) |
+            (quint64)padded.at(i + 2).unicode();
+        if (!seen.contains(trigram))
+        {
+            seen.insert(trigram);
+            result.append(trigram);
+        }
+    }
+    return result;
+}
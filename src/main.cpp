@@ -18,13 +18,29 @@
 
 #include "MainWindow.h"
 #include "CMDOpts.h"
+#include "HeadlessMode.h"
 #include "Common.h"
 
 #include <QApplication>
+#include <QCoreApplication>
 #include <QString>
 
 int main(int argc, char** argv)
 {
+	// Processing the list files without any window (--stats, --export, --convert, --validate, --upgrade).
+	// A QCoreApplication is enough and is faster to create than a QApplication.
+	if (CMDOpts::isHeadless(argc, argv))
+	{
+		QCoreApplication app(argc, argv);
+		app.setOrganizationName("Erwan28250");
+		app.setApplicationName("GameSorting");
+		app.setApplicationVersion(GAMESORTING_VERSION);
+
+		CMDOpts parser(app);
+		HeadlessMode headless(parser);
+		return headless.exec();
+	}
+
 	// Initialize the resources of the program (images, etc).
 	Q_INIT_RESOURCE(gamesorting);
 